@@ -68,6 +68,9 @@ int main(int argc, char* argv[]) {
     printf("  Cache Gather    : 2 10000000 64 256 10 1 1\n");
     printf("  Global Gather   : 2 100000000 16 100000000 1 1 1\n");
     printf("  Typical MD      : 2 100000 32 512 1000 8 2\n");
+    printf(
+        "Add --kokkos-hugepage-threshold=2097152 to back Views of 2MiB or "
+        "more with huge pages\n");
     Kokkos::finalize();
     return 0;
   }
@@ -0,0 +1,115 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <Kokkos_Core.hpp>
+#include <impl/Kokkos_HostBarrier.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Kokkos::Impl::HostBarrier;
+
+struct alignas(64) Buffer {
+  HostBarrier::buffer_type data[HostBarrier::required_buffer_length];
+};
+
+// Average time of one barrier among the given number of threads, in
+// microseconds. Rank 0 times the barriers after a first one that waits for
+// all threads to start.
+double barrier_latency(const int threads, const int fan_in, const int repeat) {
+  Buffer buffer = {};
+  double time   = 0;
+
+  auto run = [&](const int rank) {
+    int step = 0;
+    HostBarrier::arrive(buffer.data, threads, rank, fan_in, step);
+    HostBarrier::wait(buffer.data, threads, step);
+    Kokkos::Timer timer;
+    for (int r = 0; r < repeat; ++r) {
+      HostBarrier::arrive(buffer.data, threads, rank, fan_in, step);
+      HostBarrier::wait(buffer.data, threads, step);
+    }
+    if (rank == 0) time = timer.seconds();
+  };
+
+  std::vector<std::thread> workers;
+  for (int rank = 1; rank < threads; ++rank) workers.emplace_back(run, rank);
+  run(0);
+  for (auto& worker : workers) worker.join();
+
+  return 1.0e6 * time / repeat;
+}
+
+int main(int argc, char* argv[]) {
+  Kokkos::initialize(argc, argv);
+  {
+    const int hardware = std::thread::hardware_concurrency();
+    if (argc > 1 && std::string(argv[1]) == "-h") {
+      printf("Arguments: T R\n");
+      printf("  T:   Largest number of threads (default %d)\n", hardware);
+      printf("  R:   Number of barriers per measurement (default 10000)\n");
+      printf("The tree fan-in follows --kokkos-barrier-fan-in, chosen from\n");
+      printf("the topology by default.\n");
+      Kokkos::finalize();
+      return 0;
+    }
+
+    const int T = argc > 1 ? std::atoi(argv[1]) : hardware;
+    const int R = argc > 2 ? std::atoi(argv[2]) : 10000;
+
+    printf("Threads  Central(us)  Tree(us)  Fan-in\n");
+    for (int threads = 2; threads <= T;
+         threads = threads < T && 2 * threads > T ? T : 2 * threads) {
+      const int fan_in     = HostBarrier::fan_in(threads);
+      const double central = barrier_latency(threads, 0, R);
+      const double tree =
+          fan_in ? barrier_latency(threads, fan_in, R) : central;
+      printf("%7d  %11.3f  %8.3f  %6d\n", threads, central, tree, fan_in);
+    }
+  }
+  Kokkos::finalize();
+}
@@ -66,7 +66,9 @@ int main(int argc, char* argv[]) {
         "call\n");
     printf("  team_size:      number of team members (team_size)\n");
     printf("  vector_size:    desired vectorization (if possible)\n");
-    printf("  schedule:       1 == Static  2 == Dynamic\n");
+    printf(
+        "  schedule:       1 == Static  2 == Dynamic  3 == Dynamic with round "
+        "robin stealing\n");
     printf(
         "  test_type:      3-digit code XYZ for testing (nested) parallel_*\n");
     printf(
@@ -85,7 +87,10 @@ int main(int argc, char* argv[]) {
     printf("                  RangePolicy:\n");
     printf(
         "                    X: 3 = parallel_for; 4 = parallel_reduce; 5 = "
-        "parallel_scan\n");
+        "parallel_scan;\n");
+    printf(
+        "                       6 = parallel_for with imbalanced work "
+        "(follows schedule)\n");
     printf("                    Y: 0 = none\n");
     printf("                    Z: 0 = none\n");
     printf("  Example Input:\n");
@@ -112,9 +117,11 @@ int main(int argc, char* argv[]) {
     disable_verbose_output = std::stoi(argv[11]);
   }
 
-  if (schedule != 1 && schedule != 2) {
+  if (schedule != 1 && schedule != 2 && schedule != 3) {
     printf("schedule: %d\n", schedule);
-    printf("Options for schedule are: 1 == Static  2 == Dynamic\n");
+    printf(
+        "Options for schedule are: 1 == Static  2 == Dynamic  3 == Dynamic "
+        "with round robin stealing\n");
     Kokkos::finalize();
     return -1;
   }
@@ -124,7 +131,7 @@ int main(int argc, char* argv[]) {
       test_type != 122 && test_type != 200 && test_type != 210 &&
       test_type != 211 && test_type != 212 && test_type != 220 &&
       test_type != 221 && test_type != 222 && test_type != 300 &&
-      test_type != 400 && test_type != 500) {
+      test_type != 400 && test_type != 500 && test_type != 600) {
     printf("Incorrect test_type option\n");
     Kokkos::finalize();
     return -2;
@@ -180,7 +187,13 @@ int main(int argc, char* argv[]) {
           result_computed, result_expect, time);
     }
   }
-  if (schedule == 2) {
+  // Schedule 3 shows what NUMA aware work stealing saves over stealing
+  // round robin, on nodes with several NUMA domains.
+  if (schedule == 3) {
+    Kokkos::Impl::HostThreadTeamData::set_numa_stealing(false);
+  }
+
+  if (schedule == 2 || schedule == 3) {
     if (test_type != 500) {
       // warmup - no repeat of loops
       test_policy<Kokkos::Schedule<Kokkos::Dynamic>, int>(
@@ -429,6 +429,24 @@ void test_policy(int team_range, int thread_range, int vector_range,
       // 0.5*(team_size*team_range)*(team_size*team_range-1);
     }
 
+    // parallel_for RangePolicy with imbalanced work: the rows of the first
+    // half of the range are swept thread_repeat times, so the threads owning
+    // them are stolen from.  The rows were first touched by the warmup call.
+    if (test_type == 600) {
+      const int range = team_size * team_range;
+      Kokkos::parallel_for(
+          "600 outer for imbalanced",
+          Kokkos::RangePolicy<ScheduleType, IndexType>(0, range),
+          KOKKOS_LAMBDA(const int idx) {
+            const int sweeps = idx < range / 2 ? thread_repeat : 1;
+            for (int s = 0; s < sweeps; ++s) {
+              for (int t = 0; t < thread_range; ++t) {
+                v2(idx, t) += 1;
+              }
+            }
+          });
+    }
+
   }  // end outer for loop
 
   time = timer.seconds();
@@ -26,6 +26,8 @@
 # Tier 6: parallel_reduce, parallel_scan + RangePolicy 400 500
 # Tier 7: 'outer' parallel_for with TeamPolicy (nested parallelism) 1XY
 # Tier 8: 'outer' parallel_reduce with TeamPolicy (nested parallelism) 2XY
+# NUMA aware work stealing, SCHEDULE = 2 vs round robin SCHEDULE = 3
+# Tier 9: imbalanced parallel_for + RangePolicy 600
 
 # Results grouped by: 
 # 0) SCHEDULE  1) CODE (test)  2) TEAMRANGE  3) TEAMSIZE  4) THREADRANGE
@@ -77,6 +79,11 @@ done
 
 done # end SCHEDULE
 
+# Tier 9
+for SCHEDULE in {2,3}; do
+    OMP_PROC_BIND=spread OMP_PLACES=cores ./$EXECUTABLE.$SUFFIX 20000 512 1 10 16 1 1 1 $SCHEDULE 600
+done
+
 fi # end host
 
 
@@ -90,6 +90,17 @@ TEST_F(cuda, global_2_local) {
     test_global_to_local_ids<Kokkos::Cuda>(i);
 }
 
+TEST_F(cuda, global_2_local_open) {
+  typedef Kokkos::Experimental::OpenUnorderedMap<
+      uint32_t, Kokkos::Cuda::size_type, Kokkos::Cuda>
+      map_type;
+  std::cout << "Cuda OpenUnorderedMap" << std::endl;
+  std::cout << "size, create, generate, fill, find" << std::endl;
+  for (unsigned i = Performance::begin_id_size; i <= Performance::end_id_size;
+       i *= Performance::id_step)
+    test_global_to_local_ids<Kokkos::Cuda, map_type>(i);
+}
+
 TEST_F(cuda, unordered_map_performance_near) {
   Perf::run_performance_tests<Kokkos::Cuda, true>("cuda-near");
 }
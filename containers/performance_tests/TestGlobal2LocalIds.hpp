@@ -45,6 +45,7 @@
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_UnorderedMap.hpp>
+#include <Kokkos_OpenUnorderedMap.hpp>
 #include <vector>
 #include <algorithm>
 
@@ -94,15 +95,16 @@ struct generate_ids {
   }
 };
 
-template <typename Device>
+template <typename Device,
+          typename Map = Kokkos::UnorderedMap<
+              uint32_t, typename Device::size_type, Device> >
 struct fill_map {
   typedef Device execution_space;
   typedef typename execution_space::size_type size_type;
   typedef Kokkos::View<const uint32_t*, execution_space,
                        Kokkos::MemoryRandomAccess>
       local_id_view;
-  typedef Kokkos::UnorderedMap<uint32_t, size_type, execution_space>
-      global_id_view;
+  typedef Map global_id_view;
 
   global_id_view global_2_local;
   local_id_view local_2_global;
@@ -118,15 +120,16 @@ struct fill_map {
   }
 };
 
-template <typename Device>
+template <typename Device,
+          typename Map = Kokkos::UnorderedMap<
+              uint32_t, typename Device::size_type, Device> >
 struct find_test {
   typedef Device execution_space;
   typedef typename execution_space::size_type size_type;
   typedef Kokkos::View<const uint32_t*, execution_space,
                        Kokkos::MemoryRandomAccess>
       local_id_view;
-  typedef Kokkos::UnorderedMap<const uint32_t, const size_type, execution_space>
-      global_id_view;
+  typedef typename Map::const_map_type global_id_view;
 
   global_id_view global_2_local;
   local_id_view local_2_global;
@@ -154,14 +157,14 @@ struct find_test {
   }
 };
 
-template <typename Device>
+template <typename Device,
+          typename Map = Kokkos::UnorderedMap<
+              uint32_t, typename Device::size_type, Device> >
 void test_global_to_local_ids(unsigned num_ids) {
   typedef Device execution_space;
-  typedef typename execution_space::size_type size_type;
 
   typedef Kokkos::View<uint32_t*, execution_space> local_id_view;
-  typedef Kokkos::UnorderedMap<uint32_t, size_type, execution_space>
-      global_id_view;
+  typedef Map global_id_view;
 
   // size
   std::cout << num_ids << ", ";
@@ -185,7 +188,7 @@ void test_global_to_local_ids(unsigned num_ids) {
   std::cout << elasped_time << ", ";
   timer.reset();
 
-  { fill_map<Device> fill(global_2_local, local_2_global); }
+  { fill_map<Device, Map> fill(global_2_local, local_2_global); }
   Device().fence();
 
   // fill
@@ -195,7 +198,7 @@ void test_global_to_local_ids(unsigned num_ids) {
 
   size_t num_errors = 0;
   for (int i = 0; i < 100; ++i) {
-    find_test<Device> find(global_2_local, local_2_global, num_errors);
+    find_test<Device, Map> find(global_2_local, local_2_global, num_errors);
   }
   Device().fence();
 
@@ -90,6 +90,17 @@ TEST_F(hpx, global_2_local) {
     test_global_to_local_ids<Kokkos::Experimental::HPX>(i);
 }
 
+TEST_F(hpx, global_2_local_open) {
+  typedef Kokkos::Experimental::OpenUnorderedMap<
+      uint32_t, Kokkos::Experimental::HPX::size_type, Kokkos::Experimental::HPX>
+      map_type;
+  std::cout << "HPX OpenUnorderedMap" << std::endl;
+  std::cout << "size, create, generate, fill, find" << std::endl;
+  for (unsigned i = Performance::begin_id_size; i <= Performance::end_id_size;
+       i *= Performance::id_step)
+    test_global_to_local_ids<Kokkos::Experimental::HPX, map_type>(i);
+}
+
 TEST_F(hpx, unordered_map_performance_near) {
   unsigned num_hpx = 4;
   std::ostringstream base_file_name;
@@ -112,6 +123,11 @@ TEST_F(hpx, scatter_view) {
                           Kokkos::Experimental::ScatterDuplicated,
                           Kokkos::Experimental::ScatterNonAtomic>(10,
                                                                   1000 * 1000);
+  std::cout << "ScatterView sparse data-duplicated test:\n";
+  Perf::test_scatter_view<Kokkos::Experimental::HPX, Kokkos::LayoutRight,
+                          Kokkos::Experimental::ScatterSparseDuplicated,
+                          Kokkos::Experimental::ScatterNonAtomic>(10,
+                                                                  1000 * 1000);
   // std::cout << "ScatterView atomics test:\n";
   // Perf::test_scatter_view<Kokkos::Experimental::HPX, Kokkos::LayoutRight,
   //  Kokkos::Experimental::ScatterNonDuplicated,
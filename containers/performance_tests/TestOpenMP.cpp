@@ -90,6 +90,17 @@ TEST_F(openmp, global_2_local) {
     test_global_to_local_ids<Kokkos::OpenMP>(i);
 }
 
+TEST_F(openmp, global_2_local_open) {
+  typedef Kokkos::Experimental::OpenUnorderedMap<
+      uint32_t, Kokkos::OpenMP::size_type, Kokkos::OpenMP>
+      map_type;
+  std::cout << "OpenMP OpenUnorderedMap" << std::endl;
+  std::cout << "size, create, generate, fill, find" << std::endl;
+  for (unsigned i = Performance::begin_id_size; i <= Performance::end_id_size;
+       i *= Performance::id_step)
+    test_global_to_local_ids<Kokkos::OpenMP, map_type>(i);
+}
+
 TEST_F(openmp, unordered_map_performance_near) {
   unsigned num_openmp = 4;
   if (Kokkos::hwloc::available()) {
@@ -120,6 +131,11 @@ TEST_F(openmp, scatter_view) {
                           Kokkos::Experimental::ScatterDuplicated,
                           Kokkos::Experimental::ScatterNonAtomic>(10,
                                                                   1000 * 1000);
+  std::cout << "ScatterView sparse data-duplicated test:\n";
+  Perf::test_scatter_view<Kokkos::OpenMP, Kokkos::LayoutRight,
+                          Kokkos::Experimental::ScatterSparseDuplicated,
+                          Kokkos::Experimental::ScatterNonAtomic>(10,
+                                                                  1000 * 1000);
   // std::cout << "ScatterView atomics test:\n";
   // Perf::test_scatter_view<Kokkos::OpenMP, Kokkos::LayoutRight,
   //  Kokkos::Experimental::ScatterNonDuplicated,
@@ -100,6 +100,17 @@ TEST_F(threads, global_2_local) {
     test_global_to_local_ids<Kokkos::Threads>(i);
 }
 
+TEST_F(threads, global_2_local_open) {
+  typedef Kokkos::Experimental::OpenUnorderedMap<
+      uint32_t, Kokkos::Threads::size_type, Kokkos::Threads>
+      map_type;
+  std::cout << "Threads OpenUnorderedMap" << std::endl;
+  std::cout << "size, create, generate, fill, find" << std::endl;
+  for (unsigned i = Performance::begin_id_size; i <= Performance::end_id_size;
+       i *= Performance::id_step)
+    test_global_to_local_ids<Kokkos::Threads, map_type>(i);
+}
+
 TEST_F(threads, unordered_map_performance_near) {
   unsigned num_threads = 4;
   if (Kokkos::hwloc::available()) {
@@ -50,6 +50,9 @@ namespace Kokkos {
 
 // These should work for most types
 
+/// Hashes integers and enums by multiply-shift, types of at least 16
+/// bytes with the 64-bit MurmurHash64A, and anything else with the
+/// byte-wise MurmurHash3_x86_32.
 template <typename T>
 struct pod_hash {
   typedef T argument_type;
@@ -58,13 +61,24 @@ struct pod_hash {
   typedef uint32_t result_type;
 
   KOKKOS_FORCEINLINE_FUNCTION
-  uint32_t operator()(T const& t) const {
-    return Impl::MurmurHash3_x86_32(&t, sizeof(T), 0);
-  }
+  uint32_t operator()(T const& t) const { return Impl::PodHash<T>::hash(t, 0); }
 
   KOKKOS_FORCEINLINE_FUNCTION
   uint32_t operator()(T const& t, uint32_t seed) const {
-    return Impl::MurmurHash3_x86_32(&t, sizeof(T), seed);
+    return Impl::PodHash<T>::hash(t, seed);
+  }
+
+  /// Hash n keys at once, hashes[i] = (*this)(keys[i], seed).  The
+  /// iterations are independent so that the loop can be vectorized.
+  KOKKOS_INLINE_FUNCTION
+  void batch(T const* const keys, uint32_t* const hashes, const int n,
+             const uint32_t seed = 0) const {
+#if defined(KOKKOS_ENABLE_PRAGMA_IVDEP) && !defined(__CUDA_ARCH__)
+#pragma ivdep
+#endif
+    for (int i = 0; i < n; ++i) {
+      hashes[i] = Impl::PodHash<T>::hash(keys[i], seed);
+    }
   }
 };
 
@@ -0,0 +1,654 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+/// \file Kokkos_OpenUnorderedMap.hpp
+/// \brief Declaration and definition of Kokkos::Experimental::OpenUnorderedMap.
+///
+/// This header file declares and defines an open-addressing alternative to
+/// Kokkos::UnorderedMap with the same concurrent insert / find interface.
+
+#ifndef KOKKOS_OPEN_UNORDERED_MAP_HPP
+#define KOKKOS_OPEN_UNORDERED_MAP_HPP
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Functional.hpp>
+#include <Kokkos_UnorderedMap.hpp>
+
+#include <impl/Kokkos_OpenUnorderedMap_impl.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace Kokkos {
+namespace Experimental {
+
+/// \class OpenUnorderedMap
+/// \brief Thread-safe lookup table with open addressing.
+///
+/// Entries live directly in the slot array, in groups of 16 slots.
+/// Beside the keys the map keeps one control byte per slot holding the
+/// low 7 bits of the key's hash, so that a probe compares 16 slots at once
+/// against the hash and only loads keys whose bits match.  A key hashes
+/// to a group, and probing continues linearly through the following
+/// groups until a group with an empty slot is reached.  Compared to
+/// UnorderedMap a lookup touches one cache line of control bytes instead
+/// of following a chain of dependent indices.
+///
+/// The interface is that of UnorderedMap: insert() does not allocate and
+/// may fail, failed_insert() reports it, rehash() grows the map, and
+/// erase() is only valid between begin_erase() and end_erase().  Erased
+/// slots are not reused until the map is cleared or rehashed.
+///
+/// \tparam Key, Value, Device, Hasher, EqualTo as for UnorderedMap.
+template <typename Key, typename Value,
+          typename Device = Kokkos::DefaultExecutionSpace,
+          typename Hasher = pod_hash<typename std::remove_const<Key>::type>,
+          typename EqualTo =
+              pod_equal_to<typename std::remove_const<Key>::type> >
+class OpenUnorderedMap {
+ private:
+  typedef typename ViewTraits<Key, Device, void, void>::host_mirror_space
+      host_mirror_space;
+
+  typedef Kokkos::Impl::OpenUnorderedMapGroup group_type;
+
+ public:
+  //! \name Public types and constants
+  //@{
+
+  // key_types
+  typedef Key declared_key_type;
+  typedef typename std::remove_const<declared_key_type>::type key_type;
+  typedef typename std::add_const<key_type>::type const_key_type;
+
+  // value_types
+  typedef Value declared_value_type;
+  typedef typename std::remove_const<declared_value_type>::type value_type;
+  typedef typename std::add_const<value_type>::type const_value_type;
+
+  typedef Device device_type;
+  typedef typename Device::execution_space execution_space;
+  typedef Hasher hasher_type;
+  typedef EqualTo equal_to_type;
+  typedef uint32_t size_type;
+
+  // map_types
+  typedef OpenUnorderedMap<declared_key_type, declared_value_type, device_type,
+                           hasher_type, equal_to_type>
+      declared_map_type;
+  typedef OpenUnorderedMap<key_type, value_type, device_type, hasher_type,
+                           equal_to_type>
+      insertable_map_type;
+  typedef OpenUnorderedMap<const_key_type, value_type, device_type,
+                           hasher_type, equal_to_type>
+      modifiable_map_type;
+  typedef OpenUnorderedMap<const_key_type, const_value_type, device_type,
+                           hasher_type, equal_to_type>
+      const_map_type;
+
+  static const bool is_set = std::is_same<void, value_type>::value;
+  static const bool has_const_key =
+      std::is_same<const_key_type, declared_key_type>::value;
+  static const bool has_const_value =
+      is_set || std::is_same<const_value_type, declared_value_type>::value;
+
+  static const bool is_insertable_map =
+      !has_const_key && (is_set || !has_const_value);
+  static const bool is_modifiable_map = has_const_key && !has_const_value;
+  static const bool is_const_map      = has_const_key && has_const_value;
+
+  typedef UnorderedMapInsertResult insert_result;
+
+  typedef OpenUnorderedMap<Key, Value, host_mirror_space, Hasher, EqualTo>
+      HostMirror;
+
+  //@}
+
+ private:
+  enum { invalid_index = ~static_cast<size_type>(0) };
+
+  typedef typename Kokkos::Impl::if_c<is_set, int, declared_value_type>::type
+      impl_value_type;
+
+  typedef typename Kokkos::Impl::if_c<
+      is_insertable_map, View<key_type *, device_type>,
+      View<const key_type *, device_type, MemoryTraits<RandomAccess> > >::type
+      key_type_view;
+
+  typedef typename Kokkos::Impl::if_c<is_insertable_map || is_modifiable_map,
+                              View<impl_value_type *, device_type>,
+                              View<const impl_value_type *, device_type,
+                                   MemoryTraits<RandomAccess> > >::type
+      value_type_view;
+
+  // Control bytes, four to a word; see Impl::OpenUnorderedMapGroup
+  typedef typename Kokkos::Impl::if_c<
+      is_insertable_map, View<uint32_t *, device_type>,
+      View<const uint32_t *, device_type, MemoryTraits<RandomAccess> > >::type
+      ctrl_view;
+
+  enum { modified_idx = 0, erasable_idx = 1, failed_insert_idx = 2 };
+  enum { num_scalars = 3 };
+  typedef View<int[num_scalars], LayoutLeft, device_type> scalars_view;
+
+ public:
+  //! \name Public member functions
+  //@{
+
+  /// \brief Constructor
+  ///
+  /// \param capacity_hint [in] Initial guess of how many unique keys will be
+  ///   inserted into the map.  The capacity leaves 1/8 of the slots empty
+  ///   so that probe sequences stay short.
+  /// \param hash [in] Hasher function for \c Key instances.  The
+  ///   default value usually suffices.
+  OpenUnorderedMap(size_type capacity_hint = 0,
+                   hasher_type hasher      = hasher_type(),
+                   equal_to_type equal_to  = equal_to_type())
+      : m_hasher(hasher),
+        m_equal_to(equal_to),
+        m_size(),
+        m_num_groups(calculate_groups(capacity_hint)),
+        m_ctrl(ViewAllocateWithoutInitializing("OpenUnorderedMap control"),
+               m_num_groups * group_type::words),
+        m_keys("OpenUnorderedMap keys", capacity() + 1),
+        m_values("OpenUnorderedMap values", (is_set ? 1 : capacity() + 1)),
+        m_scalars("OpenUnorderedMap scalars") {
+    if (!is_insertable_map) {
+      throw std::runtime_error(
+          "Cannot construct a non-insertable (i.e. const key_type) "
+          "open_unordered_map");
+    }
+
+    Kokkos::deep_copy(m_ctrl, uint32_t(group_type::empty_words));
+  }
+
+  void reset_failed_insert_flag() { reset_flag(failed_insert_idx); }
+
+  //! Clear all entries in the table.
+  void clear() {
+    if (capacity() == 0) return;
+
+    Kokkos::deep_copy(m_ctrl, uint32_t(group_type::empty_words));
+    {
+      const key_type tmp = key_type();
+      Kokkos::deep_copy(m_keys, tmp);
+    }
+    if (is_set) {
+      const impl_value_type tmp = impl_value_type();
+      Kokkos::deep_copy(m_values, tmp);
+    }
+    { Kokkos::deep_copy(m_scalars, 0); }
+  }
+
+  /// \brief Change the capacity of the the map
+  ///
+  /// The current size of the map is used as a lower bound for the
+  /// requested capacity.  The current entries are inserted into the
+  /// resized map, which drops erased slots.
+  ///
+  /// This is <i>not</i> a device function; it may <i>not</i> be
+  /// called in a parallel kernel.
+  bool rehash(size_type requested_capacity = 0) {
+    if (!is_insertable_map) return false;
+
+    const size_type curr_size = size();
+    requested_capacity =
+        (requested_capacity < curr_size) ? curr_size : requested_capacity;
+
+    insertable_map_type tmp(requested_capacity, m_hasher, m_equal_to);
+
+    if (curr_size) {
+      Kokkos::Impl::UnorderedMapRehash<insertable_map_type> f(tmp, *this);
+      f.apply();
+    }
+
+    *this = tmp;
+
+    return true;
+  }
+
+  /// \brief The number of entries in the table.
+  ///
+  /// This is <i>not</i> a device function; it may <i>not</i> be
+  /// called in a parallel kernel.  It is counted from the control bytes
+  /// after the map has been modified.
+  size_type size() const {
+    if (capacity() == 0u) return 0u;
+    if (modified()) {
+      m_size =
+          Kokkos::Impl::OpenUnorderedMapSize<const_map_type>(*this).apply();
+      reset_flag(modified_idx);
+    }
+    return m_size;
+  }
+
+  /// \brief Whether any insert() failed for lack of capacity.
+  ///
+  /// This is <i>not</i> a device function; it may <i>not</i> be
+  /// called in a parallel kernel.
+  bool failed_insert() const { return get_flag(failed_insert_idx); }
+
+  bool erasable() const {
+    return is_insertable_map ? get_flag(erasable_idx) : false;
+  }
+
+  bool begin_erase() {
+    bool result = !erasable();
+    if (is_insertable_map && result) {
+      execution_space().fence();
+      set_flag(erasable_idx);
+      execution_space().fence();
+    }
+    return result;
+  }
+
+  bool end_erase() {
+    bool result = erasable();
+    if (is_insertable_map && result) {
+      execution_space().fence();
+      reset_flag(erasable_idx);
+    }
+    return result;
+  }
+
+  /// \brief The maximum number of entries that the table can hold.
+  ///
+  /// This <i>is</i> a device function; it may be called in a parallel
+  /// kernel.
+  KOKKOS_FORCEINLINE_FUNCTION
+  size_type capacity() const { return m_num_groups * group_type::size; }
+
+  //---------------------------------------------------------------------------
+  //---------------------------------------------------------------------------
+
+  /// This <i>is</i> a device function; it may be called in a parallel
+  /// kernel.  As for UnorderedMap it need not succeed.  The return value
+  /// tells you if it did.
+  ///
+  /// \param k [in] The key to attempt to insert.
+  /// \param v [in] The corresponding value to attempt to insert.  If
+  ///   using this class as a set (with Value = void), then you need not
+  ///   provide this value.
+  KOKKOS_INLINE_FUNCTION
+  insert_result insert(key_type const &k,
+                       impl_value_type const &v = impl_value_type()) const {
+    insert_result result;
+
+    if (!is_insertable_map || capacity() == 0u ||
+        m_scalars((int)erasable_idx)) {
+      return result;
+    }
+
+    if (!m_scalars((int)modified_idx)) {
+      m_scalars((int)modified_idx) = true;
+    }
+
+    const size_type hash_value = m_hasher(k);
+    const uint32_t tag         = hash_value & 0x7fu;
+    size_type group            = first_group(hash_value);
+
+    // Inserts claim the first empty slot of the probe sequence only, so
+    // that concurrent inserts of one key race for the same slot and the
+    // loser finds the winner's key.
+    for (size_type probe = 0; probe < m_num_groups;) {
+      const group_type g(m_ctrl.data() + group * group_type::words);
+
+      const uint32_t empty = g.match(group_type::empty);
+
+      // Slots past the first empty one cannot hold the key
+      const uint32_t before = empty ? (empty & (~empty + 1u)) - 1u : 0xffffu;
+
+      for (uint32_t hit = g.match(tag) & before; hit; hit &= hit - 1u) {
+        const size_type i =
+            group * group_type::size + Kokkos::Impl::bit_scan_forward(hit);
+        if (m_equal_to(volatile_load(&m_keys[i]), k)) {
+          result.set_existing(i, false);
+          return result;
+        }
+      }
+
+      if (g.match(group_type::busy) & before) {
+        // Another insert is writing a key that may be this one
+        continue;
+      }
+
+      if (empty) {
+        const uint32_t j  = Kokkos::Impl::bit_scan_forward(empty);
+        const size_type i = group * group_type::size + j;
+        if (claim(group * group_type::words + (j >> 2), 8 * (j & 3))) {
+          KOKKOS_NONTEMPORAL_PREFETCH_STORE(&m_keys[i]);
+          m_keys[i] = k;
+
+          if (!is_set) {
+            KOKKOS_NONTEMPORAL_PREFETCH_STORE(&m_values[i]);
+            m_values[i] = v;
+          }
+
+          // Do not publish the slot until key and value are in global memory
+          memory_fence();
+          atomic_fetch_xor(&m_ctrl[group * group_type::words + (j >> 2)],
+                           (group_type::busy ^ tag) << (8 * (j & 3)));
+
+          result.set_success(i);
+          return result;
+        }
+        // Lost the slot to another insert, look at this group again
+        continue;
+      }
+
+      result.increment_list_position();
+      group = (group + 1 < m_num_groups) ? group + 1 : 0;
+      ++probe;
+    }
+
+    m_scalars((int)failed_insert_idx) = true;
+    return result;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  bool erase(key_type const &k) const {
+    bool result = false;
+
+    if (is_insertable_map && 0u < capacity() && m_scalars((int)erasable_idx)) {
+      if (!m_scalars((int)modified_idx)) {
+        m_scalars((int)modified_idx) = true;
+      }
+
+      const size_type i = find(k);
+      if (valid_at(i)) {
+        const uint32_t tag   = m_hasher(k) & 0x7fu;
+        const uint32_t shift = 8 * (i & 3);
+        uint32_t *const word = &m_ctrl[i >> 2];
+        uint32_t old         = volatile_load(word);
+        // Another erase of this key may win the exchange
+        while (((old >> shift) & 0xffu) == tag) {
+          const uint32_t prev = atomic_compare_exchange(
+              word, old, old ^ ((tag ^ group_type::erased) << shift));
+          if (prev == old) {
+            result = true;
+            break;
+          }
+          old = prev;
+        }
+      }
+    }
+
+    return result;
+  }
+
+  /// \brief Find the given key \c k, if it exists in the table.
+  ///
+  /// \return If the key exists in the table, the index of the
+  ///   value corresponding to that key; otherwise, an invalid index.
+  ///
+  /// This <i>is</i> a device function; it may be called in a parallel
+  /// kernel.
+  KOKKOS_INLINE_FUNCTION
+  size_type find(const key_type &k) const {
+    if (capacity() == 0u) return invalid_index;
+
+    const size_type hash_value = m_hasher(k);
+    const uint32_t tag         = hash_value & 0x7fu;
+    size_type group            = first_group(hash_value);
+
+    for (size_type probe = 0; probe < m_num_groups; ++probe) {
+      const group_type g(m_ctrl.data() + group * group_type::words);
+
+      for (uint32_t hit = g.match(tag); hit; hit &= hit - 1u) {
+        const size_type i =
+            group * group_type::size + Kokkos::Impl::bit_scan_forward(hit);
+        if (m_equal_to(m_keys[i], k)) return i;
+      }
+
+      if (g.match(group_type::empty)) break;
+
+      group = (group + 1 < m_num_groups) ? group + 1 : 0;
+    }
+
+    return invalid_index;
+  }
+
+  /// \brief Does the key exist in the map
+  ///
+  /// This <i>is</i> a device function; it may be called in a parallel
+  /// kernel.
+  KOKKOS_INLINE_FUNCTION
+  bool exists(const key_type &k) const { return valid_at(find(k)); }
+
+  /// \brief Get the value with \c i as its direct index.
+  ///
+  /// This <i>is</i> a device function; it may be called in a parallel
+  /// kernel.
+  KOKKOS_FORCEINLINE_FUNCTION
+  typename Kokkos::Impl::if_c<(is_set || has_const_value), impl_value_type,
+                      impl_value_type &>::type
+  value_at(size_type i) const {
+    return m_values[is_set ? 0 : (i < capacity() ? i : capacity())];
+  }
+
+  /// \brief Get the key with \c i as its direct index.
+  ///
+  /// This <i>is</i> a device function; it may be called in a parallel
+  /// kernel.
+  KOKKOS_FORCEINLINE_FUNCTION
+  key_type key_at(size_type i) const {
+    return m_keys[i < capacity() ? i : capacity()];
+  }
+
+  KOKKOS_FORCEINLINE_FUNCTION
+  bool valid_at(size_type i) const {
+    return i < capacity() &&
+           ((m_ctrl[i >> 2] >> (8 * (i & 3))) & 0xffu) < group_type::empty;
+  }
+
+  template <typename SKey, typename SValue>
+  OpenUnorderedMap(
+      OpenUnorderedMap<SKey, SValue, Device, Hasher, EqualTo> const &src,
+      typename std::enable_if<
+          Kokkos::Impl::UnorderedMapCanAssign<
+              declared_key_type, declared_value_type, SKey, SValue>::value,
+          int>::type = 0)
+      : m_hasher(src.m_hasher),
+        m_equal_to(src.m_equal_to),
+        m_size(src.m_size),
+        m_num_groups(src.m_num_groups),
+        m_ctrl(src.m_ctrl),
+        m_keys(src.m_keys),
+        m_values(src.m_values),
+        m_scalars(src.m_scalars) {}
+
+  template <typename SKey, typename SValue>
+  typename std::enable_if<
+      Kokkos::Impl::UnorderedMapCanAssign<
+          declared_key_type, declared_value_type, SKey, SValue>::value,
+      declared_map_type &>::type
+  operator=(
+      OpenUnorderedMap<SKey, SValue, Device, Hasher, EqualTo> const &src) {
+    m_hasher     = src.m_hasher;
+    m_equal_to   = src.m_equal_to;
+    m_size       = src.m_size;
+    m_num_groups = src.m_num_groups;
+    m_ctrl       = src.m_ctrl;
+    m_keys       = src.m_keys;
+    m_values     = src.m_values;
+    m_scalars    = src.m_scalars;
+    return *this;
+  }
+
+  template <typename SKey, typename SValue, typename SDevice>
+  typename std::enable_if<
+      std::is_same<typename std::remove_const<SKey>::type, key_type>::value &&
+      std::is_same<typename std::remove_const<SValue>::type,
+                   value_type>::value>::type
+  create_copy_view(
+      OpenUnorderedMap<SKey, SValue, SDevice, Hasher, EqualTo> const &src) {
+    if (m_ctrl.data() != src.m_ctrl.data()) {
+      insertable_map_type tmp;
+
+      tmp.m_hasher     = src.m_hasher;
+      tmp.m_equal_to   = src.m_equal_to;
+      tmp.m_size       = src.size();
+      tmp.m_num_groups = src.m_num_groups;
+      tmp.m_ctrl = typename insertable_map_type::ctrl_view(
+          ViewAllocateWithoutInitializing("OpenUnorderedMap control"),
+          src.m_ctrl.extent(0));
+      tmp.m_keys = typename insertable_map_type::key_type_view(
+          ViewAllocateWithoutInitializing("OpenUnorderedMap keys"),
+          src.m_keys.extent(0));
+      tmp.m_values = typename insertable_map_type::value_type_view(
+          ViewAllocateWithoutInitializing("OpenUnorderedMap values"),
+          src.m_values.extent(0));
+      tmp.m_scalars = scalars_view("OpenUnorderedMap scalars");
+
+      typedef Kokkos::Impl::DeepCopy<typename device_type::memory_space,
+                                     typename SDevice::memory_space>
+          raw_deep_copy;
+
+      raw_deep_copy(tmp.m_ctrl.data(), src.m_ctrl.data(),
+                    sizeof(uint32_t) * src.m_ctrl.extent(0));
+      raw_deep_copy(tmp.m_keys.data(), src.m_keys.data(),
+                    sizeof(key_type) * src.m_keys.extent(0));
+      if (!is_set) {
+        raw_deep_copy(tmp.m_values.data(), src.m_values.data(),
+                      sizeof(impl_value_type) * src.m_values.extent(0));
+      }
+      raw_deep_copy(tmp.m_scalars.data(), src.m_scalars.data(),
+                    sizeof(int) * num_scalars);
+
+      *this = tmp;
+    }
+  }
+
+  //@}
+ private:  // private member functions
+  bool modified() const { return get_flag(modified_idx); }
+
+  void set_flag(int flag) const {
+    typedef Kokkos::Impl::DeepCopy<typename device_type::memory_space,
+                                   Kokkos::HostSpace>
+        raw_deep_copy;
+    const int true_ = true;
+    raw_deep_copy(m_scalars.data() + flag, &true_, sizeof(int));
+  }
+
+  void reset_flag(int flag) const {
+    typedef Kokkos::Impl::DeepCopy<typename device_type::memory_space,
+                                   Kokkos::HostSpace>
+        raw_deep_copy;
+    const int false_ = false;
+    raw_deep_copy(m_scalars.data() + flag, &false_, sizeof(int));
+  }
+
+  bool get_flag(int flag) const {
+    typedef Kokkos::Impl::DeepCopy<Kokkos::HostSpace,
+                                   typename device_type::memory_space>
+        raw_deep_copy;
+    int result = false;
+    raw_deep_copy(&result, m_scalars.data() + flag, sizeof(int));
+    return result;
+  }
+
+  static size_type calculate_groups(size_type capacity_hint) {
+    // keep 1/8 of the slots empty, at least 128 slots
+    const uint64_t slots = 8ull * capacity_hint / 7u;
+    const uint64_t groups =
+        (slots + group_type::size - 1) / group_type::size;
+    return groups < 8u ? 8u : static_cast<size_type>(groups);
+  }
+
+  // The group a hash starts probing at, from the high bits of the hash
+  // since the low bits are in the control byte
+  KOKKOS_FORCEINLINE_FUNCTION
+  size_type first_group(const size_type hash_value) const {
+    return static_cast<size_type>((uint64_t(hash_value) * m_num_groups) >> 32);
+  }
+
+  // Claim the empty control byte at 'shift' of word 'w' for an insert
+  KOKKOS_INLINE_FUNCTION
+  bool claim(const size_type w, const uint32_t shift) const {
+    uint32_t *const word = &m_ctrl[w];
+    uint32_t old         = volatile_load(word);
+    while (((old >> shift) & 0xffu) == group_type::empty) {
+      const uint32_t claimed =
+          old ^ ((group_type::empty ^ group_type::busy) << shift);
+      const uint32_t prev = atomic_compare_exchange(word, old, claimed);
+      if (prev == old) return true;
+      // Another byte of the word changed, or this one was taken
+      old = prev;
+    }
+    return false;
+  }
+
+ private:  // private members
+  hasher_type m_hasher;
+  equal_to_type m_equal_to;
+  mutable size_type m_size;
+  size_type m_num_groups;
+  ctrl_view m_ctrl;
+  key_type_view m_keys;
+  value_type_view m_values;
+  scalars_view m_scalars;
+
+  template <typename KKey, typename VValue, typename DDevice, typename HHash,
+            typename EEqualTo>
+  friend class OpenUnorderedMap;
+
+  template <typename UMap>
+  friend struct Kokkos::Impl::OpenUnorderedMapSize;
+};
+
+// Specialization of deep_copy for two OpenUnorderedMap objects.
+template <typename DKey, typename DT, typename DDevice, typename SKey,
+          typename ST, typename SDevice, typename Hasher, typename EqualTo>
+inline void deep_copy(
+    OpenUnorderedMap<DKey, DT, DDevice, Hasher, EqualTo> &dst,
+    const OpenUnorderedMap<SKey, ST, SDevice, Hasher, EqualTo> &src) {
+  dst.create_copy_view(src);
+}
+
+}  // namespace Experimental
+}  // namespace Kokkos
+
+#endif  // KOKKOS_OPEN_UNORDERED_MAP_HPP
@@ -69,7 +69,11 @@ enum : int {
   ScatterMin,
 };
 
-enum : int { ScatterNonDuplicated = 0, ScatterDuplicated = 1 };
+enum : int {
+  ScatterNonDuplicated    = 0,
+  ScatterDuplicated       = 1,
+  ScatterSparseDuplicated = 2
+};
 
 enum : int { ScatterNonAtomic = 0, ScatterAtomic = 1 };
 
@@ -86,6 +90,14 @@ struct DefaultDuplication;
 template <typename ExecSpace, int duplication>
 struct DefaultContribution;
 
+/* The tiles of a sparse duplicate are private to the thread that owns them,
+   so no backend needs atomics to update them */
+template <typename ExecSpace>
+struct DefaultContribution<ExecSpace,
+                           Kokkos::Experimental::ScatterSparseDuplicated> {
+  enum : int { value = Kokkos::Experimental::ScatterNonAtomic };
+};
+
 #ifdef KOKKOS_ENABLE_SERIAL
 template <>
 struct DefaultDuplication<Kokkos::Serial> {
@@ -455,6 +467,77 @@ struct ScatterValue<ValueType, Kokkos::Experimental::ScatterMax, DeviceType,
   KOKKOS_FORCEINLINE_FUNCTION void reset() { this->init(this->reference()); }
 };
 
+/* ScatterTileValue is the object returned by the access operator() of the
+   sparse duplicated ScatterAccess. Contributions land either in a tile private
+   to the calling thread, and are applied with the requested contribution, or,
+   once the tile pool is exhausted, in the shared original view, where they
+   must be atomic. Only the operators supported by Op get instantiated. */
+template <typename ValueType, int Op, typename DeviceType, int contribution>
+struct ScatterTileValue {
+  typedef ScatterValue<ValueType, Op, DeviceType, contribution> tile_value_type;
+  typedef ScatterValue<ValueType, Op, DeviceType,
+                       Kokkos::Experimental::ScatterAtomic>
+      shared_value_type;
+
+  KOKKOS_FORCEINLINE_FUNCTION ScatterTileValue(ValueType& value_in,
+                                               bool shared_in)
+      : value(value_in), shared(shared_in) {}
+
+  KOKKOS_FORCEINLINE_FUNCTION void operator+=(ValueType const& rhs) {
+    if (shared) {
+      shared_value_type sv(value);
+      sv += rhs;
+    } else {
+      tile_value_type sv(value);
+      sv += rhs;
+    }
+  }
+  KOKKOS_FORCEINLINE_FUNCTION void operator-=(ValueType const& rhs) {
+    if (shared) {
+      shared_value_type sv(value);
+      sv -= rhs;
+    } else {
+      tile_value_type sv(value);
+      sv -= rhs;
+    }
+  }
+  KOKKOS_FORCEINLINE_FUNCTION void operator*=(ValueType const& rhs) {
+    if (shared) {
+      shared_value_type sv(value);
+      sv *= rhs;
+    } else {
+      tile_value_type sv(value);
+      sv *= rhs;
+    }
+  }
+  KOKKOS_FORCEINLINE_FUNCTION void operator/=(ValueType const& rhs) {
+    if (shared) {
+      shared_value_type sv(value);
+      sv /= rhs;
+    } else {
+      tile_value_type sv(value);
+      sv /= rhs;
+    }
+  }
+  KOKKOS_FORCEINLINE_FUNCTION void update(ValueType const& rhs) {
+    if (shared) {
+      shared_value_type sv(value);
+      sv.update(rhs);
+    } else {
+      tile_value_type sv(value);
+      sv.update(rhs);
+    }
+  }
+  KOKKOS_FORCEINLINE_FUNCTION void reset() {
+    tile_value_type sv(value);
+    sv.reset();
+  }
+
+ private:
+  ValueType& value;
+  bool shared;
+};
+
 /* DuplicatedDataType, given a View DataType, will create a new DataType
    that has a new runtime dimension which becomes the largest-stride dimension.
    In the case of LayoutLeft, due to the limitation induced by the design of
@@ -659,6 +742,66 @@ struct ResetDuplicates : public ResetDuplicatesBase<ExecSpace, ValueType, Op> {
   }
 };
 
+/* ReduceTiles -- Merge the tiles of a sparse duplicate into the destination
+ * array. Each parallel iterate owns one tile of the destination and walks the
+ * tile table of every thread, so only the tiles that were actually touched are
+ * read and no atomics are needed */
+template <typename ExecSpace, typename ValueType, int Op>
+struct ReduceTiles {
+  ValueType const* src;
+  int const* table;
+  ValueType* dst;
+  size_t rows;
+  size_t num_tiles;
+  size_t n;
+  size_t tile_shift;
+  ReduceTiles(ValueType const* src_in, int const* table_in, ValueType* dst_in,
+              size_t rows_in, size_t num_tiles_in, size_t n_in,
+              size_t tile_shift_in, std::string const& name)
+      : src(src_in),
+        table(table_in),
+        dst(dst_in),
+        rows(rows_in),
+        num_tiles(num_tiles_in),
+        n(n_in),
+        tile_shift(tile_shift_in) {
+#if defined(KOKKOS_ENABLE_PROFILING)
+    uint64_t kpID = 0;
+    if (Kokkos::Profiling::profileLibraryLoaded()) {
+      Kokkos::Profiling::beginParallelFor(std::string("reduce_") + name, 0,
+                                          &kpID);
+    }
+#else
+    (void)name;
+#endif
+    typedef RangePolicy<ExecSpace, size_t> policy_type;
+    typedef Kokkos::Impl::ParallelFor<ReduceTiles, policy_type> closure_type;
+    const closure_type closure(*this, policy_type(0, num_tiles));
+    closure.execute();
+#if defined(KOKKOS_ENABLE_PROFILING)
+    if (Kokkos::Profiling::profileLibraryLoaded()) {
+      Kokkos::Profiling::endParallelFor(kpID);
+    }
+#endif
+  }
+  KOKKOS_FORCEINLINE_FUNCTION void operator()(size_t tile) const {
+    size_t const tile_size = size_t(1) << tile_shift;
+    size_t const begin     = tile << tile_shift;
+    size_t const end       = n - begin > tile_size ? begin + tile_size : n;
+    for (size_t r = 0; r < rows; ++r) {
+      int const slot = table[r * num_tiles + tile];
+      if (slot < 0) continue;
+      ValueType const* const values = src + (size_t(slot) << tile_shift);
+      for (size_t i = begin; i < end; ++i) {
+        ScatterValue<ValueType, Op, ExecSpace,
+                     Kokkos::Experimental::ScatterNonAtomic>
+            sv(dst[i]);
+        sv.update(values[i - begin]);
+      }
+    }
+  }
+};
+
 }  // namespace Experimental
 }  // namespace Impl
 }  // namespace Kokkos
@@ -1259,6 +1402,282 @@ class ScatterAccess<DataType, Op, DeviceType, Layout, ScatterDuplicated,
   thread_id_type thread_id;
 };
 
+// sparse duplicated implementation
+// Instead of a full copy of the view per thread, every thread owns a row of a
+// tile table that maps fixed-size tiles of the view's span to tiles taken
+// lazily from a shared pool. Memory is bounded by the pool rather than by the
+// thread count; once the pool is exhausted, contributions fall back to atomic
+// updates of the original view, which (as in the non-duplicated case) the
+// ScatterView keeps a reference to.
+
+template <typename DataType, int Op, typename DeviceType, typename Layout,
+          int contribution>
+class ScatterView<DataType, Layout, DeviceType, Op, ScatterSparseDuplicated,
+                  contribution> {
+ public:
+  using execution_space = typename DeviceType::execution_space;
+  using memory_space    = typename DeviceType::memory_space;
+  using device_type     = Kokkos::Device<execution_space, memory_space>;
+  typedef Kokkos::View<DataType, Layout, device_type> original_view_type;
+  typedef typename original_view_type::value_type original_value_type;
+  typedef typename original_view_type::reference_type original_reference_type;
+  friend class ScatterAccess<DataType, Op, DeviceType, Layout,
+                             ScatterSparseDuplicated, contribution,
+                             ScatterNonAtomic>;
+  friend class ScatterAccess<DataType, Op, DeviceType, Layout,
+                             ScatterSparseDuplicated, contribution,
+                             ScatterAtomic>;
+  template <class, class, class, int, int, int>
+  friend class ScatterView;
+
+  typedef Kokkos::View<int**, Kokkos::LayoutRight, device_type>
+      tile_table_type;
+  typedef Kokkos::View<original_value_type**, Kokkos::LayoutRight, device_type>
+      tile_pool_type;
+  typedef Kokkos::View<int, device_type> tile_count_type;
+
+  enum : size_t { tile_shift = 10, tile_size = size_t(1) << tile_shift };
+  enum : int { empty_tile = -1, shared_tile = -2 };
+
+  ScatterView() = default;
+
+  /* max_tiles bounds the number of tiles shared by all threads. The default
+     (zero) allows for twice the size of the original view, or one tile per
+     thread for views smaller than that. */
+  template <typename RT, typename... RP>
+  ScatterView(View<RT, RP...> const& original_view, size_t max_tiles = 0)
+      : unique_token(), internal_view(original_view) {
+    allocate_tiles(max_tiles);
+  }
+
+  template <typename... Dims>
+  ScatterView(std::string const& name, Dims... dims)
+      : internal_view(name, dims...) {
+    allocate_tiles(0);
+  }
+
+  template <typename OtherDataType, typename OtherDeviceType>
+  KOKKOS_FUNCTION ScatterView(
+      const ScatterView<OtherDataType, Layout, OtherDeviceType, Op,
+                        ScatterSparseDuplicated, contribution>& other_view)
+      : unique_token(other_view.unique_token),
+        internal_view(other_view.internal_view),
+        tile_table(other_view.tile_table),
+        tiles(other_view.tiles),
+        tile_count(other_view.tile_count),
+        requested_tiles(other_view.requested_tiles) {}
+
+  template <typename OtherDataType, typename OtherDeviceType>
+  KOKKOS_FUNCTION void operator=(
+      const ScatterView<OtherDataType, Layout, OtherDeviceType, Op,
+                        ScatterSparseDuplicated, contribution>& other_view) {
+    unique_token    = other_view.unique_token;
+    internal_view   = other_view.internal_view;
+    tile_table      = other_view.tile_table;
+    tiles           = other_view.tiles;
+    tile_count      = other_view.tile_count;
+    requested_tiles = other_view.requested_tiles;
+  }
+
+  template <int override_contribution = contribution>
+  KOKKOS_FORCEINLINE_FUNCTION
+      ScatterAccess<DataType, Op, DeviceType, Layout, ScatterSparseDuplicated,
+                    contribution, override_contribution>
+      access() const {
+    return ScatterAccess<DataType, Op, DeviceType, Layout,
+                         ScatterSparseDuplicated, contribution,
+                         override_contribution>(*this);
+  }
+
+  original_view_type subview() const { return internal_view; }
+
+  template <typename DT, typename... RP>
+  void contribute_into(View<DT, RP...> const& dest) const {
+    typedef View<DT, RP...> dest_type;
+    static_assert(std::is_same<typename dest_type::array_layout, Layout>::value,
+                  "ScatterView contribute destination has different layout");
+    static_assert(
+        Kokkos::Impl::VerifyExecutionCanAccessMemorySpace<
+            memory_space, typename dest_type::memory_space>::value,
+        "ScatterView contribute destination memory space not accessible");
+    if (dest.data() != internal_view.data()) {
+      Kokkos::Impl::Experimental::ReduceDuplicates<execution_space,
+                                                   original_value_type, Op>(
+          internal_view.data(), dest.data(), internal_view.span(), 0, 1,
+          internal_view.label());
+    }
+    Kokkos::Impl::Experimental::ReduceTiles<execution_space,
+                                            original_value_type, Op>(
+        tiles.data(), tile_table.data(), dest.data(), tile_table.extent(0),
+        tile_table.extent(1), internal_view.span(), tile_shift,
+        internal_view.label());
+  }
+
+  void reset() {
+    Kokkos::Impl::Experimental::ResetDuplicates<execution_space,
+                                                original_value_type, Op>(
+        internal_view.data(), internal_view.size(), internal_view.label());
+    release_tiles();
+  }
+  template <typename DT, typename... RP>
+  void reset_except(View<DT, RP...> const& view) {
+    if (view.data() != internal_view.data()) {
+      reset();
+      return;
+    }
+    release_tiles();
+  }
+
+  void resize(const size_t n0 = 0, const size_t n1 = 0, const size_t n2 = 0,
+              const size_t n3 = 0, const size_t n4 = 0, const size_t n5 = 0,
+              const size_t n6 = 0, const size_t n7 = 0) {
+    ::Kokkos::resize(internal_view, n0, n1, n2, n3, n4, n5, n6, n7);
+    allocate_tiles(requested_tiles);
+  }
+
+  void realloc(const size_t n0 = 0, const size_t n1 = 0, const size_t n2 = 0,
+               const size_t n3 = 0, const size_t n4 = 0, const size_t n5 = 0,
+               const size_t n6 = 0, const size_t n7 = 0) {
+    ::Kokkos::realloc(internal_view, n0, n1, n2, n3, n4, n5, n6, n7);
+    allocate_tiles(requested_tiles);
+  }
+
+  size_t tile_capacity() const { return tiles.extent(0); }
+
+ protected:
+  template <int override_contribution, typename... Args>
+  KOKKOS_FORCEINLINE_FUNCTION Kokkos::Impl::Experimental::ScatterTileValue<
+      original_value_type, Op, DeviceType, override_contribution>
+  at(int thread_id, Args... args) const {
+    typedef Kokkos::Impl::Experimental::ScatterTileValue<
+        original_value_type, Op, DeviceType, override_contribution>
+        value_type;
+    original_value_type& shared_value = internal_view(args...);
+    size_t const offset = &shared_value - internal_view.data();
+    size_t const tile   = offset >> tile_shift;
+    int slot            = tile_table(thread_id, tile);
+    if (slot == empty_tile) slot = claim_tile(thread_id, tile);
+    if (slot == shared_tile) return value_type(shared_value, true);
+    return value_type(tiles.data()[(size_t(slot) << tile_shift) +
+                                   (offset & (tile_size - 1))],
+                      false);
+  }
+
+  /* Only the holder of thread_id writes its row of the tile table, so the pool
+     counter is the only shared state. A row entry is claimed at most once
+     between resets, which keeps the counter from running away once the pool
+     is exhausted. */
+  KOKKOS_INLINE_FUNCTION
+  int claim_tile(int thread_id, size_t tile) const {
+    int slot = Kokkos::atomic_fetch_add(&tile_count(), 1);
+    if (slot < int(tiles.extent(0))) {
+      for (size_t i = 0; i < tile_size; ++i) {
+        Kokkos::Impl::Experimental::ScatterValue<original_value_type, Op,
+                                                 DeviceType, ScatterNonAtomic>
+            sv(tiles(slot, i));
+        sv.reset();
+      }
+    } else {
+      slot = shared_tile;
+    }
+    tile_table(thread_id, tile) = slot;
+    return slot;
+  }
+
+  void allocate_tiles(size_t max_tiles) {
+    size_t const rows      = unique_token.size();
+    size_t const num_tiles =
+        (internal_view.span() + tile_size - 1) >> tile_shift;
+    requested_tiles = max_tiles;
+    if (max_tiles == 0) {
+      max_tiles = 2 * num_tiles < rows ? rows : 2 * num_tiles;
+    }
+    if (max_tiles > rows * num_tiles) max_tiles = rows * num_tiles;
+    std::string const label = internal_view.label();
+    tile_table = tile_table_type(
+        Kokkos::ViewAllocateWithoutInitializing(label + "_tile_table"), rows,
+        num_tiles);
+    tiles = tile_pool_type(
+        Kokkos::ViewAllocateWithoutInitializing(label + "_tiles"), max_tiles,
+        size_t(tile_size));
+    tile_count = tile_count_type(label + "_tile_count");
+    release_tiles();
+  }
+
+  void release_tiles() {
+    Kokkos::deep_copy(tile_table, int(empty_tile));
+    Kokkos::deep_copy(tile_count, 0);
+  }
+
+ protected:
+  typedef Kokkos::Experimental::UniqueToken<
+      execution_space, Kokkos::Experimental::UniqueTokenScope::Global>
+      unique_token_type;
+
+  unique_token_type unique_token;
+  original_view_type internal_view;
+  tile_table_type tile_table;
+  tile_pool_type tiles;
+  tile_count_type tile_count;
+  size_t requested_tiles = 0;
+};
+
+template <typename DataType, int Op, typename DeviceType, typename Layout,
+          int contribution, int override_contribution>
+class ScatterAccess<DataType, Op, DeviceType, Layout, ScatterSparseDuplicated,
+                    contribution, override_contribution> {
+ public:
+  typedef ScatterView<DataType, Layout, DeviceType, Op,
+                      ScatterSparseDuplicated, contribution>
+      view_type;
+  typedef typename view_type::original_value_type original_value_type;
+  typedef Kokkos::Impl::Experimental::ScatterTileValue<
+      original_value_type, Op, DeviceType, override_contribution>
+      value_type;
+
+  KOKKOS_FORCEINLINE_FUNCTION
+  ScatterAccess(view_type const& view_in)
+      : view(view_in), thread_id(view_in.unique_token.acquire()) {}
+
+  KOKKOS_FORCEINLINE_FUNCTION
+  ~ScatterAccess() {
+    if (thread_id != ~thread_id_type(0)) view.unique_token.release(thread_id);
+  }
+
+  template <typename... Args>
+  KOKKOS_FORCEINLINE_FUNCTION value_type operator()(Args... args) const {
+    return view.template at<override_contribution>(thread_id, args...);
+  }
+
+  template <typename Arg>
+  KOKKOS_FORCEINLINE_FUNCTION
+      typename std::enable_if<view_type::original_view_type::rank == 1 &&
+                                  std::is_integral<Arg>::value,
+                              value_type>::type
+      operator[](Arg arg) const {
+    return view.template at<override_contribution>(thread_id, arg);
+  }
+
+ private:
+  view_type const& view;
+
+  ScatterAccess(ScatterAccess const& other) = delete;
+  ScatterAccess& operator=(ScatterAccess const& other) = delete;
+  ScatterAccess& operator=(ScatterAccess&& other) = delete;
+
+ public:
+  KOKKOS_FORCEINLINE_FUNCTION
+  ScatterAccess(ScatterAccess&& other)
+      : view(other.view), thread_id(other.thread_id) {
+    other.thread_id = ~thread_id_type(0);
+  }
+
+ private:
+  typedef typename view_type::unique_token_type unique_token_type;
+  typedef typename unique_token_type::size_type thread_id_type;
+  thread_id_type thread_id;
+};
+
 template <int Op = Kokkos::Experimental::ScatterSum, int duplication = -1,
           int contribution = -1, typename RT, typename... RP>
 ScatterView<
@@ -62,6 +62,7 @@
 #include <iostream>
 
 #include <cstdint>
+#include <utility>
 #include <stdexcept>
 
 namespace Kokkos {
@@ -389,6 +390,59 @@ class UnorderedMap {
     return true;
   }
 
+  /// \brief Run an insert phase, growing the map until all inserts succeed.
+  ///
+  /// Calls <tt>functor(map, i)</tt> for each i in [0, n) in a parallel
+  /// kernel.  The functor inserts the entries of item i into \c map and
+  /// returns false if any of these inserts failed.  Whenever inserts
+  /// failed, or the map is filled beyond \c max_fill_ratio, its entries
+  /// are migrated in parallel to a table of twice the capacity and only
+  /// the items that failed are run again.  Inserting an entry of an item
+  /// that is already in the map is harmless, so items may insert more
+  /// than one entry.
+  ///
+  /// The functor must insert into the \c map argument rather than a
+  /// captured copy, which no longer refers to this map after it grew.
+  ///
+  /// This is <i>not</i> a device function; it may <i>not</i> be
+  /// called in a parallel kernel.
+  template <typename Functor>
+  void grow_insert(const size_type n, Functor const &functor,
+                   const float max_fill_ratio = 0.8f) {
+    if (!is_insertable_map || n == 0u) return;
+
+    typedef Impl::UnorderedMapGrowInsert<declared_map_type, Functor>
+        grow_type;
+
+    if (capacity() == 0u) rehash(n);
+
+    typename grow_type::index_view pending;
+    typename grow_type::index_view failed(
+        ViewAllocateWithoutInitializing("UnorderedMap grow_insert"), n);
+    typename grow_type::count_view num_failed("UnorderedMap grow_insert");
+
+    size_type num_pending = n;
+    while (0u < num_pending) {
+      num_pending =
+          grow_type(*this, functor, pending, failed, num_failed)
+              .apply(num_pending);
+
+      if (num_pending || max_fill_ratio * capacity() < size()) {
+        rehash(2u * capacity());
+      }
+
+      // The failed items of this pass are the pending items of the next
+      if (num_pending) {
+        if (!pending.extent(0)) {
+          pending = typename grow_type::index_view(
+              ViewAllocateWithoutInitializing("UnorderedMap grow_insert"),
+              n);
+        }
+        std::swap(pending, failed);
+      }
+    }
+  }
+
   /// \brief The number of entries in the table.
   ///
   /// This method has undefined behavior when erasable() is true.
@@ -596,6 +650,29 @@ class UnorderedMap {
     return result;
   }
 
+  /// \brief Insert keys(i) with values(i) for every i of the views.
+  ///
+  /// results(i) is the UnorderedMapInsertResult of the insert of
+  /// keys(i).  The keys are first binned by the hash list they fall into
+  /// so that the inserts run through the table in order rather than in
+  /// the random order of the keys.  \c values is not read if the map is
+  /// a set.  The views must be accessible from the map's execution
+  /// space.
+  ///
+  /// This is <i>not</i> a device function; it may <i>not</i> be
+  /// called in a parallel kernel.
+  template <typename KeysView, typename ValuesView, typename ResultsView>
+  typename std::enable_if<Kokkos::is_view<KeysView>::value>::type insert(
+      KeysView const &keys, ValuesView const &values,
+      ResultsView const &results) const {
+    if (!is_insertable_map || keys.extent(0) == 0u) return;
+
+    Impl::UnorderedMapBulkInsert<declared_map_type, KeysView, ValuesView,
+                                 ResultsView>
+        f(*this, keys, values, results);
+    f.apply();
+  }
+
   KOKKOS_INLINE_FUNCTION
   bool erase(key_type const &k) const {
     bool result = false;
@@ -638,6 +715,23 @@ class UnorderedMap {
     return curr;
   }
 
+  /// \brief Find keys(i) for every i of the views.
+  ///
+  /// indices(i) is find(keys(i)).  As for the bulk insert() the keys are
+  /// visited in the order of their hash lists.
+  ///
+  /// This is <i>not</i> a device function; it may <i>not</i> be
+  /// called in a parallel kernel.
+  template <typename KeysView, typename IndicesView>
+  typename std::enable_if<Kokkos::is_view<KeysView>::value>::type find(
+      KeysView const &keys, IndicesView const &indices) const {
+    if (capacity() == 0u || keys.extent(0) == 0u) return;
+
+    Impl::UnorderedMapBulkFind<declared_map_type, KeysView, IndicesView> f(
+        *this, keys, indices);
+    f.apply();
+  }
+
   /// \brief Does the key exist in the map
   ///
   /// This <i>is</i> a device function; it may be called in a parallel
@@ -820,6 +914,12 @@ class UnorderedMap {
   template <typename UMap>
   friend struct Impl::UnorderedMapErase;
 
+  template <typename UMap, typename Functor>
+  friend struct Impl::UnorderedMapGrowInsert;
+
+  template <typename UMap, typename KeysView>
+  friend struct Impl::UnorderedMapBinKeys;
+
   template <typename UMap>
   friend struct Impl::UnorderedMapHistogram;
 
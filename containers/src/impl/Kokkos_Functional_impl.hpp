@@ -45,6 +45,7 @@
 
 #include <Kokkos_Macros.hpp>
 #include <cstdint>
+#include <type_traits>
 
 namespace Kokkos {
 namespace Impl {
@@ -126,6 +127,118 @@ uint32_t MurmurHash3_x86_32(const void* key, int len, uint32_t seed) {
   return h1;
 }
 
+KOKKOS_FORCEINLINE_FUNCTION
+uint64_t getblock64(const uint8_t* p, int i) {
+  return ((uint64_t)getblock32(p, 2 * i + 1) << 32) | getblock32(p, 2 * i);
+}
+
+// MurmurHash64A, also by Austin Appleby, consumes 8 bytes per step
+KOKKOS_INLINE_FUNCTION
+uint32_t MurmurHash64A(const void* key, int len, uint32_t seed) {
+  const uint8_t* data = (const uint8_t*)key;
+  const int nblocks   = len / 8;
+
+  const uint64_t m = 0xc6a4a7935bd1e995ull;
+  const int r      = 47;
+
+  uint64_t h = seed ^ (len * m);
+
+  //----------
+  // body
+
+  for (int i = 0; i < nblocks; ++i) {
+    uint64_t k = getblock64(data, i);
+
+    k *= m;
+    k ^= k >> r;
+    k *= m;
+
+    h ^= k;
+    h *= m;
+  }
+
+  //----------
+  // tail
+
+  const uint8_t* tail = (const uint8_t*)(data + nblocks * 8);
+
+  const int rest = len & 7;
+  if (rest != 0) {
+    for (int i = 0; i < rest; ++i) h ^= uint64_t(tail[i]) << (8 * i);
+    h *= m;
+  }
+
+  //----------
+  // finalization
+
+  h ^= h >> r;
+  h *= m;
+  h ^= h >> r;
+
+  return static_cast<uint32_t>(h ^ (h >> 32));
+}
+
+// Multiply-shift hash of an integer of at most 32 bits.  The multiplier
+// is odd, so the high word of the product depends on every bit of the
+// key; it is 2^64 divided by the golden ratio.
+KOKKOS_FORCEINLINE_FUNCTION
+uint32_t multiply_shift_hash(uint64_t key, uint32_t seed) {
+  return static_cast<uint32_t>(((key ^ seed) * 0x9e3779b97f4a7c15ull) >> 32);
+}
+
+// Hash of a 64 bit integer.  Bits of the product below the lowest bit in
+// which two keys differ are equal, so keys differing only in high bits
+// would share the low bits of any word of it; the product goes through the
+// fmix64 finalizer of MurmurHash3 before it is truncated.
+KOKKOS_FORCEINLINE_FUNCTION
+uint32_t multiply_mix_hash(uint64_t key, uint32_t seed) {
+  uint64_t h = (key ^ seed) * 0x9e3779b97f4a7c15ull;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return static_cast<uint32_t>(h);
+}
+
+// How pod_hash hashes a type: integers and enums by multiplication, types
+// of 16 bytes or more eight bytes at a time, others byte-wise
+enum { pod_hash_bytes = 0, pod_hash_integer = 1, pod_hash_wide = 2 };
+
+template <typename T>
+struct pod_hash_kind
+    : public std::integral_constant<
+          int, ((std::is_integral<T>::value || std::is_enum<T>::value) &&
+                sizeof(T) <= sizeof(uint64_t))
+                   ? pod_hash_integer
+                   : (16 <= sizeof(T) ? pod_hash_wide : pod_hash_bytes)> {};
+
+template <typename T, int Kind = pod_hash_kind<T>::value>
+struct PodHash {
+  KOKKOS_FORCEINLINE_FUNCTION
+  static uint32_t hash(T const& t, uint32_t seed) {
+    return MurmurHash3_x86_32(&t, sizeof(T), seed);
+  }
+};
+
+template <typename T>
+struct PodHash<T, pod_hash_integer> {
+  KOKKOS_FORCEINLINE_FUNCTION
+  static uint32_t hash(T const& t, uint32_t seed) {
+    return sizeof(T) <= sizeof(uint32_t)
+               ? multiply_shift_hash(static_cast<uint64_t>(t), seed)
+               : multiply_mix_hash(static_cast<uint64_t>(t), seed);
+  }
+};
+
+template <typename T>
+struct PodHash<T, pod_hash_wide> {
+  KOKKOS_FORCEINLINE_FUNCTION
+  static uint32_t hash(T const& t, uint32_t seed) {
+    return MurmurHash64A(&t, sizeof(T), seed);
+  }
+};
+
 #if defined(__GNUC__) /* GNU C   */ || defined(__GNUG__) /* GNU C++ */ || \
     defined(__clang__)
 
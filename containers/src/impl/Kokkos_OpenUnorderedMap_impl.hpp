@@ -0,0 +1,152 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOS_OPEN_UNORDERED_MAP_IMPL_HPP
+#define KOKKOS_OPEN_UNORDERED_MAP_IMPL_HPP
+
+#include <Kokkos_Macros.hpp>
+#include <impl/Kokkos_BitOps.hpp>
+#include <cstdint>
+
+#if defined(__SSE2__) && !defined(KOKKOS_COMPILER_PGI)
+#include <emmintrin.h>
+#define KOKKOS_IMPL_OPEN_UNORDERED_MAP_SSE2
+#endif
+
+namespace Kokkos {
+namespace Impl {
+
+/// A group of 16 consecutive control bytes of an OpenUnorderedMap.
+///
+/// A control byte is empty, claimed by an insert that is still writing
+/// the key, erased, or holds the low 7 bits of the hash of its key.  The
+/// bytes are stored in 32-bit words, byte j of a word in bits [8j, 8j+8),
+/// so that a single byte can be claimed with a word compare-and-swap.
+/// On host the group is loaded with one 16 byte load and its bytes are
+/// compared at once with SSE2.
+struct OpenUnorderedMapGroup {
+  enum : uint32_t { size = 16, words = size / 4 };
+  enum : uint32_t { empty = 0x80u, erased = 0xfeu, busy = 0xffu };
+  enum : uint32_t { empty_words = 0x80808080u };
+
+#if defined(KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST) && \
+    defined(KOKKOS_IMPL_OPEN_UNORDERED_MAP_SSE2)
+
+  __m128i m_ctrl;
+
+  // Groups are 16 byte aligned in the control word array
+  KOKKOS_FORCEINLINE_FUNCTION
+  explicit OpenUnorderedMapGroup(uint32_t const* const ctrl)
+      : m_ctrl(*reinterpret_cast<__m128i const volatile*>(ctrl)) {}
+
+  /// Bit j is set if control byte j equals 'value'
+  KOKKOS_FORCEINLINE_FUNCTION
+  uint32_t match(const uint32_t value) const {
+    return _mm_movemask_epi8(
+        _mm_cmpeq_epi8(m_ctrl, _mm_set1_epi8(static_cast<char>(value))));
+  }
+
+#else
+
+  uint32_t m_word[words];
+
+  KOKKOS_FORCEINLINE_FUNCTION
+  explicit OpenUnorderedMapGroup(uint32_t const* const ctrl) {
+    for (uint32_t i = 0; i < words; ++i) {
+      m_word[i] = ((uint32_t const volatile*)ctrl)[i];
+    }
+  }
+
+  KOKKOS_FORCEINLINE_FUNCTION
+  uint32_t byte(const uint32_t j) const {
+    return (m_word[j >> 2] >> (8 * (j & 3))) & 0xffu;
+  }
+
+  /// Bit j is set if control byte j equals 'value'
+  KOKKOS_FORCEINLINE_FUNCTION
+  uint32_t match(const uint32_t value) const {
+    uint32_t mask = 0;
+    for (uint32_t j = 0; j < size; ++j) {
+      mask |= uint32_t(byte(j) == value) << j;
+    }
+    return mask;
+  }
+
+#endif
+
+  /// Number of control bytes of a word that hold a key
+  KOKKOS_FORCEINLINE_FUNCTION
+  static int count_full(const uint32_t word) {
+    return bit_count(~word & empty_words);
+  }
+};
+
+template <typename Map>
+struct OpenUnorderedMapSize {
+  typedef Map map_type;
+  typedef typename map_type::execution_space execution_space;
+  typedef typename map_type::size_type size_type;
+  typedef size_type value_type;
+
+  map_type m_map;
+
+  OpenUnorderedMapSize(map_type const& map) : m_map(map) {}
+
+  size_type apply() const {
+    size_type result = 0;
+    parallel_reduce("Kokkos::Impl::OpenUnorderedMapSize::apply",
+                    m_map.m_ctrl.extent(0), *this, result);
+    return result;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(size_type i, value_type& count) const {
+    count += OpenUnorderedMapGroup::count_full(m_map.m_ctrl(i));
+  }
+};
+
+}  // namespace Impl
+}  // namespace Kokkos
+
+#endif  // KOKKOS_OPEN_UNORDERED_MAP_IMPL_HPP
@@ -82,6 +82,206 @@ struct UnorderedMapRehash {
   }
 };
 
+/// Runs one pass of an insert batch, recording the batch indices whose
+/// inserts failed so that only those are run again after the map grew.
+template <typename Map, typename Functor>
+struct UnorderedMapGrowInsert {
+  typedef Map map_type;
+  typedef typename map_type::execution_space execution_space;
+  typedef typename map_type::size_type size_type;
+  typedef View<size_type*, typename map_type::device_type> index_view;
+  typedef View<size_type, typename map_type::device_type> count_view;
+
+  map_type m_map;
+  Functor m_functor;
+  index_view m_pending;  // batch indices of this pass, empty for all
+  index_view m_failed;
+  count_view m_num_failed;
+
+  UnorderedMapGrowInsert(map_type const& map, Functor const& functor,
+                         index_view const& pending, index_view const& failed,
+                         count_view const& num_failed)
+      : m_map(map),
+        m_functor(functor),
+        m_pending(pending),
+        m_failed(failed),
+        m_num_failed(num_failed) {}
+
+  size_type apply(const size_type n) const {
+    Kokkos::deep_copy(m_num_failed, size_type(0));
+    parallel_for("Kokkos::Impl::UnorderedMapGrowInsert::apply",
+                 RangePolicy<execution_space>(0, n), *this);
+    size_type num_failed = 0;
+    Kokkos::deep_copy(num_failed, m_num_failed);
+    return num_failed;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(size_type i) const {
+    const size_type j = m_pending.extent(0) ? m_pending(i) : i;
+    // Once the map is full inserts fail only after searching all of it,
+    // so the rest of the pass is deferred to the grown map
+    if (m_map.m_scalars((int)map_type::failed_insert_idx) ||
+        !m_functor(m_map, j)) {
+      m_failed(atomic_fetch_add(&m_num_failed(), size_type(1))) = j;
+    }
+  }
+};
+
+/// Orders a batch of keys by the hash list each key falls into, with a
+/// counting sort over bins of consecutive hash lists, so that a bulk
+/// operation walks the table in order.  The bins are few enough for
+/// their counters to stay in cache, and the keys are copied in bin order
+/// so that the bulk operation also reads them in order.
+template <typename Map, typename KeysView>
+struct UnorderedMapBinKeys {
+  typedef Map map_type;
+  typedef typename map_type::execution_space execution_space;
+  typedef typename map_type::size_type size_type;
+  typedef typename map_type::key_type key_type;
+  typedef View<size_type*, typename map_type::device_type> index_view;
+  typedef View<key_type*, typename map_type::device_type> key_view;
+  typedef size_type value_type;
+
+  enum : size_type { max_bins = 1024 };
+
+  struct CountTag {};
+  struct ScanTag {};
+  struct ScatterTag {};
+
+  map_type m_map;
+  KeysView m_keys;
+  size_type m_num_bins;
+  index_view m_bins;
+  index_view m_offsets;
+  index_view m_permute;
+  key_view m_sorted_keys;
+
+  UnorderedMapBinKeys(map_type const& map, KeysView const& keys)
+      : m_map(map),
+        m_keys(keys),
+        m_num_bins(map.hash_capacity() < size_type(max_bins)
+                       ? map.hash_capacity()
+                       : size_type(max_bins)),
+        m_bins(ViewAllocateWithoutInitializing("UnorderedMap bins"),
+               keys.extent(0)),
+        m_offsets("UnorderedMap bin offsets", m_num_bins + 1),
+        m_permute(ViewAllocateWithoutInitializing("UnorderedMap permute"),
+                  keys.extent(0)),
+        m_sorted_keys(ViewAllocateWithoutInitializing("UnorderedMap keys"),
+                      keys.extent(0)) {}
+
+  void apply() const {
+    const size_type n = m_keys.extent(0);
+    parallel_for("Kokkos::Impl::UnorderedMapBinKeys::count",
+                 RangePolicy<execution_space, CountTag>(0, n), *this);
+    parallel_scan("Kokkos::Impl::UnorderedMapBinKeys::scan",
+                  RangePolicy<execution_space, ScanTag>(0, m_num_bins + 1),
+                  *this);
+    parallel_for("Kokkos::Impl::UnorderedMapBinKeys::scatter",
+                 RangePolicy<execution_space, ScatterTag>(0, n), *this);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(CountTag, size_type i) const {
+    const size_type hash_list =
+        m_map.m_hasher(m_keys(i)) % m_map.hash_capacity();
+    const size_type bin = static_cast<size_type>(
+        (uint64_t(hash_list) * m_num_bins) / m_map.hash_capacity());
+    m_bins(i) = bin;
+    atomic_increment(&m_offsets(bin));
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(ScanTag, size_type i, value_type& update,
+                  const bool final) const {
+    const size_type count = m_offsets(i);
+    if (final) m_offsets(i) = update;
+    update += count;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(ScatterTag, size_type i) const {
+    const size_type p =
+        atomic_fetch_add(&m_offsets(m_bins(i)), size_type(1));
+    m_permute(p)     = i;
+    m_sorted_keys(p) = m_keys(i);
+  }
+};
+
+template <typename Map, typename KeysView, typename ValuesView,
+          typename ResultsView>
+struct UnorderedMapBulkInsert {
+  typedef Map map_type;
+  typedef typename map_type::execution_space execution_space;
+  typedef typename map_type::size_type size_type;
+  typedef UnorderedMapBinKeys<map_type, KeysView> bin_type;
+
+  map_type m_map;
+  bin_type m_sorted;
+  ValuesView m_values;
+  ResultsView m_results;
+
+  UnorderedMapBulkInsert(map_type const& map, KeysView const& keys,
+                         ValuesView const& values, ResultsView const& results)
+      : m_map(map), m_sorted(map, keys), m_values(values), m_results(results) {}
+
+  void apply() const {
+    m_sorted.apply();
+    parallel_for("Kokkos::Impl::UnorderedMapBulkInsert::apply",
+                 RangePolicy<execution_space>(0, m_sorted.m_keys.extent(0)),
+                 *this);
+  }
+
+  // A set has no values to read
+  KOKKOS_INLINE_FUNCTION
+  typename map_type::insert_result insert(size_type p, size_type,
+                                          std::true_type) const {
+    return m_map.insert(m_sorted.m_sorted_keys(p));
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  typename map_type::insert_result insert(size_type p, size_type i,
+                                          std::false_type) const {
+    return m_map.insert(m_sorted.m_sorted_keys(p), m_values(i));
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(size_type p) const {
+    const size_type i = m_sorted.m_permute(p);
+    m_results(i) =
+        insert(p, i, std::integral_constant<bool, map_type::is_set>());
+  }
+};
+
+template <typename Map, typename KeysView, typename IndicesView>
+struct UnorderedMapBulkFind {
+  typedef Map map_type;
+  typedef typename map_type::execution_space execution_space;
+  typedef typename map_type::size_type size_type;
+  typedef UnorderedMapBinKeys<map_type, KeysView> bin_type;
+
+  map_type m_map;
+  bin_type m_sorted;
+  IndicesView m_indices;
+
+  UnorderedMapBulkFind(map_type const& map, KeysView const& keys,
+                       IndicesView const& indices)
+      : m_map(map), m_sorted(map, keys), m_indices(indices) {}
+
+  void apply() const {
+    m_sorted.apply();
+    parallel_for("Kokkos::Impl::UnorderedMapBulkFind::apply",
+                 RangePolicy<execution_space>(0, m_sorted.m_keys.extent(0)),
+                 *this);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(size_type p) const {
+    m_indices(m_sorted.m_permute(p)) = m_map.find(m_sorted.m_sorted_keys(p));
+  }
+};
+
 template <typename UMap>
 struct UnorderedMapErase {
   typedef UMap map_type;
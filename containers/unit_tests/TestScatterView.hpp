@@ -421,6 +421,45 @@ struct TestDuplicatedScatterView {
         Kokkos::Experimental::ScatterNonAtomic, ScatterType>
         test_sv_left_config;
     test_sv_left_config.run_test(n);
+    test_scatter_view_config<DeviceType, Kokkos::LayoutRight,
+                             Kokkos::Experimental::ScatterSparseDuplicated,
+                             Kokkos::Experimental::ScatterNonAtomic,
+                             ScatterType>
+        test_sv_sparse_right_config;
+    test_sv_sparse_right_config.run_test(n);
+    test_scatter_view_config<DeviceType, Kokkos::LayoutLeft,
+                             Kokkos::Experimental::ScatterSparseDuplicated,
+                             Kokkos::Experimental::ScatterNonAtomic,
+                             ScatterType>
+        test_sv_sparse_left_config;
+    test_sv_sparse_left_config.run_test(n);
+    // a pool of a single tile sends all but the first claimed tile to the
+    // atomic fallback on the original view
+    {
+      typedef test_scatter_view_impl_cls<
+          DeviceType, Kokkos::LayoutRight,
+          Kokkos::Experimental::ScatterSparseDuplicated,
+          Kokkos::Experimental::ScatterNonAtomic, ScatterType>
+          test_impl_type;
+      typename test_impl_type::orig_view_type original_view("original_view",
+                                                            n);
+      typename test_impl_type::scatter_view_type scatter_view(original_view,
+                                                              1);
+      EXPECT_EQ(scatter_view.tile_capacity(), 1u);
+      test_impl_type scatter_view_test_impl(scatter_view);
+      scatter_view_test_impl.initialize(original_view);
+      scatter_view_test_impl.run_parallel(n);
+
+      Kokkos::Experimental::contribute(original_view, scatter_view);
+      scatter_view.reset_except(original_view);
+
+      scatter_view_test_impl.run_parallel(n);
+
+      Kokkos::Experimental::contribute(original_view, scatter_view);
+      Kokkos::fence();
+
+      scatter_view_test_impl.validateResults(original_view);
+    }
   }
 };
 
@@ -45,7 +45,9 @@
 
 #include <gtest/gtest.h>
 #include <iostream>
+#include <vector>
 #include <Kokkos_UnorderedMap.hpp>
+#include <Kokkos_OpenUnorderedMap.hpp>
 
 namespace Test {
 
@@ -172,6 +174,24 @@ struct TestFind {
   }
 };
 
+// Inserts the 'edges' of item i, keys shared with neighbouring items
+template <typename MapType>
+struct TestGrowInsert {
+  typedef MapType map_type;
+  typedef typename map_type::size_type size_type;
+
+  uint32_t edges;
+
+  KOKKOS_INLINE_FUNCTION
+  bool operator()(map_type const &map, size_type i) const {
+    bool success = true;
+    for (uint32_t e = 0; e < edges; ++e) {
+      if (map.insert(i + e, i).failed()) success = false;
+    }
+    return success;
+  }
+};
+
 }  // namespace Impl
 
 // MSVC reports a syntax error for this test.
@@ -295,6 +315,223 @@ void test_deep_copy(uint32_t num_nodes) {
   }
 }
 
+template <typename Device>
+void test_grow_insert(uint32_t initial_capacity, uint32_t num_items,
+                      uint32_t edges) {
+  typedef Kokkos::UnorderedMap<uint32_t, uint32_t, Device> map_type;
+  typedef Kokkos::UnorderedMap<const uint32_t, const uint32_t, Device>
+      const_map_type;
+
+  map_type map(initial_capacity);
+  const uint32_t initial = map.capacity();
+
+  map.grow_insert(num_items, Impl::TestGrowInsert<map_type>{edges});
+
+  const uint32_t num_keys = num_items + edges - 1u;
+
+  ASSERT_FALSE(map.failed_insert());
+  EXPECT_EQ(num_keys, map.size());
+  EXPECT_LE(map.size(), 0.8 * map.capacity());
+  if (0.8 * initial < num_keys) {
+    EXPECT_LT(initial, map.capacity());
+  }
+
+  {
+    uint32_t find_errors = 0;
+    Impl::TestFind<const_map_type> test_find(map, num_keys, 1);
+    test_find.testit(find_errors);
+    EXPECT_EQ(0u, find_errors);
+  }
+}
+
+template <typename Device>
+void test_bulk_insert(uint32_t num_inserts, uint32_t num_duplicates) {
+  typedef Kokkos::UnorderedMap<uint32_t, uint32_t, Device> map_type;
+  typedef Kokkos::View<uint32_t *, Device> key_view;
+  typedef Kokkos::View<typename map_type::insert_result *, Device>
+      result_view;
+
+  const uint32_t num_keys = num_inserts / num_duplicates;
+
+  key_view keys("keys", num_inserts);
+  key_view values("values", num_inserts);
+  result_view results("results", num_inserts);
+
+  typename key_view::HostMirror h_keys = Kokkos::create_mirror_view(keys);
+  typename key_view::HostMirror h_values = Kokkos::create_mirror_view(values);
+  for (uint32_t i = 0; i < num_inserts; ++i) {
+    h_keys(i)   = (i % num_keys) * 7u;
+    h_values(i) = i % num_keys;
+  }
+  Kokkos::deep_copy(keys, h_keys);
+  Kokkos::deep_copy(values, h_values);
+
+  map_type map(num_keys);
+  map.insert(keys, values, results);
+
+  ASSERT_FALSE(map.failed_insert());
+  EXPECT_EQ(num_keys, map.size());
+
+  typename result_view::HostMirror h_results =
+      Kokkos::create_mirror_view(results);
+  Kokkos::deep_copy(h_results, results);
+  uint32_t num_success = 0;
+  for (uint32_t i = 0; i < num_inserts; ++i) {
+    EXPECT_FALSE(h_results(i).failed());
+    if (h_results(i).success()) ++num_success;
+  }
+  EXPECT_EQ(num_keys, num_success);
+
+  // Find the inserted keys and keys that are not in the map
+  key_view find_keys("find_keys", 2u * num_keys);
+  key_view indices("indices", 2u * num_keys);
+  typename key_view::HostMirror h_find_keys =
+      Kokkos::create_mirror_view(find_keys);
+  for (uint32_t i = 0; i < 2u * num_keys; ++i) h_find_keys(i) = i * 7u;
+  Kokkos::deep_copy(find_keys, h_find_keys);
+
+  map.find(find_keys, indices);
+
+  typename map_type::HostMirror h_map;
+  Kokkos::deep_copy(h_map, map);
+  typename key_view::HostMirror h_indices = Kokkos::create_mirror_view(indices);
+  Kokkos::deep_copy(h_indices, indices);
+  for (uint32_t i = 0; i < 2u * num_keys; ++i) {
+    if (i < num_keys) {
+      ASSERT_TRUE(h_map.valid_at(h_indices(i)));
+      EXPECT_EQ(i * 7u, h_map.key_at(h_indices(i)));
+      EXPECT_EQ(i, h_map.value_at(h_indices(i)));
+    } else {
+      EXPECT_FALSE(h_map.valid_at(h_indices(i)));
+    }
+  }
+}
+
+template <typename Device>
+void test_open_insert(uint32_t num_nodes, uint32_t num_inserts,
+                      uint32_t num_duplicates, bool near) {
+  typedef Kokkos::Experimental::OpenUnorderedMap<uint32_t, uint32_t, Device>
+      map_type;
+  typedef Kokkos::Experimental::OpenUnorderedMap<const uint32_t,
+                                                 const uint32_t, Device>
+      const_map_type;
+
+  const uint32_t expected_inserts =
+      (num_inserts + num_duplicates - 1u) / num_duplicates;
+
+  map_type map(num_nodes);
+
+  if (near) {
+    Impl::TestInsert<map_type, true> test_insert(map, num_inserts,
+                                                 num_duplicates);
+    test_insert.testit();
+  } else {
+    Impl::TestInsert<map_type, false> test_insert(map, num_inserts,
+                                                  num_duplicates);
+    test_insert.testit();
+  }
+
+  ASSERT_FALSE(map.failed_insert());
+  EXPECT_EQ(expected_inserts, map.size());
+
+  {
+    uint32_t find_errors = 0;
+    Impl::TestFind<const_map_type> test_find(map, num_inserts, num_duplicates);
+    test_find.testit(find_errors);
+    EXPECT_EQ(0u, find_errors);
+  }
+
+  map.begin_erase();
+  if (near) {
+    Impl::TestErase<map_type, true> test_erase(map, num_inserts,
+                                               num_duplicates);
+    test_erase.testit();
+  } else {
+    Impl::TestErase<map_type, false> test_erase(map, num_inserts,
+                                                num_duplicates);
+    test_erase.testit();
+  }
+  map.end_erase();
+  EXPECT_EQ(0u, map.size());
+
+  // Erased slots are dropped by a rehash
+  map.rehash(num_nodes);
+  {
+    Impl::TestInsert<map_type> test_insert(map, num_inserts, num_duplicates);
+    test_insert.testit();
+  }
+  EXPECT_EQ(expected_inserts, map.size());
+}
+
+template <typename Device>
+void test_open_failed_insert(uint32_t num_nodes) {
+  typedef Kokkos::Experimental::OpenUnorderedMap<uint32_t, uint32_t, Device>
+      map_type;
+
+  map_type map(num_nodes);
+  Impl::TestInsert<map_type> test_insert(map, 2u * map.capacity(), 1u);
+  test_insert.testit(false /*don't rehash on fail*/);
+  typename Device::execution_space().fence();
+
+  EXPECT_TRUE(map.failed_insert());
+  EXPECT_EQ(map.capacity(), map.size());
+
+  const uint32_t num_keys = 2u * map.capacity();
+  map.rehash(num_keys);
+  EXPECT_FALSE(map.failed_insert());
+
+  Impl::TestInsert<map_type> test_reinsert(map, num_keys, 1u);
+  test_reinsert.testit(false);
+  EXPECT_FALSE(map.failed_insert());
+  EXPECT_EQ(num_keys, map.size());
+}
+
+template <typename Device>
+void test_open_deep_copy(uint32_t num_nodes) {
+  typedef Kokkos::Experimental::OpenUnorderedMap<uint32_t, uint32_t, Device>
+      map_type;
+  typedef Kokkos::Experimental::OpenUnorderedMap<const uint32_t,
+                                                 const uint32_t, Device>
+      const_map_type;
+
+  typedef typename map_type::HostMirror host_map_type;
+
+  map_type map(num_nodes);
+
+  {
+    Impl::TestInsert<map_type> test_insert(map, num_nodes, 1);
+    test_insert.testit();
+    ASSERT_EQ(map.size(), num_nodes);
+    ASSERT_FALSE(map.failed_insert());
+  }
+
+  host_map_type hmap;
+  Kokkos::Experimental::deep_copy(hmap, map);
+
+  ASSERT_EQ(map.size(), hmap.size());
+  ASSERT_EQ(map.capacity(), hmap.capacity());
+  {
+    uint32_t find_errors = 0;
+    Impl::TestFind<host_map_type> test_find(hmap, num_nodes, 1);
+    test_find.testit(find_errors);
+    EXPECT_EQ(find_errors, 0u);
+  }
+
+  map_type mmap;
+  Kokkos::Experimental::deep_copy(mmap, hmap);
+
+  const_map_type cmap = mmap;
+
+  EXPECT_EQ(cmap.size(), num_nodes);
+
+  {
+    uint32_t find_errors = 0;
+    Impl::TestFind<const_map_type> test_find(cmap, num_nodes, 1);
+    test_find.testit(find_errors);
+    EXPECT_EQ(find_errors, 0u);
+  }
+}
+
 // FIXME_HIP deadlock
 #ifndef KOKKOS_ENABLE_HIP
 // WORKAROUND MSVC
@@ -314,8 +551,104 @@ TEST(TEST_CATEGORY, UnorderedMap_failed_insert) {
 TEST(TEST_CATEGORY, UnorderedMap_deep_copy) {
   for (int i = 0; i < 2; ++i) test_deep_copy<TEST_EXECSPACE>(10000);
 }
+
+TEST(TEST_CATEGORY, UnorderedMap_grow_insert) {
+  test_grow_insert<TEST_EXECSPACE>(0, 100000, 4);
+  test_grow_insert<TEST_EXECSPACE>(1000, 100000, 1);
+  test_grow_insert<TEST_EXECSPACE>(200000, 100000, 8);
+}
+
+TEST(TEST_CATEGORY, UnorderedMap_bulk_insert) {
+  test_bulk_insert<TEST_EXECSPACE>(100000, 1);
+  test_bulk_insert<TEST_EXECSPACE>(100000, 10);
+}
+
+TEST(TEST_CATEGORY, OpenUnorderedMap_insert) {
+  for (int i = 0; i < 100; ++i) {
+    test_open_insert<TEST_EXECSPACE>(100000, 90000, 100, true);
+    test_open_insert<TEST_EXECSPACE>(100000, 90000, 100, false);
+  }
+}
+
+TEST(TEST_CATEGORY, OpenUnorderedMap_failed_insert) {
+  for (int i = 0; i < 10; ++i) test_open_failed_insert<TEST_EXECSPACE>(10000);
+}
+
+TEST(TEST_CATEGORY, OpenUnorderedMap_deep_copy) {
+  for (int i = 0; i < 2; ++i) test_open_deep_copy<TEST_EXECSPACE>(10000);
+}
 #endif
 
+namespace Impl {
+
+// No padding, whose bytes the hash would read
+struct TestPodHashWide {
+  uint64_t a, b, c;
+};
+
+template <typename T>
+void test_pod_hash_batch(std::vector<T> const &keys) {
+  Kokkos::pod_hash<T> hash;
+  std::vector<uint32_t> hashes(keys.size());
+
+  hash.batch(keys.data(), hashes.data(), keys.size(), 7u);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(hash(keys[i], 7u), hashes[i]);
+  }
+}
+
+}  // namespace Impl
+
+TEST(TEST_CATEGORY, UnorderedMap_pod_hash) {
+  using Kokkos::Impl::pod_hash_bytes;
+  using Kokkos::Impl::pod_hash_integer;
+  using Kokkos::Impl::pod_hash_kind;
+  using Kokkos::Impl::pod_hash_wide;
+  static_assert(pod_hash_kind<uint32_t>::value == pod_hash_integer, "");
+  static_assert(pod_hash_kind<int64_t>::value == pod_hash_integer, "");
+  static_assert(pod_hash_kind<Impl::TestPodHashWide>::value == pod_hash_wide,
+                "");
+  static_assert(pod_hash_kind<double>::value == pod_hash_bytes, "");
+
+  std::vector<uint32_t> keys32;
+  std::vector<int64_t> keys64;
+  std::vector<Impl::TestPodHashWide> keys_wide;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    keys32.push_back(i);
+    keys64.push_back(-int64_t(i) << 32);
+    keys_wide.push_back(Impl::TestPodHashWide{i, ~uint64_t(i), 3u * i});
+  }
+  Impl::test_pod_hash_batch(keys32);
+  Impl::test_pod_hash_batch(keys64);
+  Impl::test_pod_hash_batch(keys_wide);
+
+  // Keys that differ only above bit 40 have distinct low bits, which pick
+  // the bucket when the bucket count is a power of two
+  Kokkos::pod_hash<uint64_t> hash_u64;
+  const uint32_t low_mask = 127;
+  std::vector<int> buckets_low(low_mask + 1, 0);
+  for (uint64_t i = 0; i < 1000; ++i) {
+    ++buckets_low[hash_u64(i << 40) & low_mask];
+  }
+  for (uint32_t i = 0; i <= low_mask; ++i) EXPECT_LT(buckets_low[i], 30);
+
+  // Keys that differ only in high bits, or in their last bytes, spread
+  // over the buckets of a map
+  Kokkos::pod_hash<int64_t> hash64;
+  Kokkos::pod_hash<Impl::TestPodHashWide> hash_wide;
+  const uint32_t num_buckets = 97;
+  std::vector<int> buckets64(num_buckets, 0), buckets_wide(num_buckets, 0);
+  for (size_t i = 0; i < keys64.size(); ++i) {
+    ++buckets64[hash64(keys64[i]) % num_buckets];
+    Impl::TestPodHashWide key = {0, 0, uint64_t(i)};
+    ++buckets_wide[hash_wide(key) % num_buckets];
+  }
+  for (uint32_t i = 0; i < num_buckets; ++i) {
+    EXPECT_LT(buckets64[i], 30);
+    EXPECT_LT(buckets_wide[i], 30);
+  }
+}
+
 TEST(TEST_CATEGORY, UnorderedMap_valid_empty) {
   using Key   = int;
   using Value = int;
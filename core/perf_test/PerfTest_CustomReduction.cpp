@@ -124,6 +124,39 @@ void custom_reduction_test(int N, int R, int num_trials) {
          max);
 }
 
+// Many short reductions, so that the time is dominated by combining the
+// contributions of the threads rather than by the loop body.
+template <class Scalar>
+void custom_reduction_combine_test(int N, int num_trials) {
+  Kokkos::Random_XorShift64_Pool<> rand_pool(183291);
+  Kokkos::View<Scalar*> a("A", N);
+  Kokkos::fill_random(a, rand_pool, 1.0);
+
+  Scalar max;
+
+  // Warm up
+  Kokkos::parallel_reduce(
+      N,
+      KOKKOS_LAMBDA(const int& i, Scalar& lmax) {
+        if (a(i) > lmax) lmax = a(i);
+      },
+      Kokkos::Max<Scalar>(max));
+
+  // Timing
+  Kokkos::Timer timer;
+  for (int r = 0; r < num_trials; r++) {
+    Kokkos::parallel_reduce(
+        N,
+        KOKKOS_LAMBDA(const int& i, Scalar& lmax) {
+          if (a(i) > lmax) lmax = a(i);
+        },
+        Kokkos::Max<Scalar>(max));
+  }
+  double time = timer.seconds();
+  printf("%d %e %e %e\n", Kokkos::DefaultExecutionSpace::concurrency(), time,
+         1.0e6 * time / num_trials, max);
+}
+
 TEST(default_exec, custom_reduction) {
   int N          = 100000;
   int R          = 1000;
@@ -134,5 +167,14 @@ TEST(default_exec, custom_reduction) {
   if (command_line_num_args() > 3) num_trials = std::stoi(command_line_arg(3));
   custom_reduction_test<double>(N, R, num_trials);
 }
+
+TEST(default_exec, custom_reduction_combine) {
+  int N          = 4096;
+  int num_trials = 10000;
+
+  if (command_line_num_args() > 1) N = std::stoi(command_line_arg(1));
+  if (command_line_num_args() > 3) num_trials = std::stoi(command_line_arg(3));
+  custom_reduction_combine_test<double>(N, num_trials);
+}
 }  // namespace Test
 #endif
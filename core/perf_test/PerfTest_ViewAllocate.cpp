@@ -43,6 +43,7 @@
 */
 
 #include <Kokkos_Core.hpp>
+#include <impl/Kokkos_HostSpaceCache.hpp>
 #include <gtest/gtest.h>
 #include <cstdio>
 #include <PerfTest_Category.hpp>
@@ -150,6 +151,39 @@ void run_allocateview_tests(int N, int R) {
          size / 1024 / time8);
 }
 
+template <class Layout>
+double run_small_allocateview(int N, int R) {
+  Kokkos::Timer timer;
+  for (int r = 0; r < R; r++) {
+    Kokkos::View<double**, Layout, Kokkos::HostSpace> a("A", N, N);
+    Kokkos::View<double*, Layout, Kokkos::HostSpace> b("B", N);
+  }
+  return timer.seconds() / R;
+}
+
+TEST(default_exec, ViewCreateSmallCached) {
+  typedef Kokkos::Impl::HostSpaceCache cache;
+
+  const size_t high_water = cache::high_water();
+
+  printf("Create Small View Performance with HostSpaceCache:\n");
+  for (int N : {8, 64, 256}) {
+    cache::set_high_water(0);
+    const double time_uncached =
+        run_small_allocateview<Kokkos::LayoutRight>(N, 1000);
+    cache::set_high_water(size_t(64) << 20);
+    const cache::Statistics before = cache::statistics();
+    const double time_cached =
+        run_small_allocateview<Kokkos::LayoutRight>(N, 1000);
+    const cache::Statistics after = cache::statistics();
+    printf("   N=%3d: uncached %lf s   cached %lf s   hits %lu misses %lu\n",
+           N, time_uncached, time_cached,
+           (unsigned long)(after.hits - before.hits),
+           (unsigned long)(after.misses - before.misses));
+  }
+  cache::set_high_water(high_water);
+}
+
 TEST(default_exec, ViewCreate) {
   printf("Create View Performance for LayoutLeft:\n");
   run_allocateview_tests<Kokkos::LayoutLeft>(10, 1);
@@ -60,6 +60,20 @@ double fill_view(ViewType& a, typename ViewType::const_value_type& val,
   return timer.seconds();
 }
 
+// The element-wise ViewFill over the whole span, as a baseline for deep_copy
+template <class ViewType>
+double fill_view_flat(ViewType& a, typename ViewType::const_value_type& val,
+                      int repeat) {
+  typedef typename ViewType::execution_space exec_space;
+  Kokkos::Timer timer;
+  for (int i = 0; i < repeat; i++) {
+    Kokkos::Impl::ViewFill<ViewType, Kokkos::LayoutRight, exec_space, 1,
+                           int64_t>(a, val, exec_space());
+  }
+  Kokkos::fence();
+  return timer.seconds();
+}
+
 template <class Layout>
 void run_fillview_tests123(int N, int R) {
   const int N1 = N;
@@ -69,17 +83,25 @@ void run_fillview_tests123(int N, int R) {
   const int N8 = N4 * N4;
 
   double time1, time2, time3, time_raw = 100000.0;
+  double time1_zero, time2_zero, time3_zero, time_flat;
   {
     Kokkos::View<double*, Layout> a("A1", N8);
-    time1 = fill_view(a, 1.1, R) / R;
+    time1      = fill_view(a, 1.1, R) / R;
+    time1_zero = fill_view(a, 0.0, R) / R;
   }
   {
     Kokkos::View<double**, Layout> a("A2", N4, N4);
-    time2 = fill_view(a, 1.1, R) / R;
+    time2      = fill_view(a, 1.1, R) / R;
+    time2_zero = fill_view(a, 0.0, R) / R;
   }
   {
     Kokkos::View<double***, Layout> a("A3", N3, N3, N2);
-    time3 = fill_view(a, 1.1, R) / R;
+    time3      = fill_view(a, 1.1, R) / R;
+    time3_zero = fill_view(a, 0.0, R) / R;
+  }
+  {
+    Kokkos::View<double*, Layout> a("A1", N8);
+    time_flat = fill_view_flat(a, 1.1, R) / R;
   }
 #if defined(KOKKOS_ENABLE_CUDA_LAMBDA) || !defined(KOKKOS_ENABLE_CUDA)
   {
@@ -97,12 +119,20 @@ void run_fillview_tests123(int N, int R) {
   double size = 1.0 * N8 * 8 / 1024 / 1024;
   printf("   Raw:   %lf s   %lf MB   %lf GB/s\n", time_raw, size,
          size / 1024 / time_raw);
+  printf("   Flat:  %lf s   %lf MB   %lf GB/s\n", time_flat, size,
+         size / 1024 / time_flat);
   printf("   Rank1: %lf s   %lf MB   %lf GB/s\n", time1, size,
          size / 1024 / time1);
+  printf("   Zero1: %lf s   %lf MB   %lf GB/s\n", time1_zero, size,
+         size / 1024 / time1_zero);
   printf("   Rank2: %lf s   %lf MB   %lf GB/s\n", time2, size,
          size / 1024 / time2);
+  printf("   Zero2: %lf s   %lf MB   %lf GB/s\n", time2_zero, size,
+         size / 1024 / time2_zero);
   printf("   Rank3: %lf s   %lf MB   %lf GB/s\n", time3, size,
          size / 1024 / time3);
+  printf("   Zero3: %lf s   %lf MB   %lf GB/s\n", time3_zero, size,
+         size / 1024 / time3_zero);
 }
 
 template <class Layout>
@@ -113,13 +143,20 @@ void run_fillview_tests45(int N, int R) {
   const int N8 = N4 * N4;
 
   double time4, time5, time_raw = 100000.0;
+  double time4_zero, time5_zero, time_flat;
   {
     Kokkos::View<double****, Layout> a("A4", N2, N2, N2, N2);
-    time4 = fill_view(a, 1.1, R) / R;
+    time4      = fill_view(a, 1.1, R) / R;
+    time4_zero = fill_view(a, 0.0, R) / R;
   }
   {
     Kokkos::View<double*****, Layout> a("A5", N2, N2, N1, N1, N2);
-    time5 = fill_view(a, 1.1, R) / R;
+    time5      = fill_view(a, 1.1, R) / R;
+    time5_zero = fill_view(a, 0.0, R) / R;
+  }
+  {
+    Kokkos::View<double*, Layout> a("A1", N8);
+    time_flat = fill_view_flat(a, 1.1, R) / R;
   }
 #if defined(KOKKOS_ENABLE_CUDA_LAMBDA) || !defined(KOKKOS_ENABLE_CUDA)
   {
@@ -137,10 +174,16 @@ void run_fillview_tests45(int N, int R) {
   double size = 1.0 * N8 * 8 / 1024 / 1024;
   printf("   Raw:   %lf s   %lf MB   %lf GB/s\n", time_raw, size,
          size / 1024 / time_raw);
+  printf("   Flat:  %lf s   %lf MB   %lf GB/s\n", time_flat, size,
+         size / 1024 / time_flat);
   printf("   Rank4: %lf s   %lf MB   %lf GB/s\n", time4, size,
          size / 1024 / time4);
+  printf("   Zero4: %lf s   %lf MB   %lf GB/s\n", time4_zero, size,
+         size / 1024 / time4_zero);
   printf("   Rank5: %lf s   %lf MB   %lf GB/s\n", time5, size,
          size / 1024 / time5);
+  printf("   Zero5: %lf s   %lf MB   %lf GB/s\n", time5_zero, size,
+         size / 1024 / time5_zero);
 }
 
 template <class Layout>
@@ -151,9 +194,15 @@ void run_fillview_tests6(int N, int R) {
   const int N8 = N4 * N4;
 
   double time6, time_raw = 100000.0;
+  double time6_zero, time_flat;
   {
     Kokkos::View<double******, Layout> a("A6", N2, N1, N1, N1, N1, N2);
-    time6 = fill_view(a, 1.1, R) / R;
+    time6      = fill_view(a, 1.1, R) / R;
+    time6_zero = fill_view(a, 0.0, R) / R;
+  }
+  {
+    Kokkos::View<double*, Layout> a("A1", N8);
+    time_flat = fill_view_flat(a, 1.1, R) / R;
   }
 #if defined(KOKKOS_ENABLE_CUDA_LAMBDA) || !defined(KOKKOS_ENABLE_CUDA)
   {
@@ -171,8 +220,12 @@ void run_fillview_tests6(int N, int R) {
   double size = 1.0 * N8 * 8 / 1024 / 1024;
   printf("   Raw:   %lf s   %lf MB   %lf GB/s\n", time_raw, size,
          size / 1024 / time_raw);
+  printf("   Flat:  %lf s   %lf MB   %lf GB/s\n", time_flat, size,
+         size / 1024 / time_flat);
   printf("   Rank6: %lf s   %lf MB   %lf GB/s\n", time6, size,
          size / 1024 / time6);
+  printf("   Zero6: %lf s   %lf MB   %lf GB/s\n", time6_zero, size,
+         size / 1024 / time6_zero);
 }
 
 template <class Layout>
@@ -183,9 +236,15 @@ void run_fillview_tests7(int N, int R) {
   const int N8 = N4 * N4;
 
   double time7, time_raw = 100000.0;
+  double time7_zero, time_flat;
   {
     Kokkos::View<double*******, Layout> a("A7", N2, N1, N1, N1, N1, N1, N1);
-    time7 = fill_view(a, 1.1, R) / R;
+    time7      = fill_view(a, 1.1, R) / R;
+    time7_zero = fill_view(a, 0.0, R) / R;
+  }
+  {
+    Kokkos::View<double*, Layout> a("A1", N8);
+    time_flat = fill_view_flat(a, 1.1, R) / R;
   }
 #if defined(KOKKOS_ENABLE_CUDA_LAMBDA) || !defined(KOKKOS_ENABLE_CUDA)
   {
@@ -203,8 +262,12 @@ void run_fillview_tests7(int N, int R) {
   double size = 1.0 * N8 * 8 / 1024 / 1024;
   printf("   Raw:   %lf s   %lf MB   %lf GB/s\n", time_raw, size,
          size / 1024 / time_raw);
+  printf("   Flat:  %lf s   %lf MB   %lf GB/s\n", time_flat, size,
+         size / 1024 / time_flat);
   printf("   Rank7: %lf s   %lf MB   %lf GB/s\n", time7, size,
          size / 1024 / time7);
+  printf("   Zero7: %lf s   %lf MB   %lf GB/s\n", time7_zero, size,
+         size / 1024 / time7_zero);
 }
 
 template <class Layout>
@@ -215,10 +278,16 @@ void run_fillview_tests8(int N, int R) {
   const int N8 = N4 * N4;
 
   double time8, time_raw = 100000.0;
+  double time8_zero, time_flat;
   {
     Kokkos::View<double********, Layout> a("A8", N1, N1, N1, N1, N1, N1, N1,
                                            N1);
-    time8 = fill_view(a, 1.1, R) / R;
+    time8      = fill_view(a, 1.1, R) / R;
+    time8_zero = fill_view(a, 0.0, R) / R;
+  }
+  {
+    Kokkos::View<double*, Layout> a("A1", N8);
+    time_flat = fill_view_flat(a, 1.1, R) / R;
   }
 #if defined(KOKKOS_ENABLE_CUDA_LAMBDA) || !defined(KOKKOS_ENABLE_CUDA)
   {
@@ -236,8 +305,12 @@ void run_fillview_tests8(int N, int R) {
   double size = 1.0 * N8 * 8 / 1024 / 1024;
   printf("   Raw:   %lf s   %lf MB   %lf GB/s\n", time_raw, size,
          size / 1024 / time_raw);
+  printf("   Flat:  %lf s   %lf MB   %lf GB/s\n", time_flat, size,
+         size / 1024 / time_flat);
   printf("   Rank8: %lf s   %lf MB   %lf GB/s\n", time8, size,
          size / 1024 / time8);
+  printf("   Zero8: %lf s   %lf MB   %lf GB/s\n", time8_zero, size,
+         size / 1024 / time8_zero);
 }
 
 }  // namespace Test
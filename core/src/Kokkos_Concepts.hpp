@@ -58,12 +58,18 @@ namespace Kokkos {
 // Schedules for Execution Policies
 struct Static {};
 struct Dynamic {};
+// Chunks shrinking as the remaining work drains
+struct Guided {};
+// Chunk size tuned from timings of earlier launches of the same kernel
+struct Adaptive {};
 
 // Schedule Wrapper Type
 template <class T>
 struct Schedule {
   static_assert(std::is_same<T, Static>::value ||
-                    std::is_same<T, Dynamic>::value,
+                    std::is_same<T, Dynamic>::value ||
+                    std::is_same<T, Guided>::value ||
+                    std::is_same<T, Adaptive>::value,
                 "Kokkos: Invalid Schedule<> type.");
   using schedule_type = Schedule;
   using type          = T;
@@ -1488,6 +1488,29 @@ struct ViewRemap<DstType, SrcType, ExecSpace, 8> {
   }
 };
 
+/* Contiguous HostSpace views of trivially copyable values are filled by the
+ * host fill engine, returns false if the generic ViewFill has to be used */
+template <class ViewType>
+typename std::enable_if<
+    std::is_same<typename ViewType::memory_space, Kokkos::HostSpace>::value &&
+        std::is_trivially_copyable<typename ViewType::value_type>::value,
+    bool>::type
+view_fill_host_space(const ViewType& dst,
+                     typename ViewType::const_value_type& value) {
+  hostspace_parallel_fill(dst.data(), &value,
+                          sizeof(typename ViewType::value_type), dst.size());
+  return true;
+}
+
+template <class ViewType>
+typename std::enable_if<
+    !(std::is_same<typename ViewType::memory_space, Kokkos::HostSpace>::value &&
+      std::is_trivially_copyable<typename ViewType::value_type>::value),
+    bool>::type
+view_fill_host_space(const ViewType&, typename ViewType::const_value_type&) {
+  return false;
+}
+
 }  // namespace Impl
 
 /** \brief  Deep copy a value from Host memory into a view.  */
@@ -1528,6 +1551,16 @@ inline void deep_copy(
 
   // If contiguous we can simply do a 1D flat loop
   if (dst.span_is_contiguous()) {
+    if (Kokkos::Impl::view_fill_host_space(dst, value)) {
+      Kokkos::fence();
+#if defined(KOKKOS_ENABLE_PROFILING)
+      if (Kokkos::Profiling::profileLibraryLoaded()) {
+        Kokkos::Profiling::endDeepCopy();
+      }
+#endif
+      return;
+    }
+
     typedef Kokkos::View<
         typename ViewType::value_type*, Kokkos::LayoutRight,
         Kokkos::Device<typename ViewType::execution_space,
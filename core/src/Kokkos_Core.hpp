@@ -83,6 +83,7 @@
 #endif
 
 #include <Kokkos_AnonymousSpace.hpp>
+#include <Kokkos_MMapFileSpace.hpp>
 #include <Kokkos_Pair.hpp>
 #include <Kokkos_MemoryPool.hpp>
 #include <Kokkos_Array.hpp>
@@ -94,6 +95,8 @@
 #include <Kokkos_TaskScheduler.hpp>
 #include <Kokkos_Complex.hpp>
 #include <Kokkos_CopyViews.hpp>
+#include <impl/Kokkos_ViewBlockHash.hpp>
+#include <impl/Kokkos_CombineDuplicates.hpp>
 #include <functional>
 #include <iosfwd>
 
@@ -108,6 +111,10 @@ struct InitArguments {
   int ndevices;
   int skip_device;
   bool disable_warnings;
+  int hugepage_threshold;
+  int host_cache;
+  int barrier_fan_in;
+  int wait_policy;
 
   InitArguments(int nt = -1, int nn = -1, int dv = -1, bool dw = false)
       : num_threads{nt},
@@ -115,7 +122,11 @@ struct InitArguments {
         device_id{dv},
         ndevices{-1},
         skip_device{9999},
-        disable_warnings{dw} {}
+        disable_warnings{dw},
+        hugepage_threshold{-1},
+        host_cache{-1},
+        barrier_fan_in{-1},
+        wait_policy{-1} {}
 };
 
 void initialize(int& narg, char* arg[]);
@@ -89,12 +89,42 @@ bool lock_address_host_space(void* ptr);
 /// lock_address.
 void unlock_address_host_space(void* ptr);
 
+/// \brief Prepare a fresh host allocation for explicit NUMA placement
+///
+/// This function returns the whole pages inside [ptr, ptr + size) to the
+/// operating system so that the next touch faults them in on the touching
+/// thread's NUMA domain, even if the allocator recycled them. With
+/// interleave the pages are instead bound round robin to the online NUMA
+/// domains. Page contents are lost. Returns the page size, or zero where
+/// the platform does not support explicit placement.
+size_t host_space_numa_place(void* ptr, size_t size, bool interleave);
+
+/// \brief Reset interleaved placement of pages within [ptr, ptr + size)
+///
+/// Called when a HostSpace allocation is released, so that the memory
+/// policy does not outlive the View that requested it.
+void host_space_numa_release(void* ptr, size_t size);
+
+/// \brief Allocation size from which HostSpace uses huge pages
+///
+/// A nonzero threshold, set by --kokkos-hugepage-threshold or
+/// KOKKOS_HUGEPAGE_THRESHOLD, makes default constructed HostSpace
+/// instances use the HUGE_PAGES allocation mechanism. It must not change
+/// while HostSpace allocations are live.
+size_t host_space_huge_page_threshold();
+
+void set_host_space_huge_page_threshold(size_t threshold);
+
 }  // namespace Impl
 
 }  // namespace Kokkos
 
 namespace Kokkos {
 
+namespace Impl {
+class HostSpaceCache;
+}  // namespace Impl
+
 /// \class HostSpace
 /// \brief Memory management for host memory.
 ///
@@ -149,7 +179,10 @@ class HostSpace {
     STD_MALLOC,
     POSIX_MEMALIGN,
     POSIX_MMAP,
-    INTEL_MM_ALLOC
+    INTEL_MM_ALLOC,
+    // hugetlb pages, or transparent huge pages when the hugetlb pool is
+    // exhausted, at or above the huge page threshold; STD_MALLOC below it
+    HUGE_PAGES
   };
 
   explicit HostSpace(const AllocationMechanism&);
@@ -165,8 +198,10 @@ class HostSpace {
 
  private:
   AllocationMechanism m_alloc_mech;
+  size_t m_huge_page_threshold;
   static constexpr const char* m_name = "Host";
   friend class Kokkos::Impl::SharedAllocationRecord<Kokkos::HostSpace, void>;
+  friend class Kokkos::Impl::HostSpaceCache;
 };
 
 }  // namespace Kokkos
@@ -243,6 +278,15 @@ class SharedAllocationRecord<Kokkos::HostSpace, void>
 
   const Kokkos::HostSpace m_space;
 
+  /* Size class of a HostSpaceCache block, zero if not cached */
+  size_t m_cache_bytes = 0;
+
+  SharedAllocationRecord(const Kokkos::HostSpace& arg_space,
+                         const std::string& arg_label,
+                         const size_t arg_alloc_size,
+                         const RecordBase::function_type arg_dealloc,
+                         const size_t arg_cache_bytes);
+
  protected:
   ~SharedAllocationRecord()
 #if defined( \
@@ -0,0 +1,504 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOS_MMAPFILESPACE_HPP
+#define KOKKOS_MMAPFILESPACE_HPP
+
+#include <Kokkos_Macros.hpp>
+#if !defined(_WIN32)
+
+#include <Kokkos_HostSpace.hpp>
+#include <impl/Kokkos_FileSpace.hpp>
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+
+/*--------------------------------------------------------------------------*/
+
+namespace Kokkos {
+
+namespace Experimental {
+
+/// \class MMapFileSpace
+/// \brief Memory space backed by memory-mapped files.
+///
+/// Every allocation is a shared mapping of a file, so the data persists
+/// beyond the lifetime of the View and is written back by the kernel's
+/// page cache.  A labeled allocation maps the file
+/// <tt>directory()/label</tt> (or <tt>label</tt> if it is an absolute
+/// path), creating or growing it as required; an unlabeled allocation
+/// maps an unlinked temporary file in directory().
+///
+/// Mapped data is page aligned and directly accessible from the host,
+/// so views in this space are assignable to HostSpace views and
+/// create_mirror_view does not copy.
+class MMapFileSpace {
+ public:
+  //! Tag this class as a kokkos memory space
+  typedef MMapFileSpace memory_space;
+  //! Tag this class as a file space (no initialization on allocation)
+  typedef MMapFileSpace file_space;
+  typedef size_t size_type;
+
+  //! Mapped files are accessed by the default host execution space
+  typedef Kokkos::HostSpace::execution_space execution_space;
+
+  //! This memory space preferred device_type
+  typedef Kokkos::Device<execution_space, memory_space> device_type;
+
+  /**\brief  Access pattern hint passed to madvise for mapped data */
+  enum Advice { Normal, Sequential, Random, WillNeed, DontNeed };
+
+  /**\brief  Default memory space instance: current directory, no hint */
+  MMapFileSpace();
+  MMapFileSpace(const MMapFileSpace& rhs) = default;
+  MMapFileSpace& operator=(const MMapFileSpace&) = default;
+  ~MMapFileSpace()                               = default;
+
+  /**\brief  Memory space instance mapping files in \c arg_directory */
+  explicit MMapFileSpace(const std::string& arg_directory,
+                         const Advice arg_advice = Normal);
+
+  /**\brief  Allocate untracked memory backed by a temporary file */
+  void* allocate(const size_t arg_alloc_size) const;
+
+  /**\brief  Allocate untracked memory backed by the file named \c arg_label
+   */
+  void* allocate(const std::string& arg_label,
+                 const size_t arg_alloc_size) const;
+
+  /**\brief  Deallocate untracked memory in the space */
+  void deallocate(void* const arg_alloc_ptr, const size_t arg_alloc_size) const;
+
+  /**\brief  Apply an access pattern hint to the pages of [ptr, ptr+n) */
+  static void advise(const void* const arg_ptr, const size_t arg_size,
+                     const Advice arg_advice);
+
+  /**\brief  Synchronously write back the dirty pages of [ptr, ptr+n) */
+  static void sync(void* const arg_ptr, const size_t arg_size);
+
+  /**\brief  Size of the pages used for mappings */
+  static size_t page_size();
+
+  /**\brief  Chunk size in bytes of pipelined deep copies to or from
+   *         mappings.  Rounded up to a multiple of page_size().
+   */
+  static size_t copy_chunk_size();
+  static void set_copy_chunk_size(const size_t arg_chunk_size);
+
+  /**\brief  Number of chunks of a mapped source prefetched ahead of the
+   *         chunk being copied.
+   */
+  static int copy_prefetch_depth();
+  static void set_copy_prefetch_depth(const int arg_depth);
+
+  /**\brief  Directory holding the mapped files */
+  const std::string& directory() const { return m_directory; }
+
+  /**\brief Return Name of the MemorySpace */
+  static constexpr const char* name() { return "MMapFile"; }
+
+ private:
+  std::string m_directory;
+  Advice m_advice;
+  friend class Kokkos::Impl::SharedAllocationRecord<
+      Kokkos::Experimental::MMapFileSpace, void>;
+};
+
+}  // namespace Experimental
+
+}  // namespace Kokkos
+
+//----------------------------------------------------------------------------
+
+namespace Kokkos {
+
+namespace Impl {
+
+template <>
+class SharedAllocationRecord<Kokkos::Experimental::MMapFileSpace, void>
+    : public SharedAllocationRecord<void, void> {
+ private:
+  friend Kokkos::Experimental::MMapFileSpace;
+
+  typedef SharedAllocationRecord<void, void> RecordBase;
+
+  SharedAllocationRecord(const SharedAllocationRecord&) = delete;
+  SharedAllocationRecord& operator=(const SharedAllocationRecord&) = delete;
+
+  static void deallocate(RecordBase*);
+
+#ifdef KOKKOS_DEBUG
+  /**\brief  Root record for tracked allocations from this MMapFileSpace */
+  static RecordBase s_root_record;
+#endif
+
+  const Kokkos::Experimental::MMapFileSpace m_space;
+
+ protected:
+  ~SharedAllocationRecord()
+#if defined( \
+    KOKKOS_IMPL_INTEL_WORKAROUND_NOEXCEPT_SPECIFICATION_VIRTUAL_FUNCTION)
+      noexcept
+#endif
+      ;
+  SharedAllocationRecord() = default;
+
+  SharedAllocationRecord(
+      const Kokkos::Experimental::MMapFileSpace& arg_space,
+      const std::string& arg_label, const size_t arg_alloc_size,
+      const RecordBase::function_type arg_dealloc = &deallocate);
+
+ public:
+  inline std::string get_label() const {
+    return std::string(RecordBase::head()->m_label);
+  }
+
+  KOKKOS_INLINE_FUNCTION static SharedAllocationRecord* allocate(
+      const Kokkos::Experimental::MMapFileSpace& arg_space,
+      const std::string& arg_label, const size_t arg_alloc_size) {
+#if defined(KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST)
+    return new SharedAllocationRecord(arg_space, arg_label, arg_alloc_size);
+#else
+    return (SharedAllocationRecord*)0;
+#endif
+  }
+
+  /**\brief  Allocate tracked memory in the space */
+  static void* allocate_tracked(
+      const Kokkos::Experimental::MMapFileSpace& arg_space,
+      const std::string& arg_label, const size_t arg_alloc_size);
+
+  /**\brief  Reallocate tracked memory in the space */
+  static void* reallocate_tracked(void* const arg_alloc_ptr,
+                                  const size_t arg_alloc_size);
+
+  /**\brief  Deallocate tracked memory in the space */
+  static void deallocate_tracked(void* const arg_alloc_ptr);
+
+  static SharedAllocationRecord* get_record(void* arg_alloc_ptr);
+
+  static void print_records(std::ostream&,
+                            const Kokkos::Experimental::MMapFileSpace&,
+                            bool detail = false);
+};
+
+}  // namespace Impl
+
+}  // namespace Kokkos
+
+//----------------------------------------------------------------------------
+
+namespace Kokkos {
+
+namespace Impl {
+
+static_assert(Kokkos::Impl::MemorySpaceAccess<
+                  Kokkos::Experimental::MMapFileSpace,
+                  Kokkos::Experimental::MMapFileSpace>::assignable,
+              "");
+
+template <>
+struct MemorySpaceAccess<Kokkos::HostSpace,
+                         Kokkos::Experimental::MMapFileSpace> {
+  enum { assignable = true };
+  enum { accessible = true };
+  enum { deepcopy = true };
+};
+
+template <>
+struct MemorySpaceAccess<Kokkos::Experimental::MMapFileSpace,
+                         Kokkos::HostSpace> {
+  enum { assignable = false };
+  enum { accessible = true };
+  enum { deepcopy = true };
+};
+
+}  // namespace Impl
+
+}  // namespace Kokkos
+
+//----------------------------------------------------------------------------
+
+namespace Kokkos {
+
+namespace Impl {
+
+/// \brief Profiling region of one chunk of a pipelined copy to or from a
+///   mapping, so tools observe the throughput of every chunk.
+class MMapFileSpaceCopyChunk {
+ public:
+  MMapFileSpaceCopyChunk(const char* dst_space, const void* dst,
+                         const char* src_space, const void* src, size_t n);
+  ~MMapFileSpaceCopyChunk();
+
+ private:
+  MMapFileSpaceCopyChunk(const MMapFileSpaceCopyChunk&) = delete;
+  MMapFileSpaceCopyChunk& operator=(const MMapFileSpaceCopyChunk&) = delete;
+};
+
+/// \brief Prefetches the pages of a mapped source
+///   MMapFileSpace::copy_prefetch_depth() chunks ahead of a chunked copy,
+///   so the kernel reads the file while earlier chunks are copied.
+class MMapFileSpacePrefetcher {
+ public:
+  //! A null \c src disables prefetching
+  MMapFileSpacePrefetcher(const void* src, size_t n, size_t chunk);
+
+  //! Call before copying chunk \c k
+  void advance(size_t k);
+
+ private:
+  const char* m_src;
+  size_t m_size;
+  size_t m_chunk;
+  size_t m_depth;
+};
+
+/// \brief Chunked copy between host accessible buffers, at least one of
+///   which is a mapping.  A mapped source is prefetched ahead of the copy.
+void mmap_file_space_pipelined_copy(void* dst, const char* dst_space,
+                                    const void* src, const char* src_space,
+                                    size_t n, bool src_is_mapped);
+
+/// \brief Chunked copy between a mapping and a memory space the host can
+///   not access, through a ring of two host staging buffers.  The host
+///   side copy of one chunk overlaps the transfer of the previous
+///   (or next) chunk on \c exec.
+template <class MemorySpace, class ExecutionSpace>
+class MMapFileSpaceStagingRing {
+ public:
+#if defined(KOKKOS_ENABLE_CUDA)
+  typedef Kokkos::CudaHostPinnedSpace staging_space;
+#else
+  typedef Kokkos::HostSpace staging_space;
+#endif
+  enum { depth = 2 };
+
+  MMapFileSpaceStagingRing(const ExecutionSpace& exec, size_t n)
+      : m_exec(exec),
+        m_chunk(std::min(n, Kokkos::Experimental::MMapFileSpace::
+                                copy_chunk_size())) {
+    for (int i = 0; i < depth; ++i) m_buffer[i] = nullptr;
+    for (int i = 0; i < depth && m_chunk; ++i) {
+      m_buffer[i] = m_space.allocate(m_chunk);
+    }
+  }
+
+  ~MMapFileSpaceStagingRing() {
+    m_exec.fence();
+    for (int i = 0; i < depth; ++i) {
+      if (m_buffer[i]) m_space.deallocate(m_buffer[i], m_chunk);
+    }
+  }
+
+  //! Copy \c n bytes from the mapping \c src to \c dst in MemorySpace
+  void load(void* dst, const void* src, size_t n) {
+    MMapFileSpacePrefetcher prefetch(src, n, m_chunk);
+    for (size_t k = 0, off = 0; off < n; ++k, off += m_chunk) {
+      const size_t len = std::min(m_chunk, n - off);
+      void* const stage = m_buffer[k % depth];
+      prefetch.advance(k);
+      {
+        MMapFileSpaceCopyChunk region(
+            staging_space::name(), stage,
+            Kokkos::Experimental::MMapFileSpace::name(),
+            static_cast<const char*>(src) + off, len);
+        hostspace_parallel_deepcopy(stage, static_cast<const char*>(src) + off,
+                                    len);
+      }
+      // Wait for chunk k-1, which frees the buffer chunk k+1 will use.
+      m_exec.fence();
+      DeepCopy<MemorySpace, HostSpace, ExecutionSpace>(
+          m_exec, static_cast<char*>(dst) + off, stage, len);
+    }
+    m_exec.fence();
+  }
+
+  //! Copy \c n bytes from \c src in MemorySpace to the mapping \c dst
+  void store(void* dst, const void* src, size_t n) {
+    if (!n) return;
+    DeepCopy<HostSpace, MemorySpace, ExecutionSpace>(m_exec, m_buffer[0], src,
+                                                     std::min(m_chunk, n));
+    for (size_t k = 0, off = 0; off < n; ++k, off += m_chunk) {
+      const size_t len  = std::min(m_chunk, n - off);
+      const size_t next = off + m_chunk;
+      m_exec.fence();
+      if (next < n) {
+        DeepCopy<HostSpace, MemorySpace, ExecutionSpace>(
+            m_exec, m_buffer[(k + 1) % depth],
+            static_cast<const char*>(src) + next, std::min(m_chunk, n - next));
+      }
+      MMapFileSpaceCopyChunk region(Kokkos::Experimental::MMapFileSpace::name(),
+                                    static_cast<char*>(dst) + off,
+                                    staging_space::name(), m_buffer[k % depth],
+                                    len);
+      hostspace_parallel_deepcopy(static_cast<char*>(dst) + off,
+                                  m_buffer[k % depth], len);
+    }
+  }
+
+ private:
+  ExecutionSpace m_exec;
+  staging_space m_space;
+  size_t m_chunk;
+  void* m_buffer[depth];
+};
+
+template <class MemorySpace, class ExecutionSpace>
+void mmap_file_space_load(const ExecutionSpace&, void* dst, const void* src,
+                          size_t n, std::true_type /* host accessible */) {
+  mmap_file_space_pipelined_copy(dst, MemorySpace::name(), src,
+                                 Kokkos::Experimental::MMapFileSpace::name(),
+                                 n, true);
+}
+
+template <class MemorySpace, class ExecutionSpace>
+void mmap_file_space_load(const ExecutionSpace& exec, void* dst,
+                          const void* src, size_t n,
+                          std::false_type /* host accessible */) {
+  MMapFileSpaceStagingRing<MemorySpace, ExecutionSpace>(exec, n).load(dst, src,
+                                                                      n);
+}
+
+template <class MemorySpace, class ExecutionSpace>
+void mmap_file_space_store(const ExecutionSpace&, void* dst, const void* src,
+                           size_t n, std::true_type /* host accessible */) {
+  mmap_file_space_pipelined_copy(dst,
+                                 Kokkos::Experimental::MMapFileSpace::name(),
+                                 src, MemorySpace::name(), n, false);
+}
+
+template <class MemorySpace, class ExecutionSpace>
+void mmap_file_space_store(const ExecutionSpace& exec, void* dst,
+                           const void* src, size_t n,
+                           std::false_type /* host accessible */) {
+  MMapFileSpaceStagingRing<MemorySpace, ExecutionSpace>(exec, n).store(
+      dst, src, n);
+}
+
+template <class ExecutionSpace>
+struct DeepCopy<Kokkos::Experimental::MMapFileSpace,
+                Kokkos::Experimental::MMapFileSpace, ExecutionSpace> {
+  DeepCopy(void* dst, const void* src, size_t n) {
+    mmap_file_space_pipelined_copy(
+        dst, Kokkos::Experimental::MMapFileSpace::name(), src,
+        Kokkos::Experimental::MMapFileSpace::name(), n, true);
+  }
+
+  DeepCopy(const ExecutionSpace& exec, void* dst, const void* src, size_t n) {
+    exec.fence();
+    mmap_file_space_pipelined_copy(
+        dst, Kokkos::Experimental::MMapFileSpace::name(), src,
+        Kokkos::Experimental::MMapFileSpace::name(), n, true);
+  }
+};
+
+template <class MemorySpace, class ExecutionSpace>
+struct DeepCopy<MemorySpace, Kokkos::Experimental::MMapFileSpace,
+                ExecutionSpace> {
+  typedef std::integral_constant<
+      bool, MemorySpaceAccess<HostSpace, MemorySpace>::accessible>
+      host_accessible;
+
+  DeepCopy(void* dst, const void* src, size_t n) {
+    mmap_file_space_load<MemorySpace>(ExecutionSpace(), dst, src, n,
+                                      host_accessible());
+  }
+
+  DeepCopy(const ExecutionSpace& exec, void* dst, const void* src, size_t n) {
+    exec.fence();
+    mmap_file_space_load<MemorySpace>(exec, dst, src, n, host_accessible());
+  }
+};
+
+template <class MemorySpace, class ExecutionSpace>
+struct DeepCopy<Kokkos::Experimental::MMapFileSpace, MemorySpace,
+                ExecutionSpace> {
+  typedef std::integral_constant<
+      bool, MemorySpaceAccess<HostSpace, MemorySpace>::accessible>
+      host_accessible;
+
+  DeepCopy(void* dst, const void* src, size_t n) {
+    mmap_file_space_store<MemorySpace>(ExecutionSpace(), dst, src, n,
+                                       host_accessible());
+  }
+
+  DeepCopy(const ExecutionSpace& exec, void* dst, const void* src, size_t n) {
+    exec.fence();
+    mmap_file_space_store<MemorySpace>(exec, dst, src, n, host_accessible());
+  }
+};
+
+}  // namespace Impl
+
+}  // namespace Kokkos
+
+namespace Kokkos {
+
+namespace Impl {
+
+template <>
+struct VerifyExecutionCanAccessMemorySpace<
+    Kokkos::HostSpace, Kokkos::Experimental::MMapFileSpace> {
+  enum { value = true };
+  inline static void verify(void) {}
+  inline static void verify(const void*) {}
+};
+
+template <>
+struct VerifyExecutionCanAccessMemorySpace<Kokkos::Experimental::MMapFileSpace,
+                                           Kokkos::HostSpace> {
+  enum { value = true };
+  inline static void verify(void) {}
+  inline static void verify(const void*) {}
+};
+
+}  // namespace Impl
+
+}  // namespace Kokkos
+
+#endif
+#endif  // #define KOKKOS_MMAPFILESPACE_HPP
@@ -549,6 +549,8 @@ constexpr Kokkos::Impl::AllowPadding_t AllowPadding =
  *    4) Kokkos::WithoutInitializing to bypass initialization
  *    4) Kokkos::AllowPadding to allow allocation to pad dimensions for memory
  * alignment
+ *    5) Kokkos::NumaPolicy to choose the NUMA page placement of a HostSpace
+ * allocation
  */
 template <class... Args>
 inline Impl::ViewCtorProp<typename Impl::ViewCtorProp<void, Args>::type...>
@@ -1829,12 +1831,19 @@ class View : public ViewTraits<DataType, Properties...> {
     if (Kokkos::Impl::is_resilient_space<specialized_memory_space>::value &&
         Kokkos::Impl::SharedAllocationRecord<void,
                                              void>::duplicates_enabled()) {
+      shared_record_type* orig =
+          m_track.template get_record<specialized_memory_space>();
       shared_record_type* record =
-          reinterpret_cast<shared_record_type*>(m_map.duplicate_shared(
-              m_track.template get_record<specialized_memory_space>()));
-
-      // Setup and initialization complete, start tracking
-      m_track.assign_allocated_record_to_uninitialized(record);
+          orig ? reinterpret_cast<shared_record_type*>(
+                     m_map.duplicate_shared(orig))
+               : orig;
+
+      // Setup and initialization complete, track the duplicate instead of
+      // the original.  The duplication policy may keep the original.
+      if (record != orig) {
+        m_track.clear();
+        m_track.assign_allocated_record_to_uninitialized(record);
+      }
     }
 #endif
   }
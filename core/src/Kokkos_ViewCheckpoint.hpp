@@ -0,0 +1,205 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOS_VIEWCHECKPOINT_HPP
+#define KOKKOS_VIEWCHECKPOINT_HPP
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ViewHooks.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Kokkos {
+namespace Impl {
+
+class CheckpointEngineState;
+
+using captured_view_list = std::vector<std::unique_ptr<ConstViewHolderBase> >;
+
+/** \brief  Collect a holder for every View copied along with the functor.
+ *
+ *  The functor is copied once while a ViewHook is registered on the calling
+ *  thread, so every View captured by value (lambda captures, functor members)
+ *  reports itself.  Views are recorded in copy order, which is the member
+ *  order of the functor and is therefore stable between a checkpoint and the
+ *  matching restore.
+ */
+template <class F>
+void capture_views(const F& functor, captured_view_list& views) {
+  struct capture_hook : ViewHook {
+    captured_view_list& views;
+    explicit capture_hook(captured_view_list& v) : views(v) {}
+    void on_copy(ViewHolderBase& view) override {
+      views.emplace_back(view.clone());
+    }
+    void on_copy(ConstViewHolderBase& view) override {
+      views.emplace_back(view.clone());
+    }
+  } hook(views);
+
+  ScopedViewHook scope(hook);
+  F captured(functor);
+  (void)captured;
+}
+
+}  // namespace Impl
+
+namespace Experimental {
+
+/** \brief  Asynchronous checkpointing of the Views captured by a functor.
+ *
+ *  checkpoint() stages every captured View into one half of a double buffered
+ *  host staging area (pinned when CUDA is enabled) and hands the buffer to a
+ *  background writer thread, so the caller is only blocked for the device to
+ *  host copy.  The writer hashes each staged View and skips those whose
+ *  contents are unchanged since the last written checkpoint of the same name;
+ *  the manifest of the new version points at the file that already holds the
+ *  data.
+ *
+ *  With a nonzero 'block_size' contiguous Views are instead split into blocks
+ *  that are hashed on each View's own execution space before staging.  Only
+ *  blocks whose hash changed since the previous checkpoint are copied to the
+ *  host and written, and the manifest records for every View the runs of
+ *  blocks and the file each run lives in.
+ *
+ *  set_compression() enables compression of the Views written whole.  The
+ *  writer thread compresses the staged bytes, so checkpoint() still only
+ *  copies.  Every View is cut into independent chunks and the bytes of each
+ *  element are shuffled into planes and LZ compressed, which for smooth
+ *  fields leaves long runs of equal high order bytes.  In lossy mode float
+ *  and double Views are first quantized to within the error bound and delta
+ *  coded; chunks that cannot be represented within the bound fall back to
+ *  lossless.  Block-delta Views are written uncompressed.
+ *
+ *  Files are written to '<directory>/<name>.<version>.kokkos_ckpt' and
+ *  '<directory>/<name>.<version>.manifest'.  The manifest is renamed into place
+ *  only after the data are written, so a version exists once its manifest
+ *  does.
+ *
+ *  The engine must be destroyed before Kokkos::finalize().
+ */
+class CheckpointEngine {
+ public:
+  struct Statistics {
+    size_t checkpoints    = 0;
+    size_t views_captured = 0;
+    size_t views_written  = 0;
+    size_t views_skipped  = 0;
+    size_t blocks_written = 0;
+    size_t blocks_skipped = 0;
+    size_t bytes_staged   = 0;
+    size_t bytes_written  = 0;
+    /* Time the caller spent blocked in checkpoint() */
+    double stage_seconds = 0;
+    /* Time the background thread spent compressing, hashing and writing */
+    double write_seconds = 0;
+    /* Part of 'write_seconds' spent compressing */
+    double compress_seconds = 0;
+  };
+
+  enum class Compression { None, Lossless, Lossy };
+
+  /** \brief  Write checkpoints to 'directory'.  A nonzero 'block_size',
+   *          which must be a multiple of 8, enables block-level delta
+   *          checkpoints.
+   */
+  explicit CheckpointEngine(const std::string& directory,
+                            size_t block_size = 0);
+  ~CheckpointEngine();
+
+  CheckpointEngine(const CheckpointEngine&) = delete;
+  CheckpointEngine& operator=(const CheckpointEngine&) = delete;
+
+  /** \brief  Compress the Views written by later checkpoints.  Lossy mode
+   *          restores every float and double value to within 'error_bound'
+   *          and is lossless for other Views.
+   */
+  void set_compression(Compression mode, double error_bound = 0);
+
+  /** \brief  Checkpoint the Views captured by 'functor' as 'name' 'version'.
+   *
+   *  Returns once the Views are staged; the write completes asynchronously.
+   *  Errors from a previous background write are rethrown here.
+   */
+  template <class F>
+  void checkpoint(const std::string& name, int version, const F& functor) {
+    Kokkos::Impl::captured_view_list views;
+    Kokkos::Impl::capture_views(functor, views);
+    checkpoint_views(name, version, views);
+  }
+
+  /** \brief  Restore the non-const Views captured by 'functor' from 'name'
+   *          'version'.  Waits for outstanding writes first.
+   */
+  template <class F>
+  void restore(const std::string& name, int version, const F& functor) {
+    Kokkos::Impl::captured_view_list views;
+    Kokkos::Impl::capture_views(functor, views);
+    restore_views(name, version, views);
+  }
+
+  /** \brief  Whether a complete checkpoint 'name' 'version' is on disk */
+  bool exists(const std::string& name, int version) const;
+
+  /** \brief  Wait until every staged checkpoint is written */
+  void fence();
+
+  Statistics statistics() const;
+
+ private:
+  void checkpoint_views(const std::string& name, int version,
+                        Kokkos::Impl::captured_view_list& views);
+  void restore_views(const std::string& name, int version,
+                     Kokkos::Impl::captured_view_list& views);
+
+  std::unique_ptr<Kokkos::Impl::CheckpointEngineState> m_state;
+};
+
+}  // namespace Experimental
+}  // namespace Kokkos
+
+#endif  // KOKKOS_VIEWCHECKPOINT_HPP
@@ -49,6 +49,8 @@
 #include <Kokkos_Layout.hpp>
 
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <type_traits>
@@ -63,6 +65,14 @@ namespace Kokkos
 
   namespace Impl
   {
+    // Defined in impl/Kokkos_ViewBlockHash.hpp
+    template< class ViewType >
+    bool view_hash_blocks( const ViewType &view, size_t block_size, uint64_t *hashes );
+
+    template< class ViewType >
+    void view_pack_blocks( const ViewType &view, size_t block_size, const size_t *blocks,
+                           size_t num_blocks, unsigned char *buff );
+
     template< class DataType, class... Properties >
     View< typename ViewTraits< DataType, Properties... >::non_const_data_type,
           typename std::conditional< std::is_same< LayoutLeft, typename ViewTraits< DataType, Properties... >::array_layout >::value,
@@ -97,17 +107,29 @@ namespace Kokkos
     virtual ~ConstViewHolderBase() = default;
 
     virtual size_t span() const = 0;
+    virtual size_t size() const = 0;
     virtual bool span_is_contiguous() const = 0;
     virtual const void *data() const = 0;
     virtual std::string label() const = 0;
 
     virtual ConstViewHolderBase *clone() const = 0;
     virtual size_t data_type_size() const = 0;
+    virtual bool is_floating_point() const noexcept = 0;
 
     virtual bool is_hostspace() const noexcept = 0;
 
     virtual void deep_copy_to_buffer( unsigned char *buff ) = 0;
 
+    /* Split the span into 'block_size' byte blocks and hash each one on the
+     * View's execution space, writing one hash per block into host memory.
+     * Returns false, leaving 'hashes' untouched, if the span is not contiguous.
+     */
+    virtual bool hash_blocks( size_t block_size, uint64_t *hashes ) = 0;
+
+    /* Pack the listed blocks, in ascending order, contiguously into 'buff' */
+    virtual void deep_copy_blocks_to_buffer( size_t block_size, const size_t *blocks,
+                                             size_t num_blocks, unsigned char *buff ) = 0;
+
   private:
   };
 
@@ -134,6 +156,7 @@ namespace Kokkos
     {}
 
     size_t span() const override { return m_view.span(); }
+    size_t size() const override { return m_view.size(); }
     bool span_is_contiguous() const override { return m_view.span_is_contiguous(); }
     const void *data() const override { return m_view.data(); };
     void *data() override { return m_view.data(); };
@@ -145,6 +168,10 @@ namespace Kokkos
 
     std::string label() const override { return m_view.label(); }
     size_t data_type_size() const noexcept override { return sizeof( typename View::value_type ); }
+    bool is_floating_point() const noexcept override
+    {
+      return std::is_floating_point< typename std::remove_const< typename View::value_type >::type >::value;
+    }
 
     bool is_hostspace() const noexcept override { return std::is_same< typename View::memory_space , HostSpace >::value; }
 
@@ -154,6 +181,17 @@ namespace Kokkos
       deep_copy( unmanaged, m_view );
     }
 
+    bool hash_blocks( size_t block_size, uint64_t *hashes ) override
+    {
+      return Impl::view_hash_blocks( m_view, block_size, hashes );
+    }
+
+    void deep_copy_blocks_to_buffer( size_t block_size, const size_t *blocks,
+                                     size_t num_blocks, unsigned char *buff ) override
+    {
+      Impl::view_pack_blocks( m_view, block_size, blocks, num_blocks, buff );
+    }
+
     void deep_copy_from_buffer( unsigned char *buff ) override
     {
       auto unmanaged = Impl::make_unmanaged_view_like( m_view, buff );
@@ -177,9 +215,14 @@ namespace Kokkos
     {}
 
     size_t span() const override { return m_view.span(); }
+    size_t size() const override { return m_view.size(); }
     bool span_is_contiguous() const override { return m_view.span_is_contiguous(); }
     const void *data() const override { return m_view.data(); };
     size_t data_type_size() const noexcept override { return sizeof( typename View::value_type ); }
+    bool is_floating_point() const noexcept override
+    {
+      return std::is_floating_point< typename std::remove_const< typename View::value_type >::type >::value;
+    }
 
     bool is_hostspace() const noexcept override { return std::is_same< typename View::memory_space , HostSpace >::value; }
 
@@ -196,68 +239,181 @@ namespace Kokkos
       deep_copy( unmanaged, m_view );
     }
 
+    bool hash_blocks( size_t block_size, uint64_t *hashes ) override
+    {
+      return Impl::view_hash_blocks( m_view, block_size, hashes );
+    }
+
+    void deep_copy_blocks_to_buffer( size_t block_size, const size_t *blocks,
+                                     size_t num_blocks, unsigned char *buff ) override
+    {
+      Impl::view_pack_blocks( m_view, block_size, blocks, num_blocks, buff );
+    }
+
   private:
 
     View m_view;
   };
 
+  /* A hook observes every View copy constructed on the host while it is
+   * registered.  The holder refers to the new copy and is only valid for the
+   * duration of the call; clone() it to keep the View.  View copies made
+   * from within a hook are not reported.
+   */
+  class ViewHook
+  {
+  public:
+
+    virtual ~ViewHook() = default;
+
+    virtual void on_copy( ViewHolderBase & ) {}
+    virtual void on_copy( ConstViewHolderBase & ) {}
+  };
+
+  namespace Impl
+  {
+    // Adapts the callback pair of ViewHooks::set to a ViewHook
+    class ViewHookCallbacks : public ViewHook
+    {
+    public:
+
+      using callback_type = std::function< void( ViewHolderBase & ) >;
+      using const_callback_type = std::function< void( ConstViewHolderBase & ) >;
+
+      ViewHookCallbacks( callback_type cb, const_callback_type ccb )
+        : m_callback( std::move( cb ) ), m_const_callback( std::move( ccb ) )
+      {}
+
+      void on_copy( ViewHolderBase &view ) override
+      {
+        if ( m_callback ) m_callback( view );
+      }
+
+      void on_copy( ConstViewHolderBase &view ) override
+      {
+        if ( m_const_callback ) m_const_callback( view );
+      }
+
+    private:
+
+      callback_type m_callback;
+      const_callback_type m_const_callback;
+    };
+  }
+
+  /* Hooks are registered either for the View copies made by the calling
+   * thread, which is how captures are done, or for copies made by any thread.
+   * Up to max_hooks of each kind are active at once.  The View copy
+   * constructor only pays for one relaxed atomic load while no hook is
+   * registered anywhere; otherwise hooks are called through a stack
+   * allocated ViewHolder, without allocating.
+   */
   struct ViewHooks
   {
-    using callback_type = std::function< void( ViewHolderBase & ) >;
-    using const_callback_type = std::function< void( ConstViewHolderBase & ) >;
+    enum { max_hooks = 8 };
+
+    using callback_type = Impl::ViewHookCallbacks::callback_type;
+    using const_callback_type = Impl::ViewHookCallbacks::const_callback_type;
 
+    /* Register 'hook' for View copies made by the calling thread */
+    static void add( ViewHook *hook );
+    static void remove( ViewHook *hook );
+
+    /* Register 'hook' for View copies made by any thread.  The hook must
+     * stay alive until copies running concurrently with remove_global finish.
+     */
+    static void add_global( ViewHook *hook );
+    static void remove_global( ViewHook *hook );
+
+    /* Register a pair of callbacks for the calling thread, replacing the pair
+     * set before by this thread
+     */
     template< typename F, typename ConstF >
     static void set( F &&fun, ConstF &&const_fun )
     {
-      s_callback = std::forward< F >( fun );
-      s_const_callback = std::forward< ConstF >( const_fun );
+      set_callbacks( new Impl::ViewHookCallbacks( callback_type( std::forward< F >( fun ) ),
+                                                  const_callback_type( std::forward< ConstF >( const_fun ) ) ) );
     }
 
-    static void clear()
-    {
-      s_callback = callback_type{};
-      s_const_callback = const_callback_type{};
-    }
+    /* Remove the callbacks registered by set() on the calling thread */
+    static void clear();
 
+    /* Whether any thread registered a hook */
     static bool is_set() noexcept
     {
-      return static_cast< bool >( s_callback ) || static_cast< bool >( s_const_callback );
+      return s_registered.load( std::memory_order_relaxed ) != 0;
     }
 
     template< class DataType, class ... Properties >
     static void call( View< DataType, Properties... > &view )
     {
-      callback_type tmp_callback;
-      const_callback_type tmp_const_callback;
+      ThreadState &state = t_state;
+      if ( state.depth != 0 ) return;
 
-      std::swap( s_callback, tmp_callback );
-      std::swap( s_const_callback, tmp_const_callback );
+      struct depth_guard
+      {
+        int &depth;
+        explicit depth_guard( int &d ) : depth( d ) { ++depth; }
+        ~depth_guard() { --depth; }
+      } guard( state.depth );
 
-      auto holder = ViewHolder< View< DataType, Properties... > >( view );
+      ViewHolder< View< DataType, Properties... > > holder( view );
 
-      do_call( tmp_callback, tmp_const_callback, std::move( holder ) );
+      for ( int i = 0; i < state.count; ++i )
+        state.hooks[i]->on_copy( holder );
 
-      std::swap( s_callback, tmp_callback );
-      std::swap( s_const_callback, tmp_const_callback );
+      if ( s_global_count.load( std::memory_order_acquire ) != 0 ) {
+        for ( int i = 0; i < max_hooks; ++i ) {
+          ViewHook *const hook = s_global[i].load( std::memory_order_acquire );
+          if ( hook ) hook->on_copy( holder );
+        }
+      }
     }
 
   private:
 
-    static void do_call( callback_type _cb, const_callback_type _ccb, ViewHolderBase &&view )
+    // Plain data so it can be thread local on every supported compiler
+    struct ThreadState
     {
-      if ( _cb ) {
-        _cb(view);
-      }
+      ViewHook *hooks[max_hooks];
+      ViewHook *callbacks;
+      int count;
+      int depth;
+    };
+
+    static void set_callbacks( ViewHook *hook );
+
+    static KOKKOS_THREAD_LOCAL ThreadState t_state;
+    static std::atomic< int > s_registered;
+    static std::atomic< int > s_global_count;
+    static std::atomic< ViewHook * > s_global[max_hooks];
+  };
+
+  /* Registers a hook for the lifetime of the object */
+  class ScopedViewHook
+  {
+  public:
+
+    explicit ScopedViewHook( ViewHook &hook, bool global = false )
+      : m_hook( &hook ), m_global( global )
+    {
+      if ( m_global ) ViewHooks::add_global( m_hook );
+      else ViewHooks::add( m_hook );
     }
 
-    static void do_call( callback_type _cb, const_callback_type _ccb, ConstViewHolderBase &&view )
+    ~ScopedViewHook()
     {
-      if ( _ccb )
-        _ccb( view );
+      if ( m_global ) ViewHooks::remove_global( m_hook );
+      else ViewHooks::remove( m_hook );
     }
 
-    static callback_type s_callback;
-    static const_callback_type s_const_callback;
+    ScopedViewHook( const ScopedViewHook & ) = delete;
+    ScopedViewHook &operator=( const ScopedViewHook & ) = delete;
+
+  private:
+
+    ViewHook *m_hook;
+    bool m_global;
   };
 
 
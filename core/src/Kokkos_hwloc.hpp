@@ -117,6 +117,14 @@ unsigned thread_mapping(const char* const label, const bool allow_async,
  */
 std::pair<unsigned, unsigned> get_this_thread_coordinate();
 
+/** \brief  Query the (socket, NUMA domain) of the core the current thread
+ *          last ran on.  The ids are only meaningful relative to each other.
+ *
+ *  Read from hwloc when enabled, otherwise from /sys on Linux;
+ *  (0,0) when the topology is unknown.
+ */
+std::pair<unsigned, unsigned> get_this_thread_numa_location();
+
 /** \brief  Bind the current thread to a core. */
 bool bind_this_thread(const std::pair<unsigned, unsigned>);
 
@@ -228,6 +228,11 @@ void OpenMPExec::resize_thread_data(size_t pool_reduce_bytes,
 
       m_pool[rank] = new (ptr) HostThreadTeamData();
 
+      // hwloc queries are not thread safe
+#pragma omp critical
+      m_pool[rank]->set_numa_location(
+          Kokkos::hwloc::get_this_thread_numa_location());
+
       m_pool[rank]->scratch_assign(((char *)ptr) + member_bytes, alloc_bytes,
                                    pool_reduce_bytes, team_reduce_bytes,
                                    team_shared_bytes, thread_local_bytes);
@@ -50,6 +50,7 @@
 
 #include <omp.h>
 #include <iostream>
+#include <memory>
 #include <OpenMP/Kokkos_OpenMP_Exec.hpp>
 #include <impl/Kokkos_FunctorAdapter.hpp>
 
@@ -106,10 +107,10 @@ class ParallelFor<FunctorType, Kokkos::RangePolicy<Traits...>, Kokkos::OpenMP> {
 
  public:
   inline void execute() const {
-    enum {
-      is_dynamic = std::is_same<typename Policy::schedule_type::type,
-                                Kokkos::Dynamic>::value
-    };
+    typedef typename Policy::schedule_type::type schedule;
+    enum { is_dynamic = std::is_same<schedule, Kokkos::Dynamic>::value };
+    enum { is_guided = std::is_same<schedule, Kokkos::Guided>::value };
+    enum { is_adaptive = std::is_same<schedule, Kokkos::Adaptive>::value };
 
     if (OpenMP::in_parallel()) {
       exec_range<WorkTag>(m_functor, m_policy.begin(), m_policy.end());
@@ -117,32 +118,58 @@ class ParallelFor<FunctorType, Kokkos::RangePolicy<Traits...>, Kokkos::OpenMP> {
       OpenMPExec::verify_is_master("Kokkos::OpenMP parallel_for");
 
 #ifdef KOKKOS_ENABLE_DEPRECATED_CODE
-#pragma omp parallel num_threads(OpenMP::thread_pool_size())
+      const int pool_size = OpenMP::thread_pool_size();
 #else
-#pragma omp parallel num_threads(OpenMP::impl_thread_pool_size())
+      const int pool_size = OpenMP::impl_thread_pool_size();
 #endif
+      const int64_t length = m_policy.end() - m_policy.begin();
+
+      HostAdaptiveChunk* const adaptive =
+          host_adaptive_chunk<FunctorType, Policy>();
+      const int64_t chunk =
+          is_adaptive
+              ? adaptive->chunk(length, pool_size, m_policy.chunk_size())
+              : m_policy.chunk_size();
+      std::unique_ptr<HostAdaptiveChunk::Sample[]> samples(
+          is_adaptive ? new HostAdaptiveChunk::Sample[pool_size] : nullptr);
+
+#pragma omp parallel num_threads(pool_size)
       {
         HostThreadTeamData& data = *(m_instance->get_thread_data());
 
-        data.set_work_partition(m_policy.end() - m_policy.begin(),
-                                m_policy.chunk_size());
+        data.set_work_partition(length, chunk);
 
-        if (is_dynamic) {
+        if (is_dynamic || is_guided || is_adaptive) {
           // Make sure work partition is set before stealing
           if (data.pool_rendezvous()) data.pool_rendezvous_release();
         }
 
-        std::pair<int64_t, int64_t> range(0, 0);
-
-        do {
-          range = is_dynamic ? data.get_work_stealing_chunk()
-                             : data.get_work_partition();
-
-          ParallelFor::template exec_range<WorkTag>(
-              m_functor, range.first + m_policy.begin(),
-              range.second + m_policy.begin());
+        if (is_adaptive) {
+          samples[data.pool_rank()] = HostAdaptiveChunk::run(
+              data, [this](const int64_t begin, const int64_t end) {
+                ParallelFor::template exec_range<WorkTag>(
+                    m_functor, begin + m_policy.begin(),
+                    end + m_policy.begin());
+              });
+        } else {
+          std::pair<int64_t, int64_t> range(0, 0);
+
+          do {
+            range = is_dynamic
+                        ? data.get_work_stealing_chunk()
+                        : is_guided ? data.get_work_shared_chunk(true)
+                                    : data.get_work_partition();
+
+            ParallelFor::template exec_range<WorkTag>(
+                m_functor, range.first + m_policy.begin(),
+                range.second + m_policy.begin());
+
+          } while ((is_dynamic || is_guided) && 0 <= range.first);
+        }
+      }
 
-        } while (is_dynamic && 0 <= range.first);
+      if (is_adaptive) {
+        adaptive->update(length, chunk, samples.get(), pool_size);
       }
     }
   }
@@ -305,12 +332,20 @@ class ParallelReduce<FunctorType, Kokkos::RangePolicy<Traits...>, ReducerType,
     }
   }
 
+  // Combine the pool's contributions into the root's pool_reduce_local()
+  inline void pool_reduce_tree(HostThreadTeamData const& data) const {
+    data.pool_reduce_tree([this](int64_t* dst, int64_t* src) {
+      ValueJoin::join(ReducerConditional::select(m_functor, m_reducer),
+                      pointer_type(dst), pointer_type(src));
+    });
+  }
+
  public:
   inline void execute() const {
-    enum {
-      is_dynamic = std::is_same<typename Policy::schedule_type::type,
-                                Kokkos::Dynamic>::value
-    };
+    typedef typename Policy::schedule_type::type schedule;
+    enum { is_dynamic = std::is_same<schedule, Kokkos::Dynamic>::value };
+    enum { is_guided = std::is_same<schedule, Kokkos::Guided>::value };
+    enum { is_adaptive = std::is_same<schedule, Kokkos::Adaptive>::value };
 
     OpenMPExec::verify_is_master("Kokkos::OpenMP parallel_reduce");
 
@@ -329,14 +364,23 @@ class ParallelReduce<FunctorType, Kokkos::RangePolicy<Traits...>, ReducerType,
 #else
     const int pool_size = OpenMP::impl_thread_pool_size();
 #endif
+    const int64_t length = m_policy.end() - m_policy.begin();
+
+    HostAdaptiveChunk* const adaptive =
+        host_adaptive_chunk<FunctorType, Policy>();
+    const int64_t chunk =
+        is_adaptive ? adaptive->chunk(length, pool_size, m_policy.chunk_size())
+                    : m_policy.chunk_size();
+    std::unique_ptr<HostAdaptiveChunk::Sample[]> samples(
+        is_adaptive ? new HostAdaptiveChunk::Sample[pool_size] : nullptr);
+
 #pragma omp parallel num_threads(pool_size)
     {
       HostThreadTeamData& data = *(m_instance->get_thread_data());
 
-      data.set_work_partition(m_policy.end() - m_policy.begin(),
-                              m_policy.chunk_size());
+      data.set_work_partition(length, chunk);
 
-      if (is_dynamic) {
+      if (is_dynamic || is_guided || is_adaptive) {
         // Make sure work partition is set before stealing
         if (data.pool_rendezvous()) data.pool_rendezvous_release();
       }
@@ -345,29 +389,38 @@ class ParallelReduce<FunctorType, Kokkos::RangePolicy<Traits...>, ReducerType,
           ValueInit::init(ReducerConditional::select(m_functor, m_reducer),
                           data.pool_reduce_local());
 
-      std::pair<int64_t, int64_t> range(0, 0);
+      if (is_adaptive) {
+        samples[data.pool_rank()] = HostAdaptiveChunk::run(
+            data, [this, &update](const int64_t begin, const int64_t end) {
+              ParallelReduce::template exec_range<WorkTag>(
+                  m_functor, begin + m_policy.begin(), end + m_policy.begin(),
+                  update);
+            });
+      } else {
+        std::pair<int64_t, int64_t> range(0, 0);
 
-      do {
-        range = is_dynamic ? data.get_work_stealing_chunk()
-                           : data.get_work_partition();
+        do {
+          range = is_dynamic ? data.get_work_stealing_chunk()
+                             : is_guided ? data.get_work_shared_chunk(true)
+                                         : data.get_work_partition();
 
-        ParallelReduce::template exec_range<WorkTag>(
-            m_functor, range.first + m_policy.begin(),
-            range.second + m_policy.begin(), update);
+          ParallelReduce::template exec_range<WorkTag>(
+              m_functor, range.first + m_policy.begin(),
+              range.second + m_policy.begin(), update);
 
-      } while (is_dynamic && 0 <= range.first);
+        } while ((is_dynamic || is_guided) && 0 <= range.first);
+      }
+
+      pool_reduce_tree(data);
     }
 
-    // Reduction:
+    if (is_adaptive) adaptive->update(length, chunk, samples.get(), pool_size);
+
+    // Reduction, combined in the parallel region:
 
     const pointer_type ptr =
         pointer_type(m_instance->get_thread_data(0)->pool_reduce_local());
 
-    for (int i = 1; i < pool_size; ++i) {
-      ValueJoin::join(ReducerConditional::select(m_functor, m_reducer), ptr,
-                      m_instance->get_thread_data(i)->pool_reduce_local());
-    }
-
     Kokkos::Impl::FunctorFinal<ReducerTypeFwd, WorkTagFwd>::final(
         ReducerConditional::select(m_functor, m_reducer), ptr);
 
@@ -466,6 +519,14 @@ class ParallelReduce<FunctorType, Kokkos::MDRangePolicy<Traits...>, ReducerType,
     }
   }
 
+  // Combine the pool's contributions into the root's pool_reduce_local()
+  inline void pool_reduce_tree(HostThreadTeamData const& data) const {
+    data.pool_reduce_tree([this](int64_t* dst, int64_t* src) {
+      ValueJoin::join(ReducerConditional::select(m_functor, m_reducer),
+                      pointer_type(dst), pointer_type(src));
+    });
+  }
+
  public:
   inline void execute() const {
     enum {
@@ -517,19 +578,16 @@ class ParallelReduce<FunctorType, Kokkos::MDRangePolicy<Traits...>, ReducerType,
                                    range.second + m_policy.begin(), update);
 
       } while (is_dynamic && 0 <= range.first);
+
+      pool_reduce_tree(data);
     }
     // END #pragma omp parallel
 
-    // Reduction:
+    // Reduction, combined in the parallel region:
 
     const pointer_type ptr =
         pointer_type(m_instance->get_thread_data(0)->pool_reduce_local());
 
-    for (int i = 1; i < pool_size; ++i) {
-      ValueJoin::join(ReducerConditional::select(m_functor, m_reducer), ptr,
-                      m_instance->get_thread_data(i)->pool_reduce_local());
-    }
-
     Kokkos::Impl::FunctorFinal<ReducerTypeFwd, WorkTagFwd>::final(
         ReducerConditional::select(m_functor, m_reducer), ptr);
 
@@ -638,7 +696,8 @@ class ParallelScan<FunctorType, Kokkos::RangePolicy<Traits...>,
     OpenMPExec::verify_is_master("Kokkos::OpenMP parallel_scan");
 
     const int value_count          = Analysis::value_count(m_functor);
-    const size_t pool_reduce_bytes = 2 * Analysis::value_size(m_functor);
+    const size_t value_size        = Analysis::value_size(m_functor);
+    const size_t pool_reduce_bytes = 3 * value_size;
 
     m_instance->resize_thread_data(pool_reduce_bytes, 0  // team_reduce_bytes
                                    ,
@@ -664,29 +723,12 @@ class ParallelScan<FunctorType, Kokkos::RangePolicy<Traits...>,
       ParallelScan::template exec_range<WorkTag>(
           m_functor, range.begin(), range.end(), update_sum, false);
 
-      if (data.pool_rendezvous()) {
-        pointer_type ptr_prev = 0;
-
-        const int n = omp_get_num_threads();
-
-        for (int i = 0; i < n; ++i) {
-          pointer_type ptr =
-              (pointer_type)data.pool_member(i)->pool_reduce_local();
-
-          if (i) {
-            for (int j = 0; j < value_count; ++j) {
-              ptr[j + value_count] = ptr_prev[j + value_count];
-            }
-            ValueJoin::join(m_functor, ptr + value_count, ptr_prev);
-          } else {
-            ValueInit::init(m_functor, ptr + value_count);
-          }
-
-          ptr_prev = ptr;
-        }
-
-        data.pool_rendezvous_release();
-      }
+      data.pool_scan_tree(
+          value_size,
+          [this](void* dst) { ValueInit::init(m_functor, dst); },
+          [this](void* dst, void* src) {
+            ValueJoin::join(m_functor, pointer_type(dst), pointer_type(src));
+          });
 
       reference_type update_base = ValueOps::reference(
           ((pointer_type)data.pool_reduce_local()) + value_count);
@@ -757,7 +799,8 @@ class ParallelScanWithTotal<FunctorType, Kokkos::RangePolicy<Traits...>,
     OpenMPExec::verify_is_master("Kokkos::OpenMP parallel_scan");
 
     const int value_count          = Analysis::value_count(m_functor);
-    const size_t pool_reduce_bytes = 2 * Analysis::value_size(m_functor);
+    const size_t value_size        = Analysis::value_size(m_functor);
+    const size_t pool_reduce_bytes = 3 * value_size;
 
     m_instance->resize_thread_data(pool_reduce_bytes, 0  // team_reduce_bytes
                                    ,
@@ -782,29 +825,12 @@ class ParallelScanWithTotal<FunctorType, Kokkos::RangePolicy<Traits...>,
       ParallelScanWithTotal::template exec_range<WorkTag>(
           m_functor, range.begin(), range.end(), update_sum, false);
 
-      if (data.pool_rendezvous()) {
-        pointer_type ptr_prev = 0;
-
-        const int n = omp_get_num_threads();
-
-        for (int i = 0; i < n; ++i) {
-          pointer_type ptr =
-              (pointer_type)data.pool_member(i)->pool_reduce_local();
-
-          if (i) {
-            for (int j = 0; j < value_count; ++j) {
-              ptr[j + value_count] = ptr_prev[j + value_count];
-            }
-            ValueJoin::join(m_functor, ptr + value_count, ptr_prev);
-          } else {
-            ValueInit::init(m_functor, ptr + value_count);
-          }
-
-          ptr_prev = ptr;
-        }
-
-        data.pool_rendezvous_release();
-      }
+      data.pool_scan_tree(
+          value_size,
+          [this](void* dst) { ValueInit::init(m_functor, dst); },
+          [this](void* dst, void* src) {
+            ValueJoin::join(m_functor, pointer_type(dst), pointer_type(src));
+          });
 
       reference_type update_base = ValueOps::reference(
           ((pointer_type)data.pool_reduce_local()) + value_count);
@@ -1041,6 +1067,14 @@ class ParallelReduce<FunctorType, Kokkos::TeamPolicy<Properties...>,
     }
   }
 
+  // Combine the pool's contributions into the root's pool_reduce_local()
+  inline void pool_reduce_tree(HostThreadTeamData const& data) const {
+    data.pool_reduce_tree([this](int64_t* dst, int64_t* src) {
+      ValueJoin::join(ReducerConditional::select(m_functor, m_reducer),
+                      pointer_type(dst), pointer_type(src));
+    });
+  }
+
  public:
   inline void execute() const {
     enum { is_dynamic = std::is_same<SchedTag, Kokkos::Dynamic>::value };
@@ -1105,26 +1139,18 @@ class ParallelReduce<FunctorType, Kokkos::TeamPolicy<Properties...>,
       data.disband_team();
 
       //  This thread has updated 'pool_reduce_local()' with its
-      //  contributions to the reduction.  The parallel region is
-      //  about to terminate and the master thread will load and
-      //  reduce each 'pool_reduce_local()' contribution.
-      //  Must 'memory_fence()' to guarantee that storing the update to
-      //  'pool_reduce_local()' will complete before this thread
-      //  exits the parallel region.
-
-      memory_fence();
+      //  contributions to the reduction.  The contributions are
+      //  combined in a tree into the master thread's
+      //  'pool_reduce_local()' before the parallel region terminates.
+
+      pool_reduce_tree(data);
     }
 
-    // Reduction:
+    // Reduction, combined in the parallel region:
 
     const pointer_type ptr =
         pointer_type(m_instance->get_thread_data(0)->pool_reduce_local());
 
-    for (int i = 1; i < pool_size; ++i) {
-      ValueJoin::join(ReducerConditional::select(m_functor, m_reducer), ptr,
-                      m_instance->get_thread_data(i)->pool_reduce_local());
-    }
-
     Kokkos::Impl::FunctorFinal<ReducerTypeFwd, WorkTagFwd>::final(
         ReducerConditional::select(m_functor, m_reducer), ptr);
 
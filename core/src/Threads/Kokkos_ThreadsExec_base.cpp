@@ -60,6 +60,7 @@
 #include <stdexcept>
 
 #include <Kokkos_Threads.hpp>
+#include <impl/Kokkos_Spinwait.hpp>
 
 //----------------------------------------------------------------------------
 
@@ -132,9 +133,7 @@ void ThreadsExec::global_unlock() {
 //----------------------------------------------------------------------------
 
 void ThreadsExec::wait_yield(volatile int& flag, const int value) {
-  while (value == flag) {
-    sched_yield();
-  }
+  host_thread_wait_while_equal(flag, value);
 }
 
 }  // namespace Impl
@@ -468,9 +468,9 @@ class ThreadsExecTeamMember {
         m_exec->set_work_range(m_league_rank, m_league_end, m_chunk_size);
         m_exec->reset_steal_target(m_team_size);
       }
-      if (std::is_same<typename TeamPolicyInternal<
+      if (!std::is_same<typename TeamPolicyInternal<
                            Kokkos::Threads, Properties...>::schedule_type::type,
-                       Kokkos::Dynamic>::value) {
+                       Kokkos::Static>::value) {
         m_exec->barrier();
       }
     } else {
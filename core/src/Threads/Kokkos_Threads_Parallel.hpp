@@ -127,7 +127,7 @@ class ParallelFor<FunctorType, Kokkos::RangePolicy<Traits...>,
 
   template <class Schedule>
   static typename std::enable_if<
-      std::is_same<Schedule, Kokkos::Dynamic>::value>::type
+      !std::is_same<Schedule, Kokkos::Static>::value>::type
   exec_schedule(ThreadsExec &exec, const void *arg) {
     const ParallelFor &self = *((const ParallelFor *)arg);
 
@@ -220,7 +220,7 @@ class ParallelFor<FunctorType, Kokkos::MDRangePolicy<Traits...>,
 
   template <class Schedule>
   static typename std::enable_if<
-      std::is_same<Schedule, Kokkos::Dynamic>::value>::type
+      !std::is_same<Schedule, Kokkos::Static>::value>::type
   exec_schedule(ThreadsExec &exec, const void *arg) {
     const ParallelFor &self = *((const ParallelFor *)arg);
 
@@ -299,7 +299,7 @@ class ParallelFor<FunctorType, Kokkos::TeamPolicy<Properties...>,
   template <class TagType, class Schedule>
   inline static typename std::enable_if<
       std::is_same<TagType, void>::value &&
-      std::is_same<Schedule, Kokkos::Dynamic>::value>::type
+      !std::is_same<Schedule, Kokkos::Static>::value>::type
   exec_team(const FunctorType &functor, Member member) {
     for (; member.valid_dynamic(); member.next_dynamic()) {
       functor(member);
@@ -309,7 +309,7 @@ class ParallelFor<FunctorType, Kokkos::TeamPolicy<Properties...>,
   template <class TagType, class Schedule>
   inline static typename std::enable_if<
       !std::is_same<TagType, void>::value &&
-      std::is_same<Schedule, Kokkos::Dynamic>::value>::type
+      !std::is_same<Schedule, Kokkos::Static>::value>::type
   exec_team(const FunctorType &functor, Member member) {
     const TagType t{};
     for (; member.valid_dynamic(); member.next_dynamic()) {
@@ -431,7 +431,7 @@ class ParallelReduce<FunctorType, Kokkos::RangePolicy<Traits...>, ReducerType,
 
   template <class Schedule>
   static typename std::enable_if<
-      std::is_same<Schedule, Kokkos::Dynamic>::value>::type
+      !std::is_same<Schedule, Kokkos::Static>::value>::type
   exec_schedule(ThreadsExec &exec, const void *arg) {
     const ParallelReduce &self = *((const ParallelReduce *)arg);
     const WorkRange range(self.m_policy, exec.pool_rank(), exec.pool_size());
@@ -592,7 +592,7 @@ class ParallelReduce<FunctorType, Kokkos::MDRangePolicy<Traits...>, ReducerType,
 
   template <class Schedule>
   static typename std::enable_if<
-      std::is_same<Schedule, Kokkos::Dynamic>::value>::type
+      !std::is_same<Schedule, Kokkos::Static>::value>::type
   exec_schedule(ThreadsExec &exec, const void *arg) {
     const ParallelReduce &self = *((const ParallelReduce *)arg);
     const WorkRange range(self.m_policy, exec.pool_rank(), exec.pool_size());
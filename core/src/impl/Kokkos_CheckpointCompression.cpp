@@ -0,0 +1,492 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <Kokkos_Core.hpp>
+#include <impl/Kokkos_CheckpointCompression.hpp>
+#include <impl/Kokkos_Error.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace Kokkos {
+namespace Impl {
+
+namespace {
+
+/* Chunks are coded independently; large enough for the LZ window to pay
+ * off, small enough to balance the host threads decompressing them.
+ */
+constexpr size_t checkpoint_chunk_target = size_t(1) << 18;
+
+constexpr uint32_t checkpoint_frame_magic = 0x315a434b;  // "KCZ1"
+
+struct CheckpointFrameHeader {
+  uint32_t magic;
+  uint32_t codec;
+  uint64_t bytes;
+  uint64_t element_size;
+  uint64_t chunk_bytes;
+  double error_bound;
+};
+
+/* First byte of every chunk */
+enum : unsigned char {
+  checkpoint_chunk_raw      = 0,
+  checkpoint_chunk_shuffle  = 1,
+  checkpoint_chunk_quantize = 2
+};
+
+size_t checkpoint_chunk_bytes(size_t element_size) {
+  return std::max<size_t>(1, checkpoint_chunk_target / element_size) *
+         element_size;
+}
+
+//----------------------------------------------------------------------------
+
+constexpr int lz_hash_bits        = 14;
+constexpr size_t lz_min_match     = 4;
+constexpr size_t lz_last_literals = 5;
+constexpr size_t lz_max_offset    = 65535;
+
+inline uint32_t lz_read32(const unsigned char* p) {
+  uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint64_t lz_read64(const unsigned char* p) {
+  uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint32_t lz_hash(uint32_t v) {
+  return (v * 2654435761u) >> (32 - lz_hash_bits);
+}
+
+/* Length beyond the 15 that fits in a token nibble */
+unsigned char* lz_put_length(unsigned char* op, size_t len) {
+  len -= 15;
+  while (len >= 255) {
+    *op++ = 255;
+    len -= 255;
+  }
+  *op++ = static_cast<unsigned char>(len);
+  return op;
+}
+
+bool lz_get_length(const unsigned char*& ip, const unsigned char* iend,
+                   size_t& len) {
+  unsigned char b;
+  do {
+    if (ip == iend) return false;
+    b = *ip++;
+    len += b;
+  } while (b == 255);
+  return true;
+}
+
+/* Literals followed by a match; the last sequence has no match */
+unsigned char* lz_put_sequence(unsigned char* op, const unsigned char* lit,
+                               size_t lit_len, size_t offset,
+                               size_t match_len) {
+  unsigned char* token = op++;
+  const size_t ml      = match_len == 0 ? 0 : match_len - lz_min_match;
+  *token = static_cast<unsigned char>((std::min<size_t>(lit_len, 15) << 4) |
+                                      std::min<size_t>(ml, 15));
+  if (lit_len >= 15) op = lz_put_length(op, lit_len);
+  std::memcpy(op, lit, lit_len);
+  op += lit_len;
+  if (match_len != 0) {
+    *op++ = static_cast<unsigned char>(offset & 0xff);
+    *op++ = static_cast<unsigned char>(offset >> 8);
+    if (ml >= 15) op = lz_put_length(op, ml);
+  }
+  return op;
+}
+
+//----------------------------------------------------------------------------
+
+template <class T>
+inline T checkpoint_dequantize(int64_t q, double step) {
+  return static_cast<T>(static_cast<double>(q) * step);
+}
+
+/* Zigzag coded deltas of the quantized values, shuffled into 'planes'.
+ * False if a value is not finite or would not be restored within the bound.
+ */
+template <class T>
+bool checkpoint_quantize(const unsigned char* src, size_t count,
+                         double error_bound,
+                         std::vector<unsigned char>& planes) {
+  const double step = 2 * error_bound;
+  std::vector<uint64_t> codes(count);
+  int64_t prev = 0;
+  for (size_t i = 0; i < count; ++i) {
+    T x;
+    std::memcpy(&x, src + i * sizeof(T), sizeof(T));
+    const double q = std::round(static_cast<double>(x) / step);
+    // Also rejects NaN and infinity
+    if (!(std::fabs(q) < 9.0e15)) return false;
+    const int64_t qi = static_cast<int64_t>(q);
+    const double restored =
+        static_cast<double>(checkpoint_dequantize<T>(qi, step));
+    if (!(std::fabs(restored - static_cast<double>(x)) <= error_bound)) {
+      return false;
+    }
+    const int64_t d = qi - prev;
+    prev            = qi;
+    codes[i] = (static_cast<uint64_t>(d) << 1) ^ static_cast<uint64_t>(d >> 63);
+  }
+  planes.resize(count * sizeof(uint64_t));
+  checkpoint_shuffle(reinterpret_cast<const unsigned char*>(codes.data()),
+                     count, sizeof(uint64_t), planes.data());
+  return true;
+}
+
+template <class T>
+void checkpoint_dequantize(const unsigned char* planes, size_t count,
+                           double error_bound, unsigned char* dst) {
+  const double step = 2 * error_bound;
+  std::vector<uint64_t> codes(count);
+  checkpoint_unshuffle(planes, count, sizeof(uint64_t),
+                       reinterpret_cast<unsigned char*>(codes.data()));
+  int64_t q = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const uint64_t z = codes[i];
+    q += static_cast<int64_t>((z >> 1) ^ (~(z & 1) + 1));
+    const T x = checkpoint_dequantize<T>(q, step);
+    std::memcpy(dst + i * sizeof(T), &x, sizeof(T));
+  }
+}
+
+void checkpoint_compress_chunk(const CheckpointCompressionInput& input,
+                               const unsigned char* src, size_t n,
+                               std::vector<unsigned char>& out) {
+  const size_t es    = input.element_size;
+  const size_t count = n / es;
+
+  std::vector<unsigned char> planes;
+  unsigned char mode = checkpoint_chunk_shuffle;
+  bool quantized     = false;
+  if (input.codec == checkpoint_codec_quantize_lz &&
+      (es == sizeof(double) || es == sizeof(float))) {
+    quantized = es == sizeof(double)
+                    ? checkpoint_quantize<double>(src, count,
+                                                  input.error_bound, planes)
+                    : checkpoint_quantize<float>(src, count,
+                                                 input.error_bound, planes);
+  }
+  if (quantized) {
+    mode = checkpoint_chunk_quantize;
+  } else {
+    planes.resize(n);
+    checkpoint_shuffle(src, count, es, planes.data());
+  }
+
+  out.resize(1 + checkpoint_lz_bound(planes.size()));
+  const size_t m =
+      checkpoint_lz_compress(planes.data(), planes.size(), out.data() + 1);
+  if (m < n) {
+    out[0] = mode;
+    out.resize(1 + m);
+  } else {
+    out.resize(1 + n);
+    out[0] = checkpoint_chunk_raw;
+    std::memcpy(out.data() + 1, src, n);
+  }
+}
+
+bool checkpoint_decompress_chunk(const CheckpointFrameHeader& header,
+                                 const unsigned char* in, size_t in_bytes,
+                                 unsigned char* dst, size_t n) {
+  if (in_bytes == 0) return false;
+  const unsigned char mode = in[0];
+  ++in;
+  --in_bytes;
+
+  const size_t es    = header.element_size;
+  const size_t count = n / es;
+
+  if (mode == checkpoint_chunk_raw) {
+    if (in_bytes != n) return false;
+    std::memcpy(dst, in, n);
+    return true;
+  }
+  if (mode == checkpoint_chunk_shuffle) {
+    std::vector<unsigned char> planes(n);
+    if (!checkpoint_lz_decompress(in, in_bytes, planes.data(), n)) {
+      return false;
+    }
+    checkpoint_unshuffle(planes.data(), count, es, dst);
+    return true;
+  }
+  if (mode == checkpoint_chunk_quantize &&
+      header.codec == checkpoint_codec_quantize_lz &&
+      (es == sizeof(double) || es == sizeof(float))) {
+    std::vector<unsigned char> planes(count * sizeof(uint64_t));
+    if (!checkpoint_lz_decompress(in, in_bytes, planes.data(),
+                                  planes.size())) {
+      return false;
+    }
+    if (es == sizeof(double)) {
+      checkpoint_dequantize<double>(planes.data(), count, header.error_bound,
+                                    dst);
+    } else {
+      checkpoint_dequantize<float>(planes.data(), count, header.error_bound,
+                                   dst);
+    }
+    return true;
+  }
+  return false;
+}
+
+void checkpoint_corrupt_frame() {
+  Kokkos::Impl::throw_runtime_exception(
+      "Kokkos::Experimental::CheckpointEngine: corrupt compressed data");
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------
+
+void checkpoint_shuffle(const unsigned char* in, size_t count,
+                        size_t element_size, unsigned char* out) {
+  for (size_t b = 0; b < element_size; ++b) {
+    unsigned char* plane = out + b * count;
+    for (size_t i = 0; i < count; ++i) plane[i] = in[i * element_size + b];
+  }
+}
+
+void checkpoint_unshuffle(const unsigned char* in, size_t count,
+                          size_t element_size, unsigned char* out) {
+  for (size_t b = 0; b < element_size; ++b) {
+    const unsigned char* plane = in + b * count;
+    for (size_t i = 0; i < count; ++i) out[i * element_size + b] = plane[i];
+  }
+}
+
+size_t checkpoint_lz_bound(size_t n) { return n + n / 255 + 16; }
+
+size_t checkpoint_lz_compress(const unsigned char* in, size_t n,
+                              unsigned char* out) {
+  unsigned char* op = out;
+  size_t anchor     = 0;
+
+  if (n > lz_min_match + lz_last_literals) {
+    // Matches stop short of the end so that the last sequence has literals.
+    const size_t match_limit = n - lz_last_literals;
+    const size_t ip_limit    = match_limit - lz_min_match;
+    std::vector<uint32_t> table(size_t(1) << lz_hash_bits, 0);
+
+    size_t ip = 0;
+    while (ip <= ip_limit) {
+      const uint32_t seq = lz_read32(in + ip);
+      const uint32_t h   = lz_hash(seq);
+      const size_t ref   = table[h];
+      table[h]           = static_cast<uint32_t>(ip);
+
+      if (ref < ip && ip - ref <= lz_max_offset &&
+          lz_read32(in + ref) == seq) {
+        size_t len = lz_min_match;
+        while (ip + len + 8 <= match_limit &&
+               lz_read64(in + ref + len) == lz_read64(in + ip + len)) {
+          len += 8;
+        }
+        while (ip + len < match_limit && in[ref + len] == in[ip + len]) ++len;
+
+        op     = lz_put_sequence(op, in + anchor, ip - anchor, ip - ref, len);
+        ip     = ip + len;
+        anchor = ip;
+      } else {
+        // Skip faster through data that does not compress
+        ip += 1 + ((ip - anchor) >> 6);
+      }
+    }
+  }
+
+  op = lz_put_sequence(op, in + anchor, n - anchor, 0, 0);
+  return op - out;
+}
+
+bool checkpoint_lz_decompress(const unsigned char* in, size_t n,
+                              unsigned char* out, size_t out_n) {
+  const unsigned char* ip         = in;
+  const unsigned char* const iend = in + n;
+  unsigned char* op               = out;
+  unsigned char* const oend       = out + out_n;
+
+  while (ip < iend) {
+    const unsigned token = *ip++;
+
+    size_t lit = token >> 4;
+    if (lit == 15 && !lz_get_length(ip, iend, lit)) return false;
+    if (size_t(iend - ip) < lit || size_t(oend - op) < lit) return false;
+    std::memcpy(op, ip, lit);
+    ip += lit;
+    op += lit;
+    if (ip == iend) break;
+
+    if (iend - ip < 2) return false;
+    const size_t offset = ip[0] | (size_t(ip[1]) << 8);
+    ip += 2;
+    size_t len = token & 15;
+    if (len == 15 && !lz_get_length(ip, iend, len)) return false;
+    len += lz_min_match;
+    if (offset == 0 || size_t(op - out) < offset || size_t(oend - op) < len) {
+      return false;
+    }
+
+    // Overlapping matches repeat the last 'offset' bytes; copy in spans that
+    // double each time so runs do not degrade to a byte loop.
+    size_t copied = 0;
+    size_t span   = offset;
+    while (copied < len) {
+      const size_t c = std::min(span, len - copied);
+      std::memcpy(op + copied, op + copied - span, c);
+      copied += c;
+      span = copied + offset;
+    }
+    op += len;
+  }
+  return op == oend;
+}
+
+//----------------------------------------------------------------------------
+
+void checkpoint_compress(const std::vector<CheckpointCompressionInput>& inputs,
+                         std::vector<unsigned char>& out,
+                         std::vector<size_t>& offsets,
+                         std::vector<size_t>& sizes) {
+  offsets.assign(inputs.size(), 0);
+  sizes.assign(inputs.size(), 0);
+
+  std::vector<unsigned char> packed;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const CheckpointCompressionInput& input = inputs[i];
+
+    CheckpointFrameHeader header;
+    header.magic        = checkpoint_frame_magic;
+    header.codec        = input.codec;
+    header.bytes        = input.bytes;
+    header.element_size = input.element_size;
+    header.chunk_bytes  = checkpoint_chunk_bytes(input.element_size);
+    header.error_bound  = input.error_bound;
+
+    const size_t num_chunks =
+        (input.bytes + header.chunk_bytes - 1) / header.chunk_bytes;
+
+    const size_t table = out.size() + sizeof(header);
+    offsets[i]         = out.size();
+    out.resize(table + num_chunks * sizeof(uint64_t));
+    std::memcpy(out.data() + offsets[i], &header, sizeof(header));
+
+    for (size_t k = 0; k < num_chunks; ++k) {
+      const size_t begin = k * header.chunk_bytes;
+      checkpoint_compress_chunk(
+          input, input.data + begin,
+          std::min<size_t>(header.chunk_bytes, input.bytes - begin), packed);
+      const uint64_t chunk_size = packed.size();
+      std::memcpy(out.data() + table + k * sizeof(uint64_t), &chunk_size,
+                  sizeof(chunk_size));
+      out.insert(out.end(), packed.begin(), packed.end());
+    }
+    sizes[i] = out.size() - offsets[i];
+  }
+}
+
+void checkpoint_decompress(const unsigned char* frame, size_t frame_bytes,
+                           unsigned char* out, size_t bytes) {
+  CheckpointFrameHeader header;
+  if (frame_bytes < sizeof(header)) checkpoint_corrupt_frame();
+  std::memcpy(&header, frame, sizeof(header));
+  if (header.magic != checkpoint_frame_magic || header.bytes != bytes ||
+      header.element_size == 0 || header.chunk_bytes == 0 ||
+      header.chunk_bytes % header.element_size != 0 ||
+      bytes % header.element_size != 0) {
+    checkpoint_corrupt_frame();
+  }
+
+  const size_t num_chunks = (bytes + header.chunk_bytes - 1) /
+                            header.chunk_bytes;
+  if ((frame_bytes - sizeof(header)) / sizeof(uint64_t) < num_chunks) {
+    checkpoint_corrupt_frame();
+  }
+
+  // Chunk payloads follow the table back to back
+  std::vector<size_t> begin(num_chunks + 1);
+  begin[0] = sizeof(header) + num_chunks * sizeof(uint64_t);
+  for (size_t k = 0; k < num_chunks; ++k) {
+    uint64_t chunk_size;
+    std::memcpy(&chunk_size, frame + sizeof(header) + k * sizeof(uint64_t),
+                sizeof(chunk_size));
+    if (chunk_size > frame_bytes - begin[k]) checkpoint_corrupt_frame();
+    begin[k + 1] = begin[k] + chunk_size;
+  }
+
+  typedef Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace,
+                              Kokkos::Schedule<Kokkos::Dynamic>,
+                              Kokkos::IndexType<size_t> >
+      policy_t;
+  size_t failed = 0;
+  Kokkos::parallel_reduce(
+      "Kokkos::Impl::checkpoint_decompress",
+      policy_t(0, num_chunks, Kokkos::ChunkSize(1)),
+      [&](const size_t k, size_t& err) {
+        const size_t first = k * header.chunk_bytes;
+        const size_t n = std::min<size_t>(header.chunk_bytes, bytes - first);
+        if (!checkpoint_decompress_chunk(header, frame + begin[k],
+                                         begin[k + 1] - begin[k], out + first,
+                                         n)) {
+          ++err;
+        }
+      },
+      failed);
+  if (failed != 0) checkpoint_corrupt_frame();
+}
+
+}  // namespace Impl
+}  // namespace Kokkos
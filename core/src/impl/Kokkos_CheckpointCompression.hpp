@@ -0,0 +1,112 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOS_CHECKPOINTCOMPRESSION_HPP
+#define KOKKOS_CHECKPOINTCOMPRESSION_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace Kokkos {
+namespace Impl {
+
+/* Codec of the frame a checkpointed View is stored in */
+enum CheckpointCodec : int {
+  checkpoint_codec_none = 0,
+  /* Bytes transposed by element, then LZ compressed */
+  checkpoint_codec_shuffle_lz = 1,
+  /* Floating point elements quantized to within an error bound and delta
+   * coded, then shuffled and LZ compressed
+   */
+  checkpoint_codec_quantize_lz = 2
+};
+
+/* A contiguous View to compress.  The quantizing codec requires float or
+ * double elements and a positive 'error_bound'.
+ */
+struct CheckpointCompressionInput {
+  const unsigned char* data;
+  size_t bytes;
+  size_t element_size;
+  CheckpointCodec codec;
+  double error_bound;
+};
+
+/** \brief  Compress every input into a frame appended to 'out'.
+ *
+ *  Frame i starts at out[offsets[i]] and is sizes[i] bytes long.  Inputs are
+ *  cut into independent chunks that are compressed in order on the calling
+ *  thread, which need not be able to launch kernels; a chunk that does not
+ *  shrink, or that the quantizer cannot represent within the error bound, is
+ *  stored as is.
+ */
+void checkpoint_compress(const std::vector<CheckpointCompressionInput>& inputs,
+                         std::vector<unsigned char>& out,
+                         std::vector<size_t>& offsets,
+                         std::vector<size_t>& sizes);
+
+/** \brief  Decode a frame into the 'bytes' bytes at 'out'.  Throws if the
+ *          frame is corrupt or does not hold 'bytes' bytes.
+ */
+void checkpoint_decompress(const unsigned char* frame, size_t frame_bytes,
+                           unsigned char* out, size_t bytes);
+
+/* Transpose 'count' elements of 'element_size' bytes into byte planes */
+void checkpoint_shuffle(const unsigned char* in, size_t count,
+                        size_t element_size, unsigned char* out);
+void checkpoint_unshuffle(const unsigned char* in, size_t count,
+                          size_t element_size, unsigned char* out);
+
+/* LZ77 with LZ4 style sequences; inputs must be smaller than 4 GiB */
+size_t checkpoint_lz_bound(size_t n);
+size_t checkpoint_lz_compress(const unsigned char* in, size_t n,
+                              unsigned char* out);
+/* False unless 'in' decodes to exactly 'out_n' bytes */
+bool checkpoint_lz_decompress(const unsigned char* in, size_t n,
+                              unsigned char* out, size_t out_n);
+
+}  // namespace Impl
+}  // namespace Kokkos
+
+#endif  // KOKKOS_CHECKPOINTCOMPRESSION_HPP
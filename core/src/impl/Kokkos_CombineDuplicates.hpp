@@ -0,0 +1,100 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOS_COMBINE_DUPLICATES_HPP
+#define KOKKOS_COMBINE_DUPLICATES_HPP
+
+/** @file Kokkos_CombineDuplicates.hpp
+ *
+ *  Parallel launch of the duplicate vote.  Kokkos_TrackDuplicates.hpp is
+ *  included with the shared allocation records, ahead of the parallel
+ *  patterns, so the launch is defined here.
+ */
+
+#include <Kokkos_Core.hpp>
+#include <impl/Kokkos_TrackDuplicates.hpp>
+
+namespace Kokkos {
+namespace Experimental {
+
+template <class DType, class ExecSpace>
+inline typename CombineFunctor<DType, ExecSpace>::value_type
+CombineFunctor<DType, ExecSpace>::combine() const {
+  value_type counts;
+  init(counts);
+  if (m_len) {
+    const size_t blocks = (m_len + block_size - 1) / block_size;
+    Kokkos::parallel_reduce(
+        "Kokkos::Experimental::CombineFunctor",
+        Kokkos::RangePolicy<ExecSpace, Kokkos::IndexType<size_t>>(0, blocks),
+        *this, counts);
+  }
+  return counts;
+}
+
+template <class Type, class ExecutionSpace>
+void SpecDuplicateTracker<Type, ExecutionSpace>::combine_dups() {
+  // Launches sampled out or replicated once have nothing to combine.
+  if (dup_cnt < 2) return;
+
+  // Two duplicates are voted as (d0, d1, d1): the second copy wins and
+  // every disagreement is a mismatch without majority.
+  rd_type* const last = static_cast<rd_type*>(dup_list[dup_cnt < 3 ? 1 : 2]);
+
+  m_cf.load_ptrs(static_cast<rd_type*>(original_data),
+                 static_cast<rd_type*>(dup_list[0]),
+                 static_cast<rd_type*>(dup_list[1]), last,
+                 size_t(data_len) / sizeof(rd_type));
+
+  const DuplicateVoteCounts counts = m_cf.combine();
+
+  voted_elements += m_cf.m_len;
+  mismatched_elements += counts.mismatches;
+  unresolved_elements += dup_cnt < 3 ? counts.mismatches : counts.unresolved;
+}
+
+}  // namespace Experimental
+}  // namespace Kokkos
+
+#endif  // KOKKOS_COMBINE_DUPLICATES_HPP
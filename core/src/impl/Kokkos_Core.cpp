@@ -44,6 +44,9 @@
 
 #include <Kokkos_Core.hpp>
 #include <impl/Kokkos_Error.hpp>
+#include <impl/Kokkos_HostBarrier.hpp>
+#include <impl/Kokkos_HostSpaceCache.hpp>
+#include <impl/Kokkos_Spinwait.hpp>
 #include <cctype>
 #include <cstring>
 #include <iostream>
@@ -53,6 +56,7 @@
 #include <functional>
 #include <list>
 #include <cerrno>
+#include <climits>
 #ifndef _WIN32
 #include <unistd.h>
 #endif
@@ -390,6 +394,18 @@ void initialize_profiling(const InitArguments&) {
 
 void pre_initialize_internal(const InitArguments& args) {
   if (args.disable_warnings) g_show_warnings = false;
+  if (args.hugepage_threshold >= 0) {
+    Impl::set_host_space_huge_page_threshold(args.hugepage_threshold);
+  }
+  if (args.host_cache >= 0) {
+    Impl::HostSpaceCache::set_high_water(size_t(args.host_cache) << 20);
+  }
+  if (args.barrier_fan_in >= 0) {
+    Impl::HostBarrier::set_fan_in(args.barrier_fan_in);
+  }
+  if (args.wait_policy >= 0) {
+    Impl::set_host_wait_policy(Impl::WaitPolicy(args.wait_policy));
+  }
 }
 
 void post_initialize_internal(const InitArguments& args) {
@@ -431,6 +447,8 @@ void finalize_internal(const bool all_spaces = false) {
     ++numSuccessfulCalls;
   }
 
+  Impl::report_host_wait_statistics();
+
 #if defined(KOKKOS_ENABLE_PROFILING)
   Kokkos::Profiling::finalize();
 #endif
@@ -519,6 +537,8 @@ void finalize_internal(const bool all_spaces = false) {
 #endif
 #endif
 
+  Impl::HostSpaceCache::release();
+
   g_is_initialized = false;
   g_show_warnings  = true;
 }
@@ -588,6 +608,29 @@ bool check_int_arg(char const* arg, char const* expected, int* value) {
   return true;
 }
 
+// The names accepted for --kokkos-wait-policy and KOKKOS_WAIT_POLICY, in the
+// order of Impl::WaitPolicy
+int wait_policy_index(char const* name, char const* source) {
+  char const* const names[] = {"active", "passive", "hybrid"};
+  for (int i = 0; i < 3; ++i) {
+    if (std::strcmp(name, names[i]) == 0) return i;
+  }
+  std::ostringstream ss;
+  ss << "Error: expecting active, passive or hybrid for '" << source << "'";
+  ss << ". Raised by Kokkos::initialize(int narg, char* argc[]).";
+  Impl::throw_runtime_exception(ss.str());
+  return -1;
+}
+
+bool check_wait_policy_arg(char const* arg, int* value) {
+  char const* const expected = "--kokkos-wait-policy";
+  if (!check_arg(arg, expected)) return false;
+  const std::size_t exp_len = std::strlen(expected);
+  *value = wait_policy_index(arg[exp_len] == '=' ? arg + exp_len + 1 : "",
+                             expected);
+  return true;
+}
+
 void warn_deprecated_command_line_argument(std::string deprecated,
                                            std::string valid) {
   std::cerr
@@ -613,6 +656,10 @@ void parse_command_line_arguments(int& narg, char* arg[],
   auto& ndevices         = arguments.ndevices;
   auto& skip_device      = arguments.skip_device;
   auto& disable_warnings = arguments.disable_warnings;
+  auto& hugepage         = arguments.hugepage_threshold;
+  auto& host_cache       = arguments.host_cache;
+  auto& barrier_fan_in   = arguments.barrier_fan_in;
+  auto& wait_policy      = arguments.wait_policy;
 
   int kokkos_threads_found  = 0;
   int kokkos_numa_found     = 0;
@@ -721,6 +768,28 @@ void parse_command_line_arguments(int& narg, char* arg[],
       } else {
         iarg++;
       }
+    } else if (check_int_arg(arg[iarg], "--kokkos-hugepage-threshold",
+                             &hugepage)) {
+      for (int k = iarg; k < narg - 1; k++) {
+        arg[k] = arg[k + 1];
+      }
+      narg--;
+    } else if (check_int_arg(arg[iarg], "--kokkos-host-cache", &host_cache)) {
+      for (int k = iarg; k < narg - 1; k++) {
+        arg[k] = arg[k + 1];
+      }
+      narg--;
+    } else if (check_int_arg(arg[iarg], "--kokkos-barrier-fan-in",
+                             &barrier_fan_in)) {
+      for (int k = iarg; k < narg - 1; k++) {
+        arg[k] = arg[k + 1];
+      }
+      narg--;
+    } else if (check_wait_policy_arg(arg[iarg], &wait_policy)) {
+      for (int k = iarg; k < narg - 1; k++) {
+        arg[k] = arg[k + 1];
+      }
+      narg--;
     } else if (check_arg(arg[iarg], "--kokkos-disable-warnings")) {
       disable_warnings = true;
       for (int k = iarg; k < narg - 1; k++) {
@@ -754,6 +823,19 @@ void parse_command_line_arguments(int& narg, char* arg[],
                                        to be ignored. This is most useful on workstations
                                        with multiple GPUs of which one is used to drive
                                        screen output.
+      --kokkos-hugepage-threshold=INT: allocate HostSpace memory of at least
+                                       INT bytes from huge pages, 0 disables.
+      --kokkos-host-cache=INT        : keep up to INT MiB of freed HostSpace
+                                       allocations for reuse, 0 disables.
+      --kokkos-barrier-fan-in=INT    : combine host thread barrier arrivals
+                                       in a tree of fan-in INT, 0 selects
+                                       the centralized barrier. Chosen from
+                                       the hwloc topology by default, or
+                                       centralized without hwloc.
+      --kokkos-wait-policy=STRING    : how idle host threads wait between
+                                       kernels: active spins, passive sleeps,
+                                       hybrid (default) spins briefly and
+                                       then sleeps.
       --------------------------------------------------------------------------------
 )";
       std::cout << help_message << std::endl;
@@ -779,6 +861,10 @@ void parse_environment_variables(InitArguments& arguments) {
   auto& ndevices         = arguments.ndevices;
   auto& skip_device      = arguments.skip_device;
   auto& disable_warnings = arguments.disable_warnings;
+  auto& hugepage         = arguments.hugepage_threshold;
+  auto& host_cache       = arguments.host_cache;
+  auto& barrier_fan_in   = arguments.barrier_fan_in;
+  auto& wait_policy      = arguments.wait_policy;
 
   char* endptr;
   auto env_num_threads_str = std::getenv("KOKKOS_NUM_THREADS");
@@ -821,6 +907,80 @@ void parse_environment_variables(InitArguments& arguments) {
     else
       numa = env_numa;
   }
+  auto env_hugepage_str = std::getenv("KOKKOS_HUGEPAGE_THRESHOLD");
+  if (env_hugepage_str != nullptr) {
+    errno             = 0;
+    auto env_hugepage = std::strtol(env_hugepage_str, &endptr, 10);
+    if (endptr == env_hugepage_str)
+      Impl::throw_runtime_exception(
+          "Error: cannot convert KOKKOS_HUGEPAGE_THRESHOLD to an integer. "
+          "Raised by Kokkos::initialize(int narg, char* argc[]).");
+    if (errno == ERANGE || env_hugepage < 0 || env_hugepage > INT_MAX)
+      Impl::throw_runtime_exception(
+          "Error: KOKKOS_HUGEPAGE_THRESHOLD out of range of representable "
+          "values by an integer. Raised by Kokkos::initialize(int narg, char* "
+          "argc[]).");
+    if ((hugepage != -1) && (env_hugepage != hugepage))
+      Impl::throw_runtime_exception(
+          "Error: expecting a match between --kokkos-hugepage-threshold and "
+          "KOKKOS_HUGEPAGE_THRESHOLD if both are set. Raised by "
+          "Kokkos::initialize(int narg, char* argc[]).");
+    else
+      hugepage = env_hugepage;
+  }
+  auto env_host_cache_str = std::getenv("KOKKOS_HOST_CACHE");
+  if (env_host_cache_str != nullptr) {
+    errno               = 0;
+    auto env_host_cache = std::strtol(env_host_cache_str, &endptr, 10);
+    if (endptr == env_host_cache_str)
+      Impl::throw_runtime_exception(
+          "Error: cannot convert KOKKOS_HOST_CACHE to an integer. Raised by "
+          "Kokkos::initialize(int narg, char* argc[]).");
+    if (errno == ERANGE || env_host_cache < 0 || env_host_cache > INT_MAX)
+      Impl::throw_runtime_exception(
+          "Error: KOKKOS_HOST_CACHE out of range of representable values by "
+          "an integer. Raised by Kokkos::initialize(int narg, char* argc[]).");
+    if ((host_cache != -1) && (env_host_cache != host_cache))
+      Impl::throw_runtime_exception(
+          "Error: expecting a match between --kokkos-host-cache and "
+          "KOKKOS_HOST_CACHE if both are set. Raised by "
+          "Kokkos::initialize(int narg, char* argc[]).");
+    else
+      host_cache = env_host_cache;
+  }
+  auto env_fan_in_str = std::getenv("KOKKOS_BARRIER_FAN_IN");
+  if (env_fan_in_str != nullptr) {
+    errno           = 0;
+    auto env_fan_in = std::strtol(env_fan_in_str, &endptr, 10);
+    if (endptr == env_fan_in_str)
+      Impl::throw_runtime_exception(
+          "Error: cannot convert KOKKOS_BARRIER_FAN_IN to an integer. Raised "
+          "by Kokkos::initialize(int narg, char* argc[]).");
+    if (errno == ERANGE || env_fan_in < 0 || env_fan_in > INT_MAX)
+      Impl::throw_runtime_exception(
+          "Error: KOKKOS_BARRIER_FAN_IN out of range of representable values "
+          "by an integer. Raised by Kokkos::initialize(int narg, char* "
+          "argc[]).");
+    if ((barrier_fan_in != -1) && (env_fan_in != barrier_fan_in))
+      Impl::throw_runtime_exception(
+          "Error: expecting a match between --kokkos-barrier-fan-in and "
+          "KOKKOS_BARRIER_FAN_IN if both are set. Raised by "
+          "Kokkos::initialize(int narg, char* argc[]).");
+    else
+      barrier_fan_in = env_fan_in;
+  }
+  auto env_wait_policy_str = std::getenv("KOKKOS_WAIT_POLICY");
+  if (env_wait_policy_str != nullptr) {
+    auto env_wait_policy =
+        wait_policy_index(env_wait_policy_str, "KOKKOS_WAIT_POLICY");
+    if ((wait_policy != -1) && (env_wait_policy != wait_policy))
+      Impl::throw_runtime_exception(
+          "Error: expecting a match between --kokkos-wait-policy and "
+          "KOKKOS_WAIT_POLICY if both are set. Raised by "
+          "Kokkos::initialize(int narg, char* argc[]).");
+    else
+      wait_policy = env_wait_policy;
+  }
   auto env_device_str = std::getenv("KOKKOS_DEVICE_ID");
   if (env_device_str != nullptr) {
     errno           = 0;
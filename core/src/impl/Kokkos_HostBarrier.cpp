@@ -44,11 +44,14 @@
 
 #include <Kokkos_Macros.hpp>
 
+#include <Kokkos_hwloc.hpp>
 #include <impl/Kokkos_HostBarrier.hpp>
 #include <impl/Kokkos_BitOps.hpp>
 
 #include <impl/Kokkos_HostBarrier.hpp>
 
+#include <atomic>
+
 #if !defined(_WIN32)
 #include <sched.h>
 #include <time.h>
@@ -61,6 +64,52 @@
 namespace Kokkos {
 namespace Impl {
 
+namespace {
+
+std::atomic<int> s_fan_in(-1);
+
+// Leaves hold whole cores and do not straddle NUMA domains when the threads
+// are ordered by topology: the largest fan-in up to eight that divides the
+// threads per NUMA domain and is a multiple of the threads per core. Without
+// a known topology the centralized counter is kept.
+int topology_fan_in() {
+  if (!Kokkos::hwloc::available()) return 0;
+  const int per_core = Kokkos::hwloc::get_available_threads_per_core();
+  const int per_numa =
+      per_core * int(Kokkos::hwloc::get_available_cores_per_numa());
+  for (int fan_in = 8; fan_in >= 2; --fan_in) {
+    if (per_numa % fan_in == 0 && fan_in % per_core == 0) return fan_in;
+  }
+  return 4;
+}
+
+int tree_nodes(int count, const int fan_in) {
+  int nodes = 0;
+  while (count > 1) {
+    count = (count + fan_in - 1) / fan_in;
+    nodes += count;
+  }
+  return nodes;
+}
+
+}  // namespace
+
+int HostBarrier::fan_in() noexcept {
+  return s_fan_in.load(std::memory_order_relaxed);
+}
+
+void HostBarrier::set_fan_in(const int fan_in) noexcept {
+  s_fan_in.store(fan_in, std::memory_order_relaxed);
+}
+
+int HostBarrier::fan_in(const int size) noexcept {
+  int fan_in = s_fan_in.load(std::memory_order_relaxed);
+  if (fan_in < 0) fan_in = topology_fan_in();
+  if (fan_in < 2 || size <= fan_in) return 0;
+  while (tree_nodes(size, fan_in) > max_tree_nodes) ++fan_in;
+  return fan_in;
+}
+
 void HostBarrier::impl_backoff_wait_until_equal(
     int* ptr, const int v, const bool active_wait) noexcept {
 #if !defined(_WIN32)
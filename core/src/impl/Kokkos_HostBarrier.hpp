@@ -74,10 +74,17 @@ namespace Impl {
 //
 // If all threads have arrived (and split_release has been call if using
 // split_arrive) before a wait type call, the wait may return quickly
+//
+// The arrive functions taking a *rank* and a *fan_in* combine arrivals up a
+// tree instead of counting them on a single atomic, so that at most fan_in
+// threads update any one cache line. Consecutive ranks share a node, which
+// keeps the leaves within a core or NUMA domain when threads are ordered by
+// topology. A fan_in of zero uses the centralized counter. Every thread
+// sharing a buffer must use the same fan_in.
 class HostBarrier {
  public:
   using buffer_type                         = int;
-  static constexpr int required_buffer_size = 128;
+  static constexpr int required_buffer_size = 4096;
   static constexpr int required_buffer_length =
       required_buffer_size / sizeof(int);
 
@@ -89,6 +96,13 @@ class HostBarrier {
   static constexpr int master_idx = 64 / sizeof(int);
   static constexpr int wait_idx   = 96 / sizeof(int);
 
+  // the tree nodes follow, one counter per cache line
+  static constexpr int node_idx    = 128 / sizeof(int);
+  static constexpr int node_length = 64 / sizeof(int);
+
+ public:
+  static constexpr int max_tree_nodes = (required_buffer_size - 128) / 64;
+
   static constexpr int num_nops                   = 32;
   static constexpr int iterations_till_backoff    = 64;
   static constexpr int log2_iterations_till_yield = 4;
@@ -125,6 +139,64 @@ class HostBarrier {
     Kokkos::atomic_fetch_add(buffer + wait_idx, 1);
   }
 
+  // will return true if call is the last thread to arrive at the root
+  static bool split_arrive(int* buffer, const int size, const int rank,
+                           const int fan_in, int& step,
+                           const bool master_wait = true) noexcept {
+    if (fan_in == 0) return split_arrive(buffer, size, step, master_wait);
+
+    ++step;
+    Kokkos::memory_fence();
+
+    // The last thread to arrive at a node resets it and moves up a level.
+    // Nobody arrives at the node again before the root releases.
+    int* level = buffer + node_idx;
+    for (int index = rank, count = size; count > 1;) {
+      const int parents = (count + fan_in - 1) / fan_in;
+      const int first   = index - index % fan_in;
+      const int members = count - first < fan_in ? count - first : fan_in;
+      if (members > 1) {
+        int* const node = level + (index / fan_in) * node_length;
+        if (Kokkos::atomic_fetch_add(node, 1) != members - 1) return false;
+        Kokkos::atomic_fetch_sub(node, members);
+      }
+      level += parents * node_length;
+      index /= fan_in;
+      count = parents;
+    }
+
+    if (master_wait) {
+      Kokkos::atomic_fetch_add(buffer + master_idx, 1);
+    }
+
+    return true;
+  }
+
+  static void split_release(int* buffer, const int size, const int fan_in,
+                            const int step) noexcept {
+    if (fan_in == 0) return split_release(buffer, size, step);
+    Kokkos::memory_fence();
+    Kokkos::atomic_fetch_add(buffer + wait_idx, 1);
+  }
+
+  static void arrive(int* buffer, const int size, const int rank,
+                     const int fan_in, int& step) noexcept {
+    if (size <= 1) return;
+    if (split_arrive(buffer, size, rank, fan_in, step)) {
+      split_release(buffer, size, fan_in, step);
+    }
+  }
+
+  // The fan_in to use for a barrier among size threads: zero if the
+  // centralized counter is selected or size threads fit in one node,
+  // otherwise the selected fan-in, raised until the tree fits the buffer
+  static int fan_in(const int size) noexcept;
+
+  // The selected fan-in, zero or one for the centralized counter and
+  // negative to choose from the hwloc topology
+  static int fan_in() noexcept;
+  static void set_fan_in(int fan_in) noexcept;
+
   // should only be called by the master thread, will allow the master thread to
   // resume after all threads have arrived
   KOKKOS_INLINE_FUNCTION
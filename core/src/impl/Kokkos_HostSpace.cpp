@@ -46,6 +46,7 @@
 #include <algorithm>
 #include <Kokkos_Macros.hpp>
 #include <impl/Kokkos_Error.hpp>
+#include <impl/Kokkos_HostSpaceCache.hpp>
 #include <impl/Kokkos_MemorySpace.hpp>
 #if defined(KOKKOS_ENABLE_PROFILING)
 #include <impl/Kokkos_Profiling_Interface.hpp>
@@ -91,12 +92,29 @@
 
 /*--------------------------------------------------------------------------*/
 
+#if defined(__linux__)
+
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#if defined(MADV_HUGEPAGE) && defined(MAP_ANONYMOUS)
+#define KOKKOS_IMPL_HOST_HUGE_PAGES
+#endif
+
+#endif
+
+/*--------------------------------------------------------------------------*/
+
 #include <cstddef>
 #include <cstdlib>
 #include <cstdint>
 #include <cstring>
 
+#include <atomic>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <cstring>
 
@@ -113,6 +131,77 @@
 //----------------------------------------------------------------------------
 
 namespace Kokkos {
+namespace {
+
+size_t g_huge_page_threshold = 0;
+
+#if defined(KOKKOS_IMPL_HOST_HUGE_PAGES)
+
+/* Default huge page size from /proc/meminfo, 2 MiB if unknown */
+size_t huge_page_size() {
+  static const size_t size = []() {
+    size_t kib = 0;
+    if (FILE *const meminfo = fopen("/proc/meminfo", "r")) {
+      char line[128];
+      while (fgets(line, sizeof(line), meminfo)) {
+        if (sscanf(line, "Hugepagesize: %zu kB", &kib) == 1) break;
+      }
+      fclose(meminfo);
+    }
+    return kib ? kib * 1024 : size_t(1) << 21;
+  }();
+  return size;
+}
+
+size_t huge_page_span(const size_t size) {
+  const size_t page = huge_page_size();
+  return (size + page - 1) & ~(page - 1);
+}
+
+void *huge_page_allocate(const size_t size) {
+  constexpr int prot  = PROT_READ | PROT_WRITE;
+  constexpr int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+  const size_t page  = huge_page_size();
+  const size_t bytes = huge_page_span(size);
+
+#if defined(MAP_HUGETLB) && !defined(KOKKOS_ENABLE_CUDA)
+  // Reserved hugetlb pages fail the mmap rather than fault later
+  void *ptr = mmap(nullptr, bytes, prot, flags | MAP_HUGETLB, -1, 0);
+  if (ptr != MAP_FAILED) return ptr;
+#endif
+
+  // Transparent huge pages need a huge page aligned range
+  void *const map = mmap(nullptr, bytes + page, prot, flags, -1, 0);
+  if (map == MAP_FAILED) return nullptr;
+
+  const uintptr_t base  = reinterpret_cast<uintptr_t>(map);
+  const uintptr_t begin = (base + page - 1) & ~uintptr_t(page - 1);
+  const uintptr_t end   = begin + bytes;
+
+  if (base < begin) munmap(map, begin - base);
+  if (end < base + bytes + page) {
+    munmap(reinterpret_cast<void *>(end), base + bytes + page - end);
+  }
+
+  madvise(reinterpret_cast<void *>(begin), bytes, MADV_HUGEPAGE);
+
+  return reinterpret_cast<void *>(begin);
+}
+
+#endif
+
+}  // namespace
+
+namespace Impl {
+
+size_t host_space_huge_page_threshold() { return g_huge_page_threshold; }
+
+void set_host_space_huge_page_threshold(size_t threshold) {
+  g_huge_page_threshold = threshold;
+}
+
+}  // namespace Impl
 
 /* Default allocation mechanism */
 HostSpace::HostSpace()
@@ -126,12 +215,19 @@ HostSpace::HostSpace()
 #else
           HostSpace::STD_MALLOC
 #endif
-      ) {
+          ),
+      m_huge_page_threshold(0) {
+#if defined(KOKKOS_IMPL_HOST_HUGE_PAGES)
+  if (g_huge_page_threshold) {
+    m_alloc_mech          = HostSpace::HUGE_PAGES;
+    m_huge_page_threshold = g_huge_page_threshold;
+  }
+#endif
 }
 
 /* Default allocation mechanism */
 HostSpace::HostSpace(const HostSpace::AllocationMechanism &arg_alloc_mech)
-    : m_alloc_mech(HostSpace::STD_MALLOC) {
+    : m_alloc_mech(HostSpace::STD_MALLOC), m_huge_page_threshold(0) {
   if (arg_alloc_mech == STD_MALLOC) {
     m_alloc_mech = HostSpace::STD_MALLOC;
   }
@@ -147,6 +243,14 @@ HostSpace::HostSpace(const HostSpace::AllocationMechanism &arg_alloc_mech)
   else if (arg_alloc_mech == HostSpace::POSIX_MMAP) {
     m_alloc_mech = HostSpace::POSIX_MMAP;
   }
+#endif
+#if defined(KOKKOS_IMPL_HOST_HUGE_PAGES)
+  else if (arg_alloc_mech == HostSpace::HUGE_PAGES) {
+    m_alloc_mech = HostSpace::HUGE_PAGES;
+    // Without a threshold anything smaller than a huge page uses malloc
+    m_huge_page_threshold =
+        g_huge_page_threshold ? g_huge_page_threshold : huge_page_size();
+  }
 #endif
   else {
     const char *const mech =
@@ -154,8 +258,11 @@ HostSpace::HostSpace(const HostSpace::AllocationMechanism &arg_alloc_mech)
             ? "INTEL_MM_ALLOC"
             : ((arg_alloc_mech == HostSpace::POSIX_MEMALIGN)
                    ? "POSIX_MEMALIGN"
-                   : ((arg_alloc_mech == HostSpace::POSIX_MMAP) ? "POSIX_MMAP"
-                                                                : ""));
+                   : ((arg_alloc_mech == HostSpace::POSIX_MMAP)
+                          ? "POSIX_MMAP"
+                          : ((arg_alloc_mech == HostSpace::HUGE_PAGES)
+                                 ? "HUGE_PAGES"
+                                 : "")));
 
     std::string msg;
     msg.append("Kokkos::HostSpace ");
@@ -179,7 +286,9 @@ void *HostSpace::allocate(const size_t arg_alloc_size) const {
   void *ptr = nullptr;
 
   if (arg_alloc_size) {
-    if (m_alloc_mech == STD_MALLOC) {
+    if (m_alloc_mech == STD_MALLOC ||
+        (m_alloc_mech == HUGE_PAGES &&
+         arg_alloc_size < m_huge_page_threshold)) {
       // Over-allocate to and round up to guarantee proper alignment.
       size_t size_padded = arg_alloc_size + sizeof(void *) + alignment;
 
@@ -240,6 +349,12 @@ void *HostSpace::allocate(const size_t arg_alloc_size) const {
       */
     }
 #endif
+
+#if defined(KOKKOS_IMPL_HOST_HUGE_PAGES)
+    else if (m_alloc_mech == HUGE_PAGES) {
+      ptr = huge_page_allocate(arg_alloc_size);
+    }
+#endif
   }
 
   if ((ptr == nullptr) || (reinterpret_cast<uintptr_t>(ptr) == ~uintptr_t(0)) ||
@@ -269,6 +384,12 @@ void *HostSpace::allocate(const size_t arg_alloc_size) const {
         alloc_mec = Experimental::RawMemoryAllocationFailure::
             AllocationMechanism::IntelMMAlloc;
         break;
+      case HUGE_PAGES:
+        if (arg_alloc_size >= m_huge_page_threshold) {
+          alloc_mec = Experimental::RawMemoryAllocationFailure::
+              AllocationMechanism::PosixMMapHugePages;
+        }
+        break;
     }
 
     throw Kokkos::Experimental::RawMemoryAllocationFailure(
@@ -279,12 +400,18 @@ void *HostSpace::allocate(const size_t arg_alloc_size) const {
 }
 
 void HostSpace::deallocate(void *const arg_alloc_ptr, const size_t
-#if defined(KOKKOS_IMPL_POSIX_MMAP_FLAGS)
+#if defined(KOKKOS_IMPL_POSIX_MMAP_FLAGS) || \
+    defined(KOKKOS_IMPL_HOST_HUGE_PAGES)
                                                           arg_alloc_size
 #endif
                            ) const {
   if (arg_alloc_ptr) {
-    if (m_alloc_mech == STD_MALLOC) {
+    if (m_alloc_mech == STD_MALLOC
+#if defined(KOKKOS_IMPL_HOST_HUGE_PAGES)
+        || (m_alloc_mech == HUGE_PAGES &&
+            arg_alloc_size < m_huge_page_threshold)
+#endif
+    ) {
       void *alloc_ptr = *(reinterpret_cast<void **>(arg_alloc_ptr) - 1);
       free(alloc_ptr);
     }
@@ -305,6 +432,12 @@ void HostSpace::deallocate(void *const arg_alloc_ptr, const size_t
       munmap(arg_alloc_ptr, arg_alloc_size);
     }
 #endif
+
+#if defined(KOKKOS_IMPL_HOST_HUGE_PAGES)
+    else if (m_alloc_mech == HUGE_PAGES) {
+      munmap(arg_alloc_ptr, huge_page_span(arg_alloc_size));
+    }
+#endif
   }
 }
 
@@ -340,8 +473,17 @@ SharedAllocationRecord<Kokkos::HostSpace, void>::~SharedAllocationRecord()
   }
 #endif
 
-  m_space.deallocate(SharedAllocationRecord<void, void>::m_alloc_ptr,
-                     SharedAllocationRecord<void, void>::m_alloc_size);
+  host_space_numa_release(SharedAllocationRecord<void, void>::m_alloc_ptr,
+                          SharedAllocationRecord<void, void>::m_alloc_size);
+
+  if (m_cache_bytes) {
+    HostSpaceCache::deallocate(m_space,
+                               SharedAllocationRecord<void, void>::m_alloc_ptr,
+                               m_cache_bytes);
+  } else {
+    m_space.deallocate(SharedAllocationRecord<void, void>::m_alloc_ptr,
+                       SharedAllocationRecord<void, void>::m_alloc_size);
+  }
 }
 
 SharedAllocationHeader *_do_allocation(Kokkos::HostSpace const &space,
@@ -366,20 +508,51 @@ SharedAllocationHeader *_do_allocation(Kokkos::HostSpace const &space,
   return nullptr;  // unreachable
 }
 
+namespace {
+
+/* Allocates the size class of a cached record instead of its exact size */
+struct HostSpaceCacheAllocation {
+  Kokkos::HostSpace const &space;
+  size_t class_bytes;
+
+  void *allocate(size_t) const {
+    return HostSpaceCache::allocate(space, class_bytes);
+  }
+
+  static constexpr const char *name() { return Kokkos::HostSpace::name(); }
+};
+
+}  // namespace
+
 SharedAllocationRecord<Kokkos::HostSpace, void>::SharedAllocationRecord(
     const Kokkos::HostSpace &arg_space, const std::string &arg_label,
     const size_t arg_alloc_size,
     const SharedAllocationRecord<void, void>::function_type arg_dealloc)
+    : SharedAllocationRecord(
+          arg_space, arg_label, arg_alloc_size, arg_dealloc,
+          HostSpaceCache::class_bytes(
+              arg_space, sizeof(SharedAllocationHeader) + arg_alloc_size)) {}
+
+SharedAllocationRecord<Kokkos::HostSpace, void>::SharedAllocationRecord(
+    const Kokkos::HostSpace &arg_space, const std::string &arg_label,
+    const size_t arg_alloc_size,
+    const SharedAllocationRecord<void, void>::function_type arg_dealloc,
+    const size_t arg_cache_bytes)
     // Pass through allocated [ SharedAllocationHeader , user_memory ]
     // Pass through deallocation function
     : SharedAllocationRecord<void, void>(
 #ifdef KOKKOS_DEBUG
           &SharedAllocationRecord<Kokkos::HostSpace, void>::s_root_record,
 #endif
-          Impl::checked_allocation_with_header(arg_space, arg_label,
-                                               arg_alloc_size),
+          arg_cache_bytes
+              ? Impl::checked_allocation_with_header(
+                    HostSpaceCacheAllocation{arg_space, arg_cache_bytes},
+                    arg_label, arg_alloc_size)
+              : Impl::checked_allocation_with_header(arg_space, arg_label,
+                                                     arg_alloc_size),
           sizeof(SharedAllocationHeader) + arg_alloc_size, arg_dealloc),
-      m_space(arg_space) {
+      m_space(arg_space),
+      m_cache_bytes(arg_cache_bytes) {
 #if defined(KOKKOS_ENABLE_PROFILING)
   if (Kokkos::Profiling::profileLibraryLoaded()) {
     Kokkos::Profiling::allocateData(
@@ -546,5 +719,119 @@ void unlock_address_host_space(void *ptr) {
 #endif
 }
 
+#if defined(__linux__) && defined(SYS_mbind)
+namespace {
+
+// Page ranges bound with MPOL_INTERLEAVE. The policy belongs to the address
+// range rather than to the View, so it is reset when the allocation holding
+// the range is released; otherwise later malloc or cache reuse of the range
+// would silently inherit it.
+struct InterleavedRanges {
+  std::mutex mutex;
+  std::map<uintptr_t, uintptr_t> ranges;  // begin -> end
+  std::atomic<size_t> count{0};
+};
+
+InterleavedRanges &interleaved_ranges() {
+  static InterleavedRanges index;
+  return index;
+}
+
+}  // namespace
+#endif
+
+void host_space_numa_release(void *ptr, size_t size) {
+#if defined(__linux__) && defined(SYS_mbind)
+  InterleavedRanges &index = interleaved_ranges();
+  if (index.count.load(std::memory_order_relaxed) == 0) return;
+
+  enum { MPOL_DEFAULT = 0 };
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(ptr);
+  const uintptr_t end   = begin + size;
+
+  std::lock_guard<std::mutex> lock(index.mutex);
+  auto loc = index.ranges.lower_bound(begin);
+  while (loc != index.ranges.end() && loc->second <= end) {
+    syscall(SYS_mbind, loc->first, loc->second - loc->first, int(MPOL_DEFAULT),
+            nullptr, 0ul, 0u);
+    loc = index.ranges.erase(loc);
+    index.count.fetch_sub(1, std::memory_order_relaxed);
+  }
+#else
+  (void)ptr;
+  (void)size;
+#endif
+}
+
+size_t host_space_numa_place(void *ptr, size_t size, bool interleave) {
+#if defined(__linux__) && defined(MADV_DONTNEED)
+  const uintptr_t page = sysconf(_SC_PAGESIZE);
+  const uintptr_t begin =
+      (reinterpret_cast<uintptr_t>(ptr) + page - 1) & ~(page - 1);
+  const uintptr_t end = (reinterpret_cast<uintptr_t>(ptr) + size) & ~(page - 1);
+
+  if (end <= begin) return page;
+
+  // Host allocations are private anonymous memory, dropping the pages
+  // makes the next touch fault them in as if freshly mapped.
+  if (madvise(reinterpret_cast<void *>(begin), end - begin, MADV_DONTNEED)) {
+    return 0;
+  }
+
+  if (!interleave) return page;
+
+#if defined(SYS_mbind)
+  // Online NUMA domains, e.g. "0-3" or "0,2-3"
+  enum { max_nodes = 1024, bits = 8 * sizeof(unsigned long) };
+  enum { MPOL_INTERLEAVE = 3 };
+
+  unsigned long mask[max_nodes / bits] = {};
+  int count = 0;
+
+  FILE *const online = fopen("/sys/devices/system/node/online", "r");
+  if (online) {
+    int first = 0;
+    int last  = 0;
+    char sep  = 0;
+    while (fscanf(online, "%d", &first) == 1) {
+      last = first;
+      sep  = static_cast<char>(fgetc(online));
+      if (sep == '-') {
+        if (fscanf(online, "%d", &last) != 1) break;
+        sep = static_cast<char>(fgetc(online));
+      }
+      for (int n = first; n <= last && n < int(max_nodes); ++n, ++count) {
+        mask[n / bits] |= 1ul << (n % bits);
+      }
+      if (sep != ',') break;
+    }
+    fclose(online);
+  }
+
+  if (count < 2) return page;
+
+  const long err = syscall(SYS_mbind, begin, end - begin, int(MPOL_INTERLEAVE),
+                           mask, static_cast<unsigned long>(max_nodes + 1), 0u);
+  if (err) return 0;
+
+  InterleavedRanges &index = interleaved_ranges();
+  std::lock_guard<std::mutex> lock(index.mutex);
+  if (index.ranges.insert(std::make_pair(begin, end)).second) {
+    index.count.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    index.ranges[begin] = std::max(index.ranges[begin], end);
+  }
+  return page;
+#else
+  return 0;
+#endif
+#else
+  (void)ptr;
+  (void)size;
+  (void)interleave;
+  return 0;
+#endif
+}
+
 }  // namespace Impl
 }  // namespace Kokkos
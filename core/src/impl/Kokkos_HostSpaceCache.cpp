@@ -0,0 +1,289 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <Kokkos_Macros.hpp>
+#include <Kokkos_HostSpace.hpp>
+#include <impl/Kokkos_BitOps.hpp>
+#include <impl/Kokkos_Error.hpp>
+#include <impl/Kokkos_HostSpaceCache.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace Kokkos {
+namespace Impl {
+namespace {
+
+enum : int { class_steps = 4 };
+enum : int { log2_min_class = 8, log2_max_class = 26 };
+enum : int {
+  class_count = (log2_max_class - log2_min_class) * class_steps + 1
+};
+enum : int { kind_count = HostSpace::HUGE_PAGES + 1 };
+enum : int { magazine_size = 4 };
+
+static_assert(HostSpaceCache::min_class_bytes == size_t(1) << log2_min_class,
+              "HostSpaceCache size classes out of sync");
+static_assert(HostSpaceCache::max_class_bytes == size_t(1) << log2_max_class,
+              "HostSpaceCache size classes out of sync");
+
+/* Class 0 holds up to min_class_bytes, then class_steps classes evenly
+ * split each (2^k, 2^(k+1)] up to max_class_bytes. */
+int class_index(const size_t bytes) {
+  if (bytes <= HostSpaceCache::min_class_bytes) return 0;
+  const int k = Kokkos::log2(unsigned(bytes - 1));
+  const int step =
+      int((bytes - 1 - (size_t(1) << k)) >> (k - 2));  // [0, class_steps)
+  return (k - log2_min_class) * class_steps + step + 1;
+}
+
+size_t class_size(const int index) {
+  if (index == 0) return HostSpaceCache::min_class_bytes;
+  const int k    = log2_min_class + (index - 1) / class_steps;
+  const int step = (index - 1) % class_steps;
+  return (size_t(1) << k) + (size_t(step + 1) << (k - 2));
+}
+
+struct Depot {
+  std::mutex lock;
+  std::vector<void*> blocks;
+};
+
+Depot g_depot[kind_count][class_count];
+
+std::atomic<size_t> g_high_water(0);
+std::atomic<size_t> g_cached_bytes(0);
+std::atomic<uint64_t> g_hits(0);
+std::atomic<uint64_t> g_misses(0);
+std::atomic<uint64_t> g_releases(0);
+
+/* The lock is only contended while release() drains the magazine */
+struct Magazine {
+  std::mutex lock;
+  int count[kind_count][class_count];
+  void* blocks[kind_count][class_count][magazine_size];
+};
+
+/* Every live thread's magazine, so that release() can drain them all */
+struct MagazineRegistry {
+  std::mutex lock;
+  std::vector<Magazine*> magazines;
+};
+
+MagazineRegistry g_magazines;
+
+/* Blocks of an exiting thread go back to the shared depot */
+struct ThreadMagazine {
+  Magazine* magazine = nullptr;
+
+  Magazine& get() {
+    if (!magazine) {
+      magazine = new Magazine();
+      std::lock_guard<std::mutex> guard(g_magazines.lock);
+      g_magazines.magazines.push_back(magazine);
+    }
+    return *magazine;
+  }
+
+  ~ThreadMagazine() {
+    if (!magazine) return;
+    std::lock_guard<std::mutex> registry_guard(g_magazines.lock);
+    auto& magazines = g_magazines.magazines;
+    magazines.erase(std::find(magazines.begin(), magazines.end(), magazine));
+    for (int kind = 0; kind < kind_count; ++kind) {
+      for (int index = 0; index < class_count; ++index) {
+        Depot& depot = g_depot[kind][index];
+        std::lock_guard<std::mutex> guard(depot.lock);
+        for (int i = 0; i < magazine->count[kind][index]; ++i) {
+          depot.blocks.push_back(magazine->blocks[kind][index][i]);
+        }
+      }
+    }
+    delete magazine;
+  }
+};
+
+thread_local ThreadMagazine t_magazine;
+
+}  // namespace
+
+void HostSpaceCache::release_block(const int kind, const int index,
+                                   void* const ptr) {
+  HostSpace space;
+  space.m_alloc_mech = HostSpace::AllocationMechanism(kind);
+  space.m_huge_page_threshold =
+      kind == HostSpace::HUGE_PAGES ? host_space_huge_page_threshold() : 0;
+  space.deallocate(ptr, class_size(index));
+  g_cached_bytes -= class_size(index);
+}
+
+/* Blocks are only interchangeable between spaces that allocate a given size
+ * the same way, so a HUGE_PAGES space is cached only if its threshold is the
+ * global one that release_block assumes. */
+size_t HostSpaceCache::class_bytes(HostSpace const& space, size_t bytes) {
+  if (!g_high_water.load(std::memory_order_relaxed) || !bytes ||
+      max_class_bytes < bytes) {
+    return 0;
+  }
+  if (space.m_alloc_mech == HostSpace::HUGE_PAGES &&
+      space.m_huge_page_threshold != host_space_huge_page_threshold()) {
+    return 0;
+  }
+  return class_size(class_index(bytes));
+}
+
+void* HostSpaceCache::allocate(HostSpace const& space, size_t class_bytes) {
+  const int kind  = space.m_alloc_mech;
+  const int index = class_index(class_bytes);
+
+  {
+    Magazine& magazine = t_magazine.get();
+    std::lock_guard<std::mutex> guard(magazine.lock);
+    int& count = magazine.count[kind][index];
+    if (count) {
+      ++g_hits;
+      g_cached_bytes -= class_bytes;
+      return magazine.blocks[kind][index][--count];
+    }
+  }
+
+  {
+    Depot& depot = g_depot[kind][index];
+    std::lock_guard<std::mutex> guard(depot.lock);
+    if (!depot.blocks.empty()) {
+      void* const ptr = depot.blocks.back();
+      depot.blocks.pop_back();
+      ++g_hits;
+      g_cached_bytes -= class_bytes;
+      return ptr;
+    }
+  }
+
+  ++g_misses;
+
+  try {
+    return space.allocate(class_bytes);
+  } catch (Kokkos::Experimental::RawMemoryAllocationFailure const&) {
+    // Cached blocks of other classes may be what is missing
+    if (!g_cached_bytes.load()) throw;
+  }
+  release();
+  return space.allocate(class_bytes);
+}
+
+void HostSpaceCache::deallocate(HostSpace const& space, void* ptr,
+                                size_t class_bytes) {
+  const int kind  = space.m_alloc_mech;
+  const int index = class_index(class_bytes);
+
+  if (g_high_water.load(std::memory_order_relaxed) <
+      g_cached_bytes.fetch_add(class_bytes) + class_bytes) {
+    g_cached_bytes -= class_bytes;
+    ++g_releases;
+    space.deallocate(ptr, class_bytes);
+    return;
+  }
+
+  {
+    Magazine& magazine = t_magazine.get();
+    std::lock_guard<std::mutex> guard(magazine.lock);
+    int& count = magazine.count[kind][index];
+    if (count < magazine_size) {
+      magazine.blocks[kind][index][count++] = ptr;
+      return;
+    }
+  }
+
+  Depot& depot = g_depot[kind][index];
+  std::lock_guard<std::mutex> guard(depot.lock);
+  depot.blocks.push_back(ptr);
+}
+
+void HostSpaceCache::release() {
+  {
+    std::lock_guard<std::mutex> registry_guard(g_magazines.lock);
+    for (Magazine* const magazine : g_magazines.magazines) {
+      std::lock_guard<std::mutex> guard(magazine->lock);
+      for (int kind = 0; kind < kind_count; ++kind) {
+        for (int index = 0; index < class_count; ++index) {
+          int& count = magazine->count[kind][index];
+          while (count) {
+            release_block(kind, index, magazine->blocks[kind][index][--count]);
+          }
+        }
+      }
+    }
+  }
+  for (int kind = 0; kind < kind_count; ++kind) {
+    for (int index = 0; index < class_count; ++index) {
+      Depot& depot = g_depot[kind][index];
+      std::lock_guard<std::mutex> guard(depot.lock);
+      for (void* const ptr : depot.blocks) release_block(kind, index, ptr);
+      depot.blocks.clear();
+      depot.blocks.shrink_to_fit();
+    }
+  }
+}
+
+void HostSpaceCache::set_high_water(size_t bytes) {
+  g_high_water = bytes;
+  if (g_cached_bytes.load() > bytes) release();
+}
+
+size_t HostSpaceCache::high_water() { return g_high_water.load(); }
+
+HostSpaceCache::Statistics HostSpaceCache::statistics() {
+  Statistics stats;
+  stats.hits         = g_hits.load();
+  stats.misses       = g_misses.load();
+  stats.releases     = g_releases.load();
+  stats.cached_bytes = g_cached_bytes.load();
+  stats.high_water   = g_high_water.load();
+  return stats;
+}
+
+}  // namespace Impl
+}  // namespace Kokkos
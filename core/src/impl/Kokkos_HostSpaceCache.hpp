@@ -0,0 +1,108 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOS_IMPL_HOSTSPACECACHE_HPP
+#define KOKKOS_IMPL_HOSTSPACECACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Kokkos {
+
+class HostSpace;
+
+namespace Impl {
+
+/** \brief  Size class cache of freed HostSpace allocation records.
+ *
+ *  Opt-in with --kokkos-host-cache=INT (MiB), KOKKOS_HOST_CACHE or
+ *  set_high_water(). Tracked HostSpace allocations are rounded up to one of
+ *  four size classes per power of two and, when freed, kept for reuse
+ *  instead of being returned to the allocation mechanism. Each thread keeps
+ *  a small magazine of blocks per size class in front of a shared depot;
+ *  the bytes held by both are bounded by the high-water mark.
+ */
+class HostSpaceCache {
+ public:
+  struct Statistics {
+    uint64_t hits;      // allocations served from the cache
+    uint64_t misses;    // cacheable allocations that had to allocate
+    uint64_t releases;  // freed blocks returned because of the high-water
+    size_t cached_bytes;
+    size_t high_water;
+  };
+
+  /* Smallest and largest cached size class */
+  enum : size_t { min_class_bytes = size_t(1) << 8 };
+  enum : size_t { max_class_bytes = size_t(1) << 26 };
+
+  /**\brief  Bound the cached bytes, zero disables the cache and releases it */
+  static void set_high_water(size_t bytes);
+
+  static size_t high_water();
+
+  static Statistics statistics();
+
+  /**\brief  Return the shared depot and every thread's magazine to the
+   *         allocation mechanism */
+  static void release();
+
+  /**\brief  Bytes of the size class an allocation of the space is cached
+   *         under, zero if it is not cached */
+  static size_t class_bytes(HostSpace const& space, size_t bytes);
+
+  /**\brief  Allocate a block of class_bytes( space , bytes ) bytes */
+  static void* allocate(HostSpace const& space, size_t class_bytes);
+
+  static void deallocate(HostSpace const& space, void* ptr,
+                         size_t class_bytes);
+
+ private:
+  static void release_block(int kind, int index, void* ptr);
+};
+
+}  // namespace Impl
+}  // namespace Kokkos
+
+#endif
@@ -45,6 +45,17 @@
 #include "Kokkos_Core.hpp"
 #include "Kokkos_HostSpace_deepcopy.hpp"
 
+#include <algorithm>
+#include <cstring>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+#if (defined(__AVX__) || defined(__SSE2__)) && !defined(KOKKOS_COMPILER_PGI)
+#include <immintrin.h>
+#endif
+
 namespace Kokkos {
 
 namespace Impl {
@@ -53,89 +64,273 @@ namespace Impl {
 #define KOKKOS_IMPL_HOST_DEEP_COPY_SERIAL_LIMIT 10 * 8192
 #endif
 
-void hostspace_parallel_deepcopy(void* dst, const void* src, ptrdiff_t n) {
-  if ((n < KOKKOS_IMPL_HOST_DEEP_COPY_SERIAL_LIMIT) ||
-      (Kokkos::DefaultHostExecutionSpace().concurrency() == 1)) {
-    std::memcpy(dst, src, n);
-    return;
-  }
+namespace {
+
+/* Copies larger than the last level cache bypass it with streaming stores */
+size_t g_stream_limit = [] {
+  long llc = 0;
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+  llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+  if (llc <= 0) llc = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+  return llc > 0 ? size_t(llc) : size_t(32) << 20;
+}();
+
+#if defined(__AVX__) && !defined(KOKKOS_COMPILER_PGI)
+typedef __m256i vector_type;
+inline vector_type vector_load(const char* p) {
+  return _mm256_loadu_si256(reinterpret_cast<const vector_type*>(p));
+}
+inline void vector_store(char* p, vector_type v) {
+  _mm256_store_si256(reinterpret_cast<vector_type*>(p), v);
+}
+inline void vector_stream(char* p, vector_type v) {
+  _mm256_stream_si256(reinterpret_cast<vector_type*>(p), v);
+}
+#define KOKKOS_IMPL_HOST_DEEP_COPY_VECTOR
+#elif defined(__SSE2__) && !defined(KOKKOS_COMPILER_PGI)
+typedef __m128i vector_type;
+inline vector_type vector_load(const char* p) {
+  return _mm_loadu_si128(reinterpret_cast<const vector_type*>(p));
+}
+inline void vector_store(char* p, vector_type v) {
+  _mm_store_si128(reinterpret_cast<vector_type*>(p), v);
+}
+inline void vector_stream(char* p, vector_type v) {
+  _mm_stream_si128(reinterpret_cast<vector_type*>(p), v);
+}
+#define KOKKOS_IMPL_HOST_DEEP_COPY_VECTOR
+#endif
 
-  typedef Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace> policy_t;
-
-  // Both src and dst are aligned the same way with respect to 8 byte words
-  if (reinterpret_cast<ptrdiff_t>(src) % 8 ==
-      reinterpret_cast<ptrdiff_t>(dst) % 8) {
-    char* dst_c       = reinterpret_cast<char*>(dst);
-    const char* src_c = reinterpret_cast<const char*>(src);
-    int count         = 0;
-    // get initial bytes copied
-    while (reinterpret_cast<ptrdiff_t>(dst_c) % 8 != 0) {
-      *dst_c = *src_c;
-      dst_c++;
-      src_c++;
-      count++;
+#if defined(KOKKOS_IMPL_HOST_DEEP_COPY_VECTOR)
+
+/* Four vectors of stores are issued per iteration */
+template <bool Stream>
+void copy_vectors(char* dst, const char* src, size_t n) {
+  enum : size_t { width = sizeof(vector_type) };
+  for (size_t i = 0; i < n; i += 4 * width) {
+    const vector_type v0 = vector_load(src + i);
+    const vector_type v1 = vector_load(src + i + width);
+    const vector_type v2 = vector_load(src + i + 2 * width);
+    const vector_type v3 = vector_load(src + i + 3 * width);
+    if (Stream) {
+      vector_stream(dst + i, v0);
+      vector_stream(dst + i + width, v1);
+      vector_stream(dst + i + 2 * width, v2);
+      vector_stream(dst + i + 3 * width, v3);
+    } else {
+      vector_store(dst + i, v0);
+      vector_store(dst + i + width, v1);
+      vector_store(dst + i + 2 * width, v2);
+      vector_store(dst + i + 3 * width, v3);
     }
+  }
+}
+
+#endif
+
+/* Stores are aligned on dst. Loads from src are unaligned, so src may have
+ * any offset relative to dst without falling back to narrower copies. */
+void copy_range(char* dst, const char* src, size_t n, bool stream) {
+#if defined(KOKKOS_IMPL_HOST_DEEP_COPY_VECTOR)
+  enum : size_t { width = sizeof(vector_type) };
+
+  const size_t head =
+      std::min(n, size_t(-reinterpret_cast<uintptr_t>(dst) & (width - 1)));
+  std::memcpy(dst, src, head);
+  dst += head;
+  src += head;
+  n -= head;
+
+  const size_t body = n & ~size_t(4 * width - 1);
+  if (stream) {
+    copy_vectors<true>(dst, src, body);
+    _mm_sfence();
+  } else {
+    copy_vectors<false>(dst, src, body);
+  }
+
+  std::memcpy(dst + body, src + body, n - body);
+#else
+  (void)stream;
+  std::memcpy(dst, src, n);
+#endif
+}
+
+template <class T>
+void fill_typed(char* dst, const char* value, size_t count) {
+  T v;
+  std::memcpy(&v, value, sizeof(T));
+  for (size_t i = 0; i < count; ++i) {
+    std::memcpy(dst + i * sizeof(T), &v, sizeof(T));
+  }
+}
+
+/* Element by element, for the ends of a range and for values whose size does
+ * not divide the vector width */
+void fill_elements(char* dst, const char* value, size_t size, size_t count) {
+  switch (size) {
+    case 1: std::memset(dst, *value, count); return;
+    case 2: fill_typed<uint16_t>(dst, value, count); return;
+    case 4: fill_typed<uint32_t>(dst, value, count); return;
+    case 8: fill_typed<uint64_t>(dst, value, count); return;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    std::memcpy(dst + i * size, value, size);
+  }
+}
+
+#if defined(KOKKOS_IMPL_HOST_DEEP_COPY_VECTOR)
 
-    // copy the bulk of the data
-    double* dst_p       = reinterpret_cast<double*>(dst_c);
-    const double* src_p = reinterpret_cast<const double*>(src_c);
-    Kokkos::parallel_for("Kokkos::Impl::host_space_deepcopy_double",
-                         policy_t(0, (n - count) / 8),
-                         [=](const ptrdiff_t i) { dst_p[i] = src_p[i]; });
-
-    // get final data copied
-    dst_c += ((n - count) / 8) * 8;
-    src_c += ((n - count) / 8) * 8;
-    char* dst_end = reinterpret_cast<char*>(dst) + n;
-    while (dst_c != dst_end) {
-      *dst_c = *src_c;
-      dst_c++;
-      src_c++;
+/* Four vectors of the replicated value are stored per iteration */
+template <bool Stream>
+void fill_vectors(char* dst, const vector_type v, size_t n) {
+  enum : size_t { width = sizeof(vector_type) };
+  for (size_t i = 0; i < n; i += 4 * width) {
+    if (Stream) {
+      vector_stream(dst + i, v);
+      vector_stream(dst + i + width, v);
+      vector_stream(dst + i + 2 * width, v);
+      vector_stream(dst + i + 3 * width, v);
+    } else {
+      vector_store(dst + i, v);
+      vector_store(dst + i + width, v);
+      vector_store(dst + i + 2 * width, v);
+      vector_store(dst + i + 3 * width, v);
     }
-    return;
   }
+}
 
-  // Both src and dst are aligned the same way with respect to 4 byte words
-  if (reinterpret_cast<ptrdiff_t>(src) % 4 ==
-      reinterpret_cast<ptrdiff_t>(dst) % 4) {
-    char* dst_c       = reinterpret_cast<char*>(dst);
-    const char* src_c = reinterpret_cast<const char*>(src);
-    int count         = 0;
-    // get initial bytes copied
-    while (reinterpret_cast<ptrdiff_t>(dst_c) % 4 != 0) {
-      *dst_c = *src_c;
-      dst_c++;
-      src_c++;
-      count++;
+#endif
+
+/* The vector body is used when the value tiles a vector and the first
+ * aligned vector of dst begins on an element boundary */
+void fill_range(char* dst, const char* value, size_t size, size_t count,
+                bool stream) {
+#if defined(KOKKOS_IMPL_HOST_DEEP_COPY_VECTOR)
+  enum : size_t { width = sizeof(vector_type) };
+
+  const size_t misalign = -reinterpret_cast<uintptr_t>(dst) & (width - 1);
+  if ((width % size == 0) && (misalign % size == 0)) {
+    const size_t head = std::min(count, misalign / size);
+    fill_elements(dst, value, size, head);
+    dst += head * size;
+    count -= head;
+
+    char pattern[width];
+    for (size_t i = 0; i < width; i += size) {
+      std::memcpy(pattern + i, value, size);
     }
+    const vector_type v = vector_load(pattern);
 
-    // copy the bulk of the data
-    int32_t* dst_p       = reinterpret_cast<int32_t*>(dst_c);
-    const int32_t* src_p = reinterpret_cast<const int32_t*>(src_c);
-    Kokkos::parallel_for("Kokkos::Impl::host_space_deepcopy_int",
-                         policy_t(0, (n - count) / 4),
-                         [=](const ptrdiff_t i) { dst_p[i] = src_p[i]; });
-
-    // get final data copied
-    dst_c += ((n - count) / 4) * 4;
-    src_c += ((n - count) / 4) * 4;
-    char* dst_end = reinterpret_cast<char*>(dst) + n;
-    while (dst_c != dst_end) {
-      *dst_c = *src_c;
-      dst_c++;
-      src_c++;
+    const size_t body = (count * size) & ~size_t(4 * width - 1);
+    if (stream) {
+      fill_vectors<true>(dst, v, body);
+      _mm_sfence();
+    } else {
+      fill_vectors<false>(dst, v, body);
     }
+
+    fill_elements(dst + body, value, size, count - body / size);
+    return;
+  }
+#endif
+  (void)stream;
+  fill_elements(dst, value, size, count);
+}
+
+}  // namespace
+
+size_t hostspace_deepcopy_stream_limit() { return g_stream_limit; }
+
+void set_hostspace_deepcopy_stream_limit(size_t n) { g_stream_limit = n; }
+
+void hostspace_parallel_deepcopy(void* dst, const void* src, ptrdiff_t n) {
+  const int threads = Kokkos::DefaultHostExecutionSpace().concurrency();
+  const bool stream = size_t(n) >= g_stream_limit;
+
+  char* const dst_c       = reinterpret_cast<char*>(dst);
+  const char* const src_c = reinterpret_cast<const char*>(src);
+
+  if ((n < KOKKOS_IMPL_HOST_DEEP_COPY_SERIAL_LIMIT) || (threads == 1)) {
+    copy_range(dst_c, src_c, n, stream);
     return;
   }
 
-  // Src and dst are not aligned the same way, we can only to byte wise copy.
-  {
-    char* dst_p       = reinterpret_cast<char*>(dst);
-    const char* src_p = reinterpret_cast<const char*>(src);
-    Kokkos::parallel_for("Kokkos::Impl::host_space_deepcopy_char",
-                         policy_t(0, n),
-                         [=](const ptrdiff_t i) { dst_p[i] = src_p[i]; });
+  // One contiguous range per thread, split on cache lines of dst so that no
+  // line is written by two threads
+  enum : uintptr_t { line = 64 };
+  const uintptr_t base  = reinterpret_cast<uintptr_t>(dst_c);
+  const ptrdiff_t chunk = (n + threads - 1) / threads;
+
+  auto bound = [=](const int k) -> ptrdiff_t {
+    if (k == 0) return 0;
+    const uintptr_t split = (base + k * chunk + line - 1) & ~(line - 1);
+    return std::min<ptrdiff_t>(n, split - base);
+  };
+
+  typedef Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace,
+                              Kokkos::Schedule<Kokkos::Static>>
+      policy_t;
+
+  Kokkos::parallel_for("Kokkos::Impl::host_space_deepcopy",
+                       policy_t(0, threads), [=](const int k) {
+                         const ptrdiff_t begin = bound(k);
+                         const ptrdiff_t end   = bound(k + 1);
+                         copy_range(dst_c + begin, src_c + begin, end - begin,
+                                    stream);
+                       });
+}
+
+void hostspace_parallel_fill(void* dst, const void* value, size_t value_size,
+                             size_t count) {
+  const char* value_c = reinterpret_cast<const char*>(value);
+
+  // A value made of one repeated byte, zero in particular, is a memset
+  if (std::all_of(value_c, value_c + value_size,
+                  [=](const char c) { return c == value_c[0]; })) {
+    count *= value_size;
+    value_size = 1;
+  }
+
+  const int threads = Kokkos::DefaultHostExecutionSpace().concurrency();
+  const size_t n    = count * value_size;
+  const bool stream = n >= g_stream_limit;
+
+  char* const dst_c = reinterpret_cast<char*>(dst);
+
+  if ((n < KOKKOS_IMPL_HOST_DEEP_COPY_SERIAL_LIMIT) || (threads == 1)) {
+    fill_range(dst_c, value_c, value_size, count, stream);
+    return;
   }
+
+  // One contiguous range of elements per thread, split on cache lines of dst
+  // whenever those coincide with element boundaries
+  enum : uintptr_t { line = 64 };
+  const uintptr_t base = reinterpret_cast<uintptr_t>(dst_c);
+  const bool on_lines  = (line % value_size == 0) && (base % value_size == 0);
+  const size_t chunk   = (count + threads - 1) / threads;
+
+  auto bound = [=](const int k) -> size_t {
+    size_t split = k * chunk;
+    if (on_lines && k != 0) {
+      split = (((base + split * value_size + line - 1) & ~(line - 1)) - base) /
+              value_size;
+    }
+    return std::min(count, split);
+  };
+
+  typedef Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace,
+                              Kokkos::Schedule<Kokkos::Static>>
+      policy_t;
+
+  Kokkos::parallel_for("Kokkos::Impl::host_space_fill", policy_t(0, threads),
+                       [=](const int k) {
+                         const size_t begin = bound(k);
+                         const size_t end   = bound(k + 1);
+                         fill_range(dst_c + begin * value_size, value_c,
+                                    value_size, end - begin, stream);
+                       });
 }
 
 }  // namespace Impl
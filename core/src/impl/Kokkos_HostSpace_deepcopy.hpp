@@ -41,6 +41,7 @@
 // ************************************************************************
 //@HEADER
 */
+#include <cstddef>
 #include <cstdint>
 
 namespace Kokkos {
@@ -49,6 +50,18 @@ namespace Impl {
 
 void hostspace_parallel_deepcopy(void* dst, const void* src, ptrdiff_t n);
 
+/* Copies of at least this many bytes use non-temporal stores, by default the
+ * size of the last level cache */
+size_t hostspace_deepcopy_stream_limit();
+
+void set_hostspace_deepcopy_stream_limit(size_t n);
+
+/* Fills count elements of value_size bytes each, starting at dst, with the
+ * bytes at value. Fills of at least the stream limit use non-temporal
+ * stores, and all-zero values use memset. */
+void hostspace_parallel_fill(void* dst, const void* value, size_t value_size,
+                             size_t count);
+
 }  // namespace Impl
 
 }  // namespace Kokkos
@@ -42,6 +42,10 @@
 //@HEADER
 */
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
 #include <limits>
 #include <Kokkos_Macros.hpp>
 #include <impl/Kokkos_HostThreadTeam.hpp>
@@ -69,7 +73,7 @@ void HostThreadTeamData::organize_pool(HostThreadTeamData *members[],
   if (ok) {
     int64_t *const root_scratch = members[0]->m_scratch;
 
-    for (int i = m_pool_rendezvous; i < m_pool_reduce; ++i) {
+    for (int i = m_pool_rendezvous; i < m_reduce_flags; ++i) {
       root_scratch[i] = 0;
     }
 
@@ -79,6 +83,8 @@ void HostThreadTeamData::organize_pool(HostThreadTeamData *members[],
 
       // team size == 1, league size == pool_size
 
+      const int pool_fan_in = HostBarrier::fan_in(size);
+
       for (int rank = 0; rank < size; ++rank) {
         HostThreadTeamData *const mem = members[rank];
         mem->m_pool_scratch           = root_scratch;
@@ -91,8 +97,17 @@ void HostThreadTeamData::organize_pool(HostThreadTeamData *members[],
         mem->m_team_alloc             = 1;
         mem->m_league_rank            = rank;
         mem->m_league_size            = size;
+        mem->m_pool_fan_in            = pool_fan_in;
+        mem->m_team_fan_in            = 0;
         mem->m_team_rendezvous_step   = 0;
+        mem->m_pool_reduce_step       = 0;
+        mem->m_team_reduce_step       = 0;
         pool[rank]                    = mem;
+        mem->reset_reduce_flags(m_reduce_flags, m_pool_reduce);
+      }
+
+      for (int rank = 0; rank < size; ++rank) {
+        members[rank]->order_steal_victims();
       }
     }
 
@@ -117,7 +132,12 @@ void HostThreadTeamData::disband_pool() {
   m_team_alloc           = 1;
   m_league_rank          = 0;
   m_league_size          = 1;
+  m_pool_fan_in          = 0;
+  m_team_fan_in          = 0;
   m_team_rendezvous_step = 0;
+  m_pool_reduce_step     = 0;
+  m_team_reduce_step     = 0;
+  m_steal_count          = -1;
 }
 
 int HostThreadTeamData::organize_team(const int team_size) {
@@ -162,11 +182,20 @@ int HostThreadTeamData::organize_team(const int team_size) {
     m_team_alloc           = team_alloc_size;
     m_league_rank          = league_rank;
     m_league_size          = league_size;
+    m_team_fan_in          = HostBarrier::fan_in(team_size);
     m_team_rendezvous_step = 0;
+    m_team_reduce_step     = 0;
+
+    // The pool rendezvous below orders this before any team reduction
+    reset_reduce_flags(m_team_reduce_arrive,
+                       m_team_reduce_arrive + flag_stride);
 
     if (team_base_rank == m_pool_rank) {
+      // Only the team's base member steals
+      order_steal_victims();
+
       // Initialize team's rendezvous memory
-      for (int i = m_team_rendezvous; i < m_pool_reduce; ++i) {
+      for (int i = m_team_rendezvous; i < m_reduce_flags; ++i) {
         m_scratch[i] = 0;
       }
       // Make sure team's rendezvous memory initialized
@@ -197,7 +226,66 @@ void HostThreadTeamData::disband_team() {
   m_team_alloc           = 1;
   m_league_rank          = m_pool_rank;
   m_league_size          = m_pool_size;
+  m_team_fan_in          = 0;
   m_team_rendezvous_step = 0;
+  m_team_reduce_step     = 0;
+
+  order_steal_victims();
+}
+
+//----------------------------------------------------------------------------
+
+namespace {
+std::atomic<bool> s_numa_stealing(true);
+}  // namespace
+
+void HostThreadTeamData::set_numa_stealing(bool const enable) noexcept {
+  s_numa_stealing.store(enable, std::memory_order_relaxed);
+}
+
+bool HostThreadTeamData::numa_stealing() noexcept {
+  return s_numa_stealing.load(std::memory_order_relaxed);
+}
+
+void HostThreadTeamData::order_steal_victims() noexcept {
+  HostThreadTeamData *const *const pool =
+      (HostThreadTeamData **)(m_pool_scratch + m_pool_members);
+
+  // A pool within one NUMA domain keeps round robin stealing
+  bool uniform = true;
+  for (int r = 1; r < m_pool_size && uniform; ++r) {
+    uniform = pool[r]->m_numa_socket == pool[0]->m_numa_socket &&
+              pool[r]->m_numa_domain == pool[0]->m_numa_domain;
+  }
+  m_steal_count = -1;
+  if (uniform) return;
+
+  // The other full teams' base ranks
+  int n = 0;
+  for (int base = 0; base + m_team_size <= m_pool_size; base += m_team_alloc) {
+    if (base != m_team_base) m_steal_order[n++] = base;
+  }
+
+  // Same domain, then same socket, then other sockets; within each nearer
+  // domain ids, then ranks following this team's, as round robin would.
+  const int socket = m_numa_socket;
+  const int domain = m_numa_domain;
+  const int base   = m_team_base;
+  const int size   = m_pool_size;
+  std::sort(m_steal_order, m_steal_order + n, [&](const int a, const int b) {
+    const HostThreadTeamData &x = *pool[a];
+    const HostThreadTeamData &y = *pool[b];
+    const int x_far =
+        (x.m_numa_socket != socket) * 2 + (x.m_numa_domain != domain);
+    const int y_far =
+        (y.m_numa_socket != socket) * 2 + (y.m_numa_domain != domain);
+    if (x_far != y_far) return x_far < y_far;
+    const int x_gap = std::abs(x.m_numa_domain - domain);
+    const int y_gap = std::abs(y.m_numa_domain - domain);
+    if (x_gap != y_gap) return x_gap < y_gap;
+    return (a - base + size) % size < (b - base + size) % size;
+  });
+  m_steal_count = n;
 }
 
 //----------------------------------------------------------------------------
@@ -270,10 +358,7 @@ int HostThreadTeamData::get_work_stealing() noexcept {
           // m_steal_rank + m_team_alloc could be the next base_rank to steal
           // from but only if there are another m_team_size threads available so
           // that that base rank has a full team.
-          m_steal_rank =
-              m_steal_rank + m_team_alloc + m_team_size <= m_pool_size
-                  ? m_steal_rank + m_team_alloc
-                  : 0;
+          m_steal_rank = next_steal_rank();
 
           steal_range = &(pool[m_steal_rank]->m_work_range);
 
@@ -307,5 +392,78 @@ fflush(stdout);
   return w.first;
 }
 
+std::pair<int64_t, int64_t> HostThreadTeamData::get_work_shared_chunk(
+    bool const guided) noexcept {
+  int64_t volatile *const next =
+      (int64_t volatile *)&(pool_member(0)->m_work_next);
+
+  if (!guided) {
+    const int64_t first = Kokkos::atomic_fetch_add(next, int64_t(m_work_chunk));
+    return first < m_work_end
+               ? std::pair<int64_t, int64_t>(
+                     first, std::min(first + m_work_chunk, m_work_end))
+               : std::pair<int64_t, int64_t>(-1, -1);
+  }
+
+  int64_t first = *next;
+  while (first < m_work_end) {
+    const int64_t share = (m_work_end - first) / (2 * m_pool_size);
+    const int64_t last =
+        std::min(first + std::max(share, int64_t(m_work_chunk)), m_work_end);
+    const int64_t seen = Kokkos::atomic_compare_exchange(next, first, last);
+    if (seen == first) return std::pair<int64_t, int64_t>(first, last);
+    first = seen;
+  }
+  return std::pair<int64_t, int64_t>(-1, -1);
+}
+
+//----------------------------------------------------------------------------
+
+namespace {
+
+// Tail imbalance tolerated, as a fraction of a thread's share of the work
+constexpr double adaptive_tail_fraction = 0.05;
+
+// Chunks shorter than this spend a noticeable part of their time claiming
+constexpr double adaptive_min_chunk_seconds = 2.0e-6;
+
+}  // namespace
+
+int64_t HostAdaptiveChunk::chunk(int64_t const length, int const pool_size,
+                                 int64_t const policy_chunk) const noexcept {
+  int64_t c = m_chunk.load(std::memory_order_relaxed);
+  if (c <= 0) {
+    // No timings yet: start with a few chunks per thread
+    c = std::max(policy_chunk, length / (16 * int64_t(pool_size)));
+  }
+  return std::max(int64_t(1),
+                  std::min(c, int64_t(std::numeric_limits<int>::max())));
+}
+
+void HostAdaptiveChunk::update(int64_t const length, int64_t const used,
+                               const Sample *samples,
+                               int const pool_size) noexcept {
+  double busy    = 0;
+  double longest = 0;
+  for (int i = 0; i < pool_size; ++i) {
+    busy += samples[i].busy;
+    longest = std::max(longest, samples[i].longest);
+  }
+  if (length <= 0 || busy <= 0 || longest <= 0) return;
+
+  // Chunk time scales with chunk length; aim the longest chunk at the
+  // tolerated tail, moving by at most a factor of four per launch.
+  const double share = busy / pool_size;
+  double target      = used * (adaptive_tail_fraction * share / longest);
+  target = std::min(std::max(target, 0.25 * used), 4.0 * used);
+
+  const double per_iteration = busy / length;
+  const double lower = std::ceil(adaptive_min_chunk_seconds / per_iteration);
+  const double upper = std::max(1.0, double(length / pool_size));
+  target             = std::min(std::max(target, lower), upper);
+
+  m_chunk.store(int64_t(std::max(1.0, target)), std::memory_order_relaxed);
+}
+
 }  // namespace Impl
 }  // namespace Kokkos
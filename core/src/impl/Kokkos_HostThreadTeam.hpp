@@ -52,9 +52,12 @@
 #include <impl/Kokkos_FunctorAdapter.hpp>
 #include <impl/Kokkos_FunctorAnalysis.hpp>
 #include <impl/Kokkos_HostBarrier.hpp>
+#include <impl/Kokkos_Spinwait.hpp>
 
 #include <limits>     // std::numeric_limits
 #include <algorithm>  // std::max
+#include <atomic>     // std::atomic
+#include <chrono>     // std::chrono::steady_clock
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
@@ -76,15 +79,20 @@ class HostThreadTeamData {
 
   enum : int { max_pool_members = 1024 };
   enum : int { max_team_members = 64 };
-  enum : int { max_pool_rendezvous = HostBarrier::required_buffer_size };
-  enum : int { max_team_rendezvous = HostBarrier::required_buffer_size };
+  enum : int {
+    max_pool_rendezvous = HostBarrier::required_buffer_size / sizeof(int64_t)
+  };
+  enum : int {
+    max_team_rendezvous = HostBarrier::required_buffer_size / sizeof(int64_t)
+  };
 
  private:
   // per-thread scratch memory buffer chunks:
   //
   //   [ pool_members ]     = [ m_pool_members    .. m_pool_rendezvous )
   //   [ pool_rendezvous ]  = [ m_pool_rendezvous .. m_team_rendezvous )
-  //   [ team_rendezvous ]  = [ m_team_rendezvous .. m_pool_reduce )
+  //   [ team_rendezvous ]  = [ m_team_rendezvous .. m_reduce_flags )
+  //   [ reduce_flags ]     = [ m_reduce_flags    .. m_pool_reduce )
   //   [ pool_reduce ]      = [ m_pool_reduce     .. m_team_reduce )
   //   [ team_reduce ]      = [ m_team_reduce     .. m_team_shared )
   //   [ team_shared ]      = [ m_team_shared     .. m_thread_local )
@@ -93,12 +101,22 @@ class HostThreadTeamData {
   enum : int { m_pool_members = 0 };
   enum : int { m_pool_rendezvous = m_pool_members + max_pool_members };
   enum : int { m_team_rendezvous = m_pool_rendezvous + max_pool_rendezvous };
-  enum : int { m_pool_reduce = m_team_rendezvous + max_team_rendezvous };
+  enum : int { m_reduce_flags = m_team_rendezvous + max_team_rendezvous };
+
+  // Flags of the tree reductions and scans, each in its own cache line:
+  // a thread raises its arrive flags once its subtree is combined, and the
+  // parent raises the release flag once the thread's scan prefix is set.
+  enum : int { flag_stride = 64 / sizeof(int64_t) };
+  enum : int { m_pool_reduce_arrive = m_reduce_flags };
+  enum : int { m_pool_scan_release = m_pool_reduce_arrive + flag_stride };
+  enum : int { m_team_reduce_arrive = m_pool_scan_release + flag_stride };
+  enum : int { m_pool_reduce = m_team_reduce_arrive + flag_stride };
 
   using pair_int_t = Kokkos::pair<int64_t, int64_t>;
 
   pair_int_t m_work_range;
   int64_t m_work_end;
+  int64_t m_work_next;  // next unclaimed index, used on the pool root
   int64_t* m_scratch;       // per-thread buffer
   int64_t* m_pool_scratch;  // == pool[0]->m_scratch
   int64_t* m_team_scratch;  // == pool[ 0 + m_team_base ]->m_scratch
@@ -115,19 +133,58 @@ class HostThreadTeamData {
   int m_league_rank;
   int m_league_size;
   int m_work_chunk;
-  int m_steal_rank;  // work stealing rank
+  int m_steal_rank;    // work stealing rank
+  int m_numa_socket;   // socket of the thread
+  int m_numa_domain;   // NUMA domain of the thread
+  int m_steal_count;   // teams in m_steal_order, -1 for round robin
+  int m_steal_next;    // next entry of m_steal_order to steal from
+  int m_steal_order[max_pool_members];  // team base ranks, nearest first
+  int m_pool_fan_in;  // HostBarrier fan-in of the pool rendezvous
+  int m_team_fan_in;  // HostBarrier fan-in of the team rendezvous
   int mutable m_pool_rendezvous_step;
   int mutable m_team_rendezvous_step;
+  int mutable m_pool_reduce_step;
+  int mutable m_team_reduce_step;
 
   HostThreadTeamData* team_member(int r) const noexcept {
     return ((HostThreadTeamData**)(m_pool_scratch +
                                    m_pool_members))[m_team_base + r];
   }
 
+  int volatile& reduce_flag(const int flag) const noexcept {
+    return *((int volatile*)(m_scratch + flag));
+  }
+
+  void reset_reduce_flags(const int begin, const int end) noexcept {
+    for (int i = begin; i < end; ++i) m_scratch[i] = 0;
+  }
+
+  // Binomial tree combine over the 'size' threads 'members[0..size)' of
+  // which this thread is 'rank'.  Rank r joins the slots of r + 1, r + 2,
+  // r + 4, ... below its lowest set bit, each once that child has combined
+  // its own subtree, so the root does log2(size) joins instead of size - 1.
+  // Returns true on rank 0, whose slot then holds the combined value.
+  template <class Slot, class Join>
+  bool tree_combine(HostThreadTeamData* const* const members, const int rank,
+                    const int size, const int flag, const int step,
+                    Slot const& slot, Join const& join) const noexcept {
+    for (int d = 1; d < size - rank && !(rank & d); d <<= 1) {
+      HostThreadTeamData const& child = *members[rank + d];
+      spinwait_until_equal(child.reduce_flag(flag), step);
+      join(slot(*this), slot(child));
+    }
+    if (rank) {
+      memory_fence();
+      reduce_flag(flag) = step;
+    }
+    return rank == 0;
+  }
+
  public:
   inline bool team_rendezvous() const noexcept {
     int* ptr = (int*)(m_team_scratch + m_team_rendezvous);
-    HostBarrier::split_arrive(ptr, m_team_size, m_team_rendezvous_step);
+    HostBarrier::split_arrive(ptr, m_team_size, m_team_rank, m_team_fan_in,
+                              m_team_rendezvous_step);
     if (m_team_rank != 0) {
       HostBarrier::wait(ptr, m_team_size, m_team_rendezvous_step);
     } else {
@@ -139,7 +196,8 @@ class HostThreadTeamData {
 
   inline bool team_rendezvous(const int source_team_rank) const noexcept {
     int* ptr = (int*)(m_team_scratch + m_team_rendezvous);
-    HostBarrier::split_arrive(ptr, m_team_size, m_team_rendezvous_step);
+    HostBarrier::split_arrive(ptr, m_team_size, m_team_rank, m_team_fan_in,
+                              m_team_rendezvous_step);
     if (m_team_rank != source_team_rank) {
       HostBarrier::wait(ptr, m_team_size, m_team_rendezvous_step);
     } else {
@@ -151,7 +209,8 @@ class HostThreadTeamData {
 
   inline void team_rendezvous_release() const noexcept {
     HostBarrier::split_release((int*)(m_team_scratch + m_team_rendezvous),
-                               m_team_size, m_team_rendezvous_step);
+                               m_team_size, m_team_fan_in,
+                               m_team_rendezvous_step);
   }
 
   inline int pool_rendezvous() const noexcept {
@@ -169,7 +228,8 @@ class HostThreadTeamData {
 #endif
 
     int* ptr = (int*)(m_pool_scratch + m_pool_rendezvous);
-    HostBarrier::split_arrive(ptr, m_pool_size, m_pool_rendezvous_step);
+    HostBarrier::split_arrive(ptr, m_pool_size, m_pool_rank, m_pool_fan_in,
+                              m_pool_rendezvous_step);
     if (m_pool_rank != 0) {
       HostBarrier::wait(ptr, m_pool_size, m_pool_rendezvous_step);
     } else {
@@ -181,7 +241,8 @@ class HostThreadTeamData {
 
   inline void pool_rendezvous_release() const noexcept {
     HostBarrier::split_release((int*)(m_pool_scratch + m_pool_rendezvous),
-                               m_pool_size, m_pool_rendezvous_step);
+                               m_pool_size, m_pool_fan_in,
+                               m_pool_rendezvous_step);
   }
 
   //----------------------------------------
@@ -189,6 +250,7 @@ class HostThreadTeamData {
   constexpr HostThreadTeamData() noexcept
       : m_work_range(-1, -1),
         m_work_end(0),
+        m_work_next(0),
         m_scratch(nullptr),
         m_pool_scratch(nullptr),
         m_team_scratch(nullptr),
@@ -206,8 +268,17 @@ class HostThreadTeamData {
         m_league_size(1),
         m_work_chunk(0),
         m_steal_rank(0),
+        m_numa_socket(0),
+        m_numa_domain(0),
+        m_steal_count(-1),
+        m_steal_next(0),
+        m_steal_order(),
+        m_pool_fan_in(0),
+        m_team_fan_in(0),
         m_pool_rendezvous_step(0),
-        m_team_rendezvous_step(0) {}
+        m_team_rendezvous_step(0),
+        m_pool_reduce_step(0),
+        m_team_reduce_step(0) {}
 
   //----------------------------------------
   // Organize array of members into a pool.
@@ -290,6 +361,71 @@ class HostThreadTeamData {
     return m_scratch + m_pool_reduce;
   }
 
+  // Combine the pool_reduce_local() buffers of the whole pool in a
+  // log-depth tree, with join( dst , src ) called on the buffers.
+  // Every thread of the pool calls this once its contribution is complete.
+  // Returns true on the pool root, whose pool_reduce_local() then holds the
+  // reduction; the other buffers are left partially combined.
+  template <class Join>
+  bool pool_reduce_tree(Join const& join) const noexcept {
+    return tree_combine(
+        (HostThreadTeamData**)(m_pool_scratch + m_pool_members), m_pool_rank,
+        m_pool_size, m_pool_reduce_arrive, ++m_pool_reduce_step,
+        [](HostThreadTeamData const& d) { return d.pool_reduce_local(); },
+        join);
+  }
+
+  // Exclusive scan across the pool in a log-depth up and down sweep.
+  // Each pool_reduce_local() holds three values of 'value_size' bytes:
+  //   [ contribution , prefix , subtree total ]
+  // On return the prefix is the combined contributions of all lower
+  // ranks, set with init( dst ) and join( dst , src ), and the pool root's
+  // subtree total is the total of the pool.
+  // Every thread of the pool calls this once its contribution is complete.
+  template <class Init, class Join>
+  void pool_scan_tree(const size_t value_size, Init const& init,
+                      Join const& join) const noexcept {
+    auto value = [value_size](HostThreadTeamData const& d, const int i) {
+      return ((char*)d.pool_reduce_local()) + i * value_size;
+    };
+    auto total = [&value](HostThreadTeamData const& d) { return value(d, 2); };
+
+    HostThreadTeamData* const* const pool =
+        (HostThreadTeamData**)(m_pool_scratch + m_pool_members);
+    const int step = ++m_pool_reduce_step;
+
+    init(total(*this));
+    join(total(*this), value(*this, 0));
+    tree_combine(pool, m_pool_rank, m_pool_size, m_pool_reduce_arrive, step,
+                 total, join);
+
+    if (m_pool_rank) {
+      spinwait_until_equal(reduce_flag(m_pool_scan_release), step);
+    } else {
+      init(value(*this, 1));
+    }
+
+    // Children's prefixes in rank order: a child follows this thread and
+    // the subtrees of the children before it.  All are set before any
+    // child is released, as released children update their prefix.
+    int d = 1;
+    char* prev_prefix = value(*this, 1);
+    char* prev_value  = value(*this, 0);
+    for (; d < m_pool_size - m_pool_rank && !(m_pool_rank & d); d <<= 1) {
+      HostThreadTeamData const& child = *pool[m_pool_rank + d];
+      init(value(child, 1));
+      join(value(child, 1), prev_prefix);
+      join(value(child, 1), prev_value);
+      prev_prefix = value(child, 1);
+      prev_value  = total(child);
+    }
+    memory_fence();
+    while (1 < d) {
+      d >>= 1;
+      pool[m_pool_rank + d]->reduce_flag(m_pool_scan_release) = step;
+    }
+  }
+
   int64_t* team_reduce() const noexcept {
     return m_team_scratch + m_team_reduce;
   }
@@ -366,9 +502,42 @@ fflush(stdout);
   //----------------------------------------
   // Get a work index within the range.
   // First try to steal from beginning of own teams's partition.
-  // If that fails then try to steal from end of another teams' partition.
+  // If that fails then try to steal from end of another teams' partition,
+  // nearest teams first when the pool spans NUMA domains.
   int get_work_stealing() noexcept;
 
+  //----------------------------------------
+  // Record where this thread runs, as given by
+  // Kokkos::hwloc::get_this_thread_numa_location(), before organize_pool.
+
+  void set_numa_location(std::pair<unsigned, unsigned> const loc) noexcept {
+    m_numa_socket = loc.first;
+    m_numa_domain = loc.second;
+  }
+
+  // Steal from teams in the same NUMA domain, then the same socket, before
+  // crossing sockets.  On by default; off steals round robin.
+  static void set_numa_stealing(bool enable) noexcept;
+  static bool numa_stealing() noexcept;
+
+ private:
+  // Order the other teams for work stealing; called whenever teams change
+  void order_steal_victims() noexcept;
+
+  int next_steal_rank() noexcept {
+    if (m_steal_count < 0 || !numa_stealing()) {
+      // Round robin: the next team is offset by m_team_alloc if it fits in
+      // the pool.
+      return m_steal_rank + m_team_alloc + m_team_size <= m_pool_size
+                 ? m_steal_rank + m_team_alloc
+                 : 0;
+    }
+    return m_steal_next < m_steal_count ? m_steal_order[m_steal_next++]
+                                        : m_pool_rank;
+  }
+
+ public:
+
   //----------------------------------------
   // Set the initial work partitioning of [ 0 .. length ) among the teams
   // with granularity of chunk
@@ -390,12 +559,13 @@ fflush(stdout);
     m_work_range.first  = part * m_league_rank;
     m_work_range.second = m_work_range.first + part;
 
-    // Steal from next team, round robin
-    // The next team is offset by m_team_alloc if it fits in the pool.
+    // Steal from the nearest team, or round robin from the next team.
+
+    m_steal_rank = m_team_base;
+    m_steal_next = 0;
+    m_steal_rank = next_steal_rank();
 
-    m_steal_rank = m_team_base + m_team_alloc + m_team_size <= m_pool_size
-                       ? m_team_base + m_team_alloc
-                       : 0;
+    if (0 == m_pool_rank) m_work_next = 0;
   }
 
   std::pair<int64_t, int64_t> get_work_partition() noexcept {
@@ -420,8 +590,79 @@ fflush(stdout);
 
     return x;
   }
+
+  //----------------------------------------
+  // Claim the next chunk of [ 0 .. m_work_end ) from a counter shared by
+  // the pool.  Guided chunks are a share of the remaining work, so they
+  // shrink as it drains, but are never shorter than the work chunk;
+  // otherwise every chunk is the work chunk.
+  // Requires a pool rendezvous after set_work_partition.
+
+  std::pair<int64_t, int64_t> get_work_shared_chunk(bool guided) noexcept;
+};
+
+//----------------------------------------------------------------------------
+// Chunk size of one kernel under Schedule<Adaptive>, chosen from the
+// per-thread timings of its earlier launches.  The longest chunk should be
+// a small fraction of a thread's share of the work, which bounds the tail
+// imbalance, while chunks stay long enough to amortize claiming them.
+
+class HostAdaptiveChunk {
+ public:
+  struct Sample {
+    double busy;     // seconds spent in chunks
+    double longest;  // seconds of the longest chunk
+  };
+
+  // Chunk for a launch over 'length' iterations
+  int64_t chunk(int64_t length, int pool_size,
+                int64_t policy_chunk) const noexcept;
+
+  // Learn from a launch over 'length' iterations that used chunk 'used'
+  void update(int64_t length, int64_t used, const Sample* samples,
+              int pool_size) noexcept;
+
+  // Claim and run chunks with 'exec(begin, end)' until the work is drained
+  template <class ExecRange>
+  static Sample run(HostThreadTeamData& data, const ExecRange& exec) {
+    Sample sample = {0, 0};
+    for (std::pair<int64_t, int64_t> range = data.get_work_shared_chunk(false);
+         0 <= range.first; range = data.get_work_shared_chunk(false)) {
+      const auto start = std::chrono::steady_clock::now();
+      exec(range.first, range.second);
+      const double dt = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+      sample.busy += dt;
+      sample.longest = dt < sample.longest ? sample.longest : dt;
+    }
+    return sample;
+  }
+
+ private:
+  std::atomic<int64_t> m_chunk{0};
 };
 
+// Every launch of a functor type with a policy type is the same kernel.
+// Only Schedule<Adaptive> policies get a tuner, other schedules get nullptr
+// without instantiating one.
+template <class FunctorType, class Policy>
+typename std::enable_if<std::is_same<typename Policy::schedule_type::type,
+                                     Kokkos::Adaptive>::value,
+                        HostAdaptiveChunk*>::type
+host_adaptive_chunk() noexcept {
+  static HostAdaptiveChunk tuner;
+  return &tuner;
+}
+
+template <class FunctorType, class Policy>
+typename std::enable_if<!std::is_same<typename Policy::schedule_type::type,
+                                      Kokkos::Adaptive>::value,
+                        HostAdaptiveChunk*>::type
+host_adaptive_chunk() noexcept {
+  return nullptr;
+}
+
 //----------------------------------------------------------------------------
 
 template <class HostExecSpace>
@@ -603,9 +844,39 @@ class HostThreadTeamMember {
                   typename ReducerType::value_type contribution) const noexcept
 #if defined(KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST)
   {
-    if (1 < m_data.m_team_size) {
-      using value_type = typename ReducerType::value_type;
+    using value_type = typename ReducerType::value_type;
+
+    if (1 < m_data.m_team_size &&
+        2 * sizeof(value_type) <= size_t(m_data.team_reduce_bytes())) {
+      // Members combine in a tree in the second slot of their local buffer.
+      // The root broadcasts through the first, which readers of the
+      // previous result may still load until they reach the rendezvous.
+
+      *((value_type*)m_data.team_reduce_local() + 1) = contribution;
+
+      m_data.tree_combine(
+          (HostThreadTeamData**)(m_data.m_pool_scratch +
+                                 HostThreadTeamData::m_pool_members) +
+              m_data.m_team_base,
+          m_data.m_team_rank, m_data.m_team_size,
+          HostThreadTeamData::m_team_reduce_arrive,
+          ++m_data.m_team_reduce_step,
+          [](HostThreadTeamData const& d) {
+            return (value_type*)d.team_reduce_local() + 1;
+          },
+          [&reducer](value_type* dst, value_type* src) {
+            reducer.join(*dst, *src);
+          });
 
+      if (m_data.team_rendezvous()) {
+        value_type* const local = (value_type*)m_data.team_reduce_local();
+        *((value_type*)m_data.team_reduce()) = local[1];
+        reducer.reference()                  = local[1];
+        m_data.team_rendezvous_release();
+      } else {
+        reducer.reference() = *((value_type*)m_data.team_reduce());
+      }
+    } else if (1 < m_data.m_team_size) {
       if (0 != m_data.m_team_rank) {
         // Non-root copies to their local buffer:
         /*reducer.copy( (value_type*) m_data.team_reduce_local()
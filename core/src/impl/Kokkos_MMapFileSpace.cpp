@@ -0,0 +1,486 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <Kokkos_Macros.hpp>
+#if !defined(_WIN32)
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_MMapFileSpace.hpp>
+#include <impl/Kokkos_Error.hpp>
+#if defined(KOKKOS_ENABLE_PROFILING)
+#include <impl/Kokkos_Profiling_Interface.hpp>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*--------------------------------------------------------------------------*/
+
+namespace Kokkos {
+namespace Experimental {
+namespace {
+
+// 64 MiB chunks keep per-chunk overhead negligible while leaving room for
+// the prefetched chunks in the page cache.
+constexpr size_t default_copy_chunk_size  = size_t(64) << 20;
+constexpr int default_copy_prefetch_depth = 2;
+
+std::atomic<size_t> s_copy_chunk_size(default_copy_chunk_size);
+std::atomic<int> s_copy_prefetch_depth(default_copy_prefetch_depth);
+
+size_t round_up_to_page(const size_t n) {
+  const size_t page = MMapFileSpace::page_size();
+  return ((n + page - 1) / page) * page;
+}
+
+int advice_flag(const MMapFileSpace::Advice advice) {
+  switch (advice) {
+    case MMapFileSpace::Sequential: return MADV_SEQUENTIAL;
+    case MMapFileSpace::Random: return MADV_RANDOM;
+    case MMapFileSpace::WillNeed: return MADV_WILLNEED;
+    case MMapFileSpace::DontNeed: return MADV_DONTNEED;
+    default: return MADV_NORMAL;
+  }
+}
+
+[[noreturn]] void throw_file_error(const char* what, const std::string& path,
+                                   const int err) {
+  std::string msg("Kokkos::Experimental::MMapFileSpace: ");
+  msg += what;
+  msg += " '";
+  msg += path;
+  msg += "' failed: ";
+  msg += strerror(err);
+  Kokkos::Impl::throw_runtime_exception(msg);
+  std::abort();  // unreachable
+}
+
+/* Map \c arg_size bytes of the open file \c fd behind one anonymous page
+ * that holds the allocation header, so the returned pointer is page
+ * aligned and the header never touches the file.
+ */
+void* map_file(const int fd, const std::string& path, const size_t arg_size,
+               const MMapFileSpace::Advice advice) {
+  const size_t page   = MMapFileSpace::page_size();
+  const size_t mapped = round_up_to_page(arg_size);
+
+  if (arg_size) {
+    struct stat st;
+    if (fstat(fd, &st) != 0) throw_file_error("stat", path, errno);
+    if (size_t(st.st_size) < arg_size &&
+        ftruncate(fd, off_t(arg_size)) != 0) {
+      throw_file_error("resize", path, errno);
+    }
+  }
+
+  void* const base = mmap(nullptr, page + mapped, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (base == MAP_FAILED) throw_file_error("reserve mapping for", path, errno);
+
+  char* const ptr = static_cast<char*>(base) + page;
+
+  if (mapped) {
+    void* const data = mmap(ptr, mapped, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_FIXED, fd, 0);
+    if (data == MAP_FAILED) {
+      const int err = errno;
+      munmap(base, page + mapped);
+      throw_file_error("map", path, err);
+    }
+    if (advice != MMapFileSpace::Normal) {
+      madvise(ptr, mapped, advice_flag(advice));
+    }
+  }
+  return ptr;
+}
+
+}  // namespace
+
+MMapFileSpace::MMapFileSpace() : m_directory("."), m_advice(Normal) {}
+
+MMapFileSpace::MMapFileSpace(const std::string& arg_directory,
+                             const Advice arg_advice)
+    : m_directory(arg_directory.empty() ? std::string(".") : arg_directory),
+      m_advice(arg_advice) {}
+
+size_t MMapFileSpace::page_size() {
+  static const size_t page = size_t(sysconf(_SC_PAGESIZE));
+  return page;
+}
+
+size_t MMapFileSpace::copy_chunk_size() { return s_copy_chunk_size; }
+
+void MMapFileSpace::set_copy_chunk_size(const size_t arg_chunk_size) {
+  s_copy_chunk_size = arg_chunk_size ? round_up_to_page(arg_chunk_size)
+                                     : default_copy_chunk_size;
+}
+
+int MMapFileSpace::copy_prefetch_depth() { return s_copy_prefetch_depth; }
+
+void MMapFileSpace::set_copy_prefetch_depth(const int arg_depth) {
+  s_copy_prefetch_depth = arg_depth < 0 ? 0 : arg_depth;
+}
+
+void* MMapFileSpace::allocate(const size_t arg_alloc_size) const {
+  std::string path = m_directory + "/kokkos_mmap.XXXXXX";
+  std::vector<char> name(path.begin(), path.end());
+  name.push_back(0);
+
+  const int fd = mkstemp(name.data());
+  if (fd < 0) throw_file_error("create", path, errno);
+  path = name.data();
+  unlink(name.data());
+
+  void* ptr = nullptr;
+  try {
+    ptr = map_file(fd, path, arg_alloc_size, m_advice);
+  } catch (...) {
+    close(fd);
+    throw;
+  }
+  close(fd);
+  return ptr;
+}
+
+void* MMapFileSpace::allocate(const std::string& arg_label,
+                              const size_t arg_alloc_size) const {
+  if (arg_label.empty()) return allocate(arg_alloc_size);
+
+  const std::string path =
+      arg_label[0] == '/' ? arg_label : m_directory + "/" + arg_label;
+
+  const int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd < 0) throw_file_error("open", path, errno);
+
+  void* ptr = nullptr;
+  try {
+    ptr = map_file(fd, path, arg_alloc_size, m_advice);
+  } catch (...) {
+    close(fd);
+    throw;
+  }
+  close(fd);
+  return ptr;
+}
+
+void MMapFileSpace::deallocate(void* const arg_alloc_ptr,
+                               const size_t arg_alloc_size) const {
+  if (arg_alloc_ptr) {
+    const size_t page = page_size();
+    munmap(static_cast<char*>(arg_alloc_ptr) - page,
+           page + round_up_to_page(arg_alloc_size));
+  }
+}
+
+void MMapFileSpace::advise(const void* const arg_ptr, const size_t arg_size,
+                           const Advice arg_advice) {
+  if (!arg_ptr || !arg_size) return;
+  const uintptr_t page  = page_size();
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(arg_ptr) & ~(page - 1);
+  const uintptr_t end   = reinterpret_cast<uintptr_t>(arg_ptr) + arg_size;
+  // Advice is only a hint; failure leaves the default paging behavior.
+  madvise(reinterpret_cast<void*>(begin), end - begin,
+          advice_flag(arg_advice));
+}
+
+void MMapFileSpace::sync(void* const arg_ptr, const size_t arg_size) {
+  if (!arg_ptr || !arg_size) return;
+  const uintptr_t page  = page_size();
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(arg_ptr) & ~(page - 1);
+  const uintptr_t end   = reinterpret_cast<uintptr_t>(arg_ptr) + arg_size;
+  if (msync(reinterpret_cast<void*>(begin), end - begin, MS_SYNC) != 0) {
+    throw_file_error("sync", "mapping", errno);
+  }
+}
+
+}  // namespace Experimental
+}  // namespace Kokkos
+
+//----------------------------------------------------------------------------
+
+namespace Kokkos {
+namespace Impl {
+
+MMapFileSpaceCopyChunk::MMapFileSpaceCopyChunk(const char* dst_space,
+                                               const void* dst,
+                                               const char* src_space,
+                                               const void* src, size_t n) {
+#if defined(KOKKOS_ENABLE_PROFILING)
+  if (Kokkos::Profiling::profileLibraryLoaded()) {
+    Kokkos::Profiling::beginDeepCopy(
+        Kokkos::Profiling::SpaceHandle(dst_space), "(chunk)", dst,
+        Kokkos::Profiling::SpaceHandle(src_space), "(chunk)", src, n);
+  }
+#else
+  (void)dst_space;
+  (void)dst;
+  (void)src_space;
+  (void)src;
+  (void)n;
+#endif
+}
+
+MMapFileSpaceCopyChunk::~MMapFileSpaceCopyChunk() {
+#if defined(KOKKOS_ENABLE_PROFILING)
+  if (Kokkos::Profiling::profileLibraryLoaded()) {
+    Kokkos::Profiling::endDeepCopy();
+  }
+#endif
+}
+
+MMapFileSpacePrefetcher::MMapFileSpacePrefetcher(const void* src, size_t n,
+                                                 size_t chunk)
+    : m_src(static_cast<const char*>(src)),
+      m_size(n),
+      m_chunk(chunk),
+      m_depth(Kokkos::Experimental::MMapFileSpace::copy_prefetch_depth()) {
+  if (!m_src || !m_chunk) return;
+  // The first chunk is faulted in by the copy itself.
+  for (size_t k = 1; k <= m_depth && k * m_chunk < m_size; ++k) {
+    Kokkos::Experimental::MMapFileSpace::advise(
+        m_src + k * m_chunk, std::min(m_chunk, m_size - k * m_chunk),
+        Kokkos::Experimental::MMapFileSpace::WillNeed);
+  }
+}
+
+void MMapFileSpacePrefetcher::advance(size_t k) {
+  if (!m_src || !m_chunk || !m_depth) return;
+  const size_t off = (k + m_depth) * m_chunk;
+  if (k && off < m_size) {
+    Kokkos::Experimental::MMapFileSpace::advise(
+        m_src + off, std::min(m_chunk, m_size - off),
+        Kokkos::Experimental::MMapFileSpace::WillNeed);
+  }
+}
+
+void mmap_file_space_pipelined_copy(void* dst, const char* dst_space,
+                                    const void* src, const char* src_space,
+                                    size_t n, bool src_is_mapped) {
+  const size_t chunk = Kokkos::Experimental::MMapFileSpace::copy_chunk_size();
+
+  MMapFileSpacePrefetcher prefetch(src_is_mapped ? src : nullptr, n, chunk);
+
+  for (size_t k = 0, off = 0; off < n; ++k, off += chunk) {
+    char* const d       = static_cast<char*>(dst) + off;
+    const char* const s = static_cast<const char*>(src) + off;
+    const size_t len    = std::min(chunk, n - off);
+    prefetch.advance(k);
+    MMapFileSpaceCopyChunk region(dst_space, d, src_space, s, len);
+    hostspace_parallel_deepcopy(d, s, len);
+  }
+}
+
+}  // namespace Impl
+}  // namespace Kokkos
+
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+
+namespace Kokkos {
+namespace Impl {
+
+#ifdef KOKKOS_DEBUG
+SharedAllocationRecord<void, void> SharedAllocationRecord<
+    Kokkos::Experimental::MMapFileSpace, void>::s_root_record;
+#endif
+
+void SharedAllocationRecord<Kokkos::Experimental::MMapFileSpace, void>::
+    deallocate(SharedAllocationRecord<void, void>* arg_rec) {
+  delete static_cast<SharedAllocationRecord*>(arg_rec);
+}
+
+SharedAllocationRecord<Kokkos::Experimental::MMapFileSpace,
+                       void>::~SharedAllocationRecord()
+#if defined( \
+    KOKKOS_IMPL_INTEL_WORKAROUND_NOEXCEPT_SPECIFICATION_VIRTUAL_FUNCTION)
+    noexcept
+#endif
+{
+#if defined(KOKKOS_ENABLE_PROFILING)
+  if (Kokkos::Profiling::profileLibraryLoaded()) {
+    Kokkos::Profiling::deallocateData(
+        Kokkos::Profiling::SpaceHandle(
+            Kokkos::Experimental::MMapFileSpace::name()),
+        RecordBase::m_alloc_ptr->m_label, data(), size());
+  }
+#endif
+
+  m_space.deallocate(data(), size());
+}
+
+SharedAllocationRecord<Kokkos::Experimental::MMapFileSpace, void>::
+    SharedAllocationRecord(
+        const Kokkos::Experimental::MMapFileSpace& arg_space,
+        const std::string& arg_label, const size_t arg_alloc_size,
+        const SharedAllocationRecord<void, void>::function_type arg_dealloc)
+    // The space maps the file behind a page holding the header
+    // Pass through allocated [ SharedAllocationHeader , user_memory ]
+    // Pass through deallocation function
+    : SharedAllocationRecord<void, void>(
+#ifdef KOKKOS_DEBUG
+          &SharedAllocationRecord<Kokkos::Experimental::MMapFileSpace,
+                                  void>::s_root_record,
+#endif
+          reinterpret_cast<SharedAllocationHeader*>(
+              arg_space.allocate(arg_label, arg_alloc_size)) -
+              1,
+          sizeof(SharedAllocationHeader) + arg_alloc_size, arg_dealloc),
+      m_space(arg_space) {
+#if defined(KOKKOS_ENABLE_PROFILING)
+  if (Kokkos::Profiling::profileLibraryLoaded()) {
+    Kokkos::Profiling::allocateData(
+        Kokkos::Profiling::SpaceHandle(arg_space.name()), arg_label, data(),
+        arg_alloc_size);
+  }
+#endif
+  // Fill in the Header information
+  RecordBase::m_alloc_ptr->m_record =
+      static_cast<SharedAllocationRecord<void, void>*>(this);
+
+  // Copy at most maximum_label_length - 1 characters and always terminate
+  const size_t label_length =
+      std::min(arg_label.size(),
+               size_t(SharedAllocationHeader::maximum_label_length - 1));
+  std::memcpy(RecordBase::m_alloc_ptr->m_label, arg_label.c_str(),
+              label_length);
+  RecordBase::m_alloc_ptr->m_label[label_length] = (char)0;
+}
+
+//----------------------------------------------------------------------------
+
+void* SharedAllocationRecord<Kokkos::Experimental::MMapFileSpace, void>::
+    allocate_tracked(const Kokkos::Experimental::MMapFileSpace& arg_space,
+                     const std::string& arg_alloc_label,
+                     const size_t arg_alloc_size) {
+  if (!arg_alloc_size) return nullptr;
+
+  SharedAllocationRecord* const r =
+      allocate(arg_space, arg_alloc_label, arg_alloc_size);
+
+  RecordBase::increment(r);
+
+  return r->data();
+}
+
+void SharedAllocationRecord<Kokkos::Experimental::MMapFileSpace, void>::
+    deallocate_tracked(void* const arg_alloc_ptr) {
+  if (arg_alloc_ptr != nullptr) {
+    SharedAllocationRecord* const r = get_record(arg_alloc_ptr);
+
+    RecordBase::decrement(r);
+  }
+}
+
+void* SharedAllocationRecord<Kokkos::Experimental::MMapFileSpace, void>::
+    reallocate_tracked(void* const arg_alloc_ptr, const size_t arg_alloc_size) {
+  SharedAllocationRecord* const r_old = get_record(arg_alloc_ptr);
+  // Remapping the same labeled file would alias the old data, so the new
+  // allocation is backed by a temporary file.
+  SharedAllocationRecord* const r_new =
+      allocate(r_old->m_space, std::string(), arg_alloc_size);
+
+  Kokkos::Impl::DeepCopy<Kokkos::Experimental::MMapFileSpace,
+                         Kokkos::Experimental::MMapFileSpace>(
+      r_new->data(), r_old->data(), std::min(r_old->size(), r_new->size()));
+
+  RecordBase::increment(r_new);
+  RecordBase::decrement(r_old);
+
+  return r_new->data();
+}
+
+SharedAllocationRecord<Kokkos::Experimental::MMapFileSpace, void>*
+SharedAllocationRecord<Kokkos::Experimental::MMapFileSpace, void>::get_record(
+    void* alloc_ptr) {
+  typedef SharedAllocationHeader Header;
+  typedef SharedAllocationRecord<Kokkos::Experimental::MMapFileSpace, void>
+      RecordMMap;
+
+  SharedAllocationHeader const* const head =
+      alloc_ptr ? Header::get_header(alloc_ptr) : nullptr;
+  RecordMMap* const record =
+      head ? static_cast<RecordMMap*>(head->m_record) : nullptr;
+
+  if (!alloc_ptr || record->m_alloc_ptr != head) {
+    Kokkos::Impl::throw_runtime_exception(std::string(
+        "Kokkos::Impl::SharedAllocationRecord< "
+        "Kokkos::Experimental::MMapFileSpace , void >::get_record ERROR"));
+  }
+
+  return record;
+}
+
+// Iterate records to print orphaned memory ...
+#ifdef KOKKOS_DEBUG
+void SharedAllocationRecord<Kokkos::Experimental::MMapFileSpace, void>::
+    print_records(std::ostream& s, const Kokkos::Experimental::MMapFileSpace&,
+                  bool detail) {
+  SharedAllocationRecord<void, void>::print_host_accessible_records(
+      s, "MMapFileSpace", &s_root_record, detail);
+}
+#else
+void SharedAllocationRecord<Kokkos::Experimental::MMapFileSpace, void>::
+    print_records(std::ostream&, const Kokkos::Experimental::MMapFileSpace&,
+                  bool) {
+  throw_runtime_exception(
+      "SharedAllocationRecord<MMapFileSpace>::print_records only works with "
+      "KOKKOS_DEBUG enabled");
+}
+#endif
+
+}  // namespace Impl
+}  // namespace Kokkos
+
+#endif  // !defined(_WIN32)
@@ -44,6 +44,10 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
 namespace Kokkos {
 namespace Impl {
 
@@ -305,115 +309,145 @@ SharedAllocationRecord<void, void>* SharedAllocationRecord<
   return arg_record;
 }
 
-MirrorTracker* SharedAllocationRecord<void, void>::mirror_list = nullptr;
+namespace {
+
+struct MirrorSpaceIndex {
+  MirrorTracker* head = nullptr;
+  std::unordered_map<std::string, MirrorTracker*> labels;
+};
+
+struct MirrorIndex {
+  std::mutex mutex;
+  std::unordered_map<std::string, MirrorSpaceIndex> spaces;
+  // Both the dst and the src record of every mirror
+  std::unordered_map<const void*, MirrorTracker*> records;
+
+  void index_records(MirrorTracker* m) {
+    records[m->dst] = m;
+    records[m->src] = m;
+  }
+
+  void forget_records(MirrorTracker* m) {
+    for (const void* r : {m->dst, m->src}) {
+      auto loc = records.find(r);
+      if (loc != records.end() && loc->second == m) records.erase(loc);
+    }
+  }
+
+  void erase(MirrorTracker* m) {
+    MirrorSpaceIndex& space = spaces[m->mem_space_name];
+    if (m->pPrev) {
+      m->pPrev->pNext = m->pNext;
+    } else {
+      space.head = m->pNext;
+    }
+    if (m->pNext) m->pNext->pPrev = m->pPrev;
+    space.labels.erase(m->label);
+    forget_records(m);
+    delete m;
+  }
+};
+
+MirrorIndex& mirror_index() {
+  static MirrorIndex index;
+  return index;
+}
+
+}  // namespace
+
+const MirrorTracker* SharedAllocationRecord<void, void>::get_mirror_list(
+    const std::string& mem_space) {
+  MirrorIndex& index = mirror_index();
+  std::lock_guard<std::mutex> lock(index.mutex);
+  auto loc = index.spaces.find(mem_space);
+  return loc != index.spaces.end() ? loc->second.head : nullptr;
+}
+
+const MirrorTracker* SharedAllocationRecord<void, void>::get_mirror_entry(
+    const std::string& mem_space, const std::string& lbl) {
+  MirrorIndex& index = mirror_index();
+  std::lock_guard<std::mutex> lock(index.mutex);
+  auto space = index.spaces.find(mem_space);
+  if (space == index.spaces.end()) return nullptr;
+  auto loc = space->second.labels.find(lbl);
+  return loc != space->second.labels.end() ? loc->second : nullptr;
+}
+
+// The copies are made while holding the lock, so that a concurrent track or
+// release cannot free the nodes being copied
 MirrorTracker* SharedAllocationRecord<void, void>::get_filtered_mirror_list(
     const std::string mem_space) {
+  MirrorIndex& index = mirror_index();
+  std::lock_guard<std::mutex> lock(index.mutex);
+  auto space = index.spaces.find(mem_space);
+  if (space == index.spaces.end()) return nullptr;
   MirrorTracker* return_list = nullptr;
-  if (mirror_list == nullptr) {
-    //    printf("get_filtered mirror list --- ah there's no list...\n");
-  }
-  MirrorTracker* pSrch = mirror_list;
-  while (pSrch != nullptr) {
-    // printf("searching list: %s, %s \n", pSrch->mem_space_name.c_str(),
-    // pSrch->label.c_str());
-    if (pSrch->mem_space_name == mem_space) {
-      MirrorTracker* pNew = new MirrorTracker(*pSrch);
-      if (return_list == nullptr) {
-        return_list = pNew;
-      } else {
-        pNew->pNext        = return_list;
-        return_list->pPrev = pNew;
-        return_list        = pNew;
-      }
+  for (const MirrorTracker* m = space->second.head; m != nullptr;
+       m = m->pNext) {
+    MirrorTracker* pNew = new MirrorTracker(*m);
+    if (return_list != nullptr) {
+      pNew->pNext        = return_list;
+      return_list->pPrev = pNew;
     }
-    pSrch = pSrch->pNext;
+    return_list = pNew;
   }
-
   return return_list;
 }
 
 MirrorTracker* SharedAllocationRecord<void, void>::get_filtered_mirror_entry(
     const std::string mem_space, const std::string lbl) {
-  MirrorTracker* return_entry = nullptr;
-  MirrorTracker* pSrch        = mirror_list;
-  while (pSrch != nullptr) {
-    if (pSrch->mem_space_name == mem_space && pSrch->label == lbl) {
-      return_entry = new MirrorTracker(*pSrch);
-      break;
-    }
-    pSrch = pSrch->pNext;
-  }
-  return return_entry;
+  MirrorIndex& index = mirror_index();
+  std::lock_guard<std::mutex> lock(index.mutex);
+  auto space = index.spaces.find(mem_space);
+  if (space == index.spaces.end()) return nullptr;
+  auto loc = space->second.labels.find(lbl);
+  return loc != space->second.labels.end() ? new MirrorTracker(*loc->second)
+                                           : nullptr;
 }
+
 // note that the dst_ and src_pointers are pointing to the data() element of the
 // record...need to extract the record pointer from that
 void SharedAllocationRecord<void, void>::track_mirror(
     const std::string mem_space, const std::string lbl, void* dst_,
     void* src_) {
-  MirrorTracker* pTrack = nullptr;
-  MirrorTracker* pSrch  = mirror_list;
-  while (pSrch != nullptr) {
-    if (pSrch->label == lbl) {
-      pTrack = pSrch;
-      break;
-    }
-    pSrch = pSrch->pNext;
-  }
-  bool bAddToList = false;
+  MirrorIndex& index = mirror_index();
+  std::lock_guard<std::mutex> lock(index.mutex);
+
+  MirrorSpaceIndex& space = index.spaces[mem_space];
+  MirrorTracker*& pTrack  = space.labels[lbl];
   if (pTrack == nullptr) {
-    pTrack        = new MirrorTracker();
-    pTrack->label = lbl;
-    bAddToList    = true;
+    pTrack                 = new MirrorTracker();
+    pTrack->label          = lbl;
+    pTrack->mem_space_name = mem_space;
+    pTrack->pNext          = space.head;
+    if (space.head != nullptr) space.head->pPrev = pTrack;
+    space.head = pTrack;
+  } else {
+    index.forget_records(pTrack);
   }
   SharedAllocationHeader* pDstHeader = (((SharedAllocationHeader*)dst_) - 1);
   pTrack->dst                        = pDstHeader->m_record;
   SharedAllocationHeader* pSrcHeader = (((SharedAllocationHeader*)src_) - 1);
   pTrack->src                        = pSrcHeader->m_record;
-  pTrack->mem_space_name             = mem_space;
-
-  if (bAddToList) {
-    // JSM TODO need some type of locking mechanism here ...
-    if (mirror_list == nullptr) {
-      //      printf("initializing new list: %s, %s \n",
-      //      pTrack->mem_space_name.c_str(), pTrack->label.c_str());
-      mirror_list = pTrack;
-    } else {
-      //      printf("inserting into list: %s, %s \n",
-      //      pTrack->mem_space_name.c_str(), pTrack->label.c_str());
-      pTrack->pNext      = mirror_list;
-      mirror_list->pPrev = pTrack;
-      mirror_list        = pTrack;
-    }
-  }
+  index.index_records(pTrack);
 }
 
 void SharedAllocationRecord<void, void>::release_mirror(void* dst_) {
-  MirrorTracker* pSrch = mirror_list;
-  while (pSrch != nullptr) {
-    if (pSrch->dst == dst_ || pSrch->src == dst_) {
-      // JSM TODO need some type of locking mechanism here ...
-      if (pSrch->pNext != nullptr) pSrch->pNext->pPrev = pSrch->pPrev;
-      if (pSrch->pPrev != nullptr) pSrch->pPrev->pNext = pSrch->pNext;
-      delete pSrch;
-      break;
-    }
-    pSrch = pSrch->pNext;
-  }
+  MirrorIndex& index = mirror_index();
+  std::lock_guard<std::mutex> lock(index.mutex);
+  auto loc = index.records.find(dst_);
+  if (loc != index.records.end()) index.erase(loc->second);
 }
 
 void SharedAllocationRecord<void, void>::release_mirror(const std::string lbl) {
-  MirrorTracker* pSrch = mirror_list;
-  while (pSrch != nullptr) {
-    if (pSrch->label == lbl) {
-      // JSM TODO need some type of locking mechanism here ...
-      if (pSrch->pNext != nullptr) pSrch->pNext->pPrev = pSrch->pPrev;
-      if (pSrch->pPrev != nullptr) pSrch->pPrev->pNext = pSrch->pNext;
-      delete pSrch;
-      break;
-    }
-    pSrch = pSrch->pNext;
+  MirrorIndex& index = mirror_index();
+  std::lock_guard<std::mutex> lock(index.mutex);
+  for (auto& space : index.spaces) {
+    auto loc = space.second.labels.find(lbl);
+    if (loc != space.second.labels.end()) index.erase(loc->second);
   }
 }
+
 #ifdef KOKKOS_DEBUG
 void SharedAllocationRecord<void, void>::print_host_accessible_records(
     std::ostream& s, const char* const space_name,
@@ -93,6 +93,11 @@ class SharedAllocationHeader {
   const char* label() const { return m_label; }
 };
 
+/// \brief Mirror of a view tracked for checkpoint and restart.
+///
+/// Tracked mirrors of one memory space form a list through pNext/pPrev,
+/// owned by SharedAllocationRecord<void,void>.  Copies returned by
+/// get_filtered_mirror_list are owned by the caller.
 struct MirrorTracker {
   std::string label;
   void* dst;
@@ -231,17 +236,27 @@ class SharedAllocationRecord<void, void> {
   static SharedAllocationRecord* find(SharedAllocationRecord* const,
                                       void* const);
 
+  /* Mirrors are indexed by memory space name and label, and by record.
+   * Tracking and release are serialized internally; the lists returned by
+   * get_mirror_list stay valid until the next track or release call.
+   */
   static void track_mirror(const std::string mem_space, const std::string lbl,
                            void* dst_, void* src_);
   static void release_mirror(void* dst);
   static void release_mirror(const std::string label);
 
+  /* Tracked mirrors of 'mem_space', iterate with pNext; nothing allocated */
+  static const MirrorTracker* get_mirror_list(const std::string& mem_space);
+  static const MirrorTracker* get_mirror_entry(const std::string& mem_space,
+                                               const std::string& lbl);
+
+  /* Caller owned copies of the above, the list is linked through pNext.
+   * They are taken under the lock and are safe against concurrent tracking.
+   */
   static MirrorTracker* get_filtered_mirror_list(const std::string mem_space);
   static MirrorTracker* get_filtered_mirror_entry(const std::string mem_space,
                                                   const std::string lbl);
 
-  static MirrorTracker* mirror_list;
-
   /*  Sanity check for the whole set of records to which the input record
    * belongs. Locks the set's insert/erase operations until the sanity check is
    * complete.
@@ -48,6 +48,20 @@
 #include <Kokkos_Atomic.hpp>
 #include <impl/Kokkos_Spinwait.hpp>
 #include <impl/Kokkos_BitOps.hpp>
+#include <impl/Kokkos_Profiling_Interface.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <string>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define KOKKOS_IMPL_HOST_FUTEX
+#endif
 
 #if defined(KOKKOS_ENABLE_STDTHREAD) || defined(_WIN32)
 #include <thread>
@@ -151,6 +165,134 @@ void host_thread_yield(const uint32_t i, const WaitMode mode) {
 #endif /* defined( KOKKOS_ENABLE_ASM ) */
 }
 
+//----------------------------------------------------------------------------
+
+namespace {
+
+// Spin iterations of a hybrid wait before it sleeps, on the order of 100us
+constexpr uint32_t hybrid_spin_limit = 1 << 12;
+
+std::atomic<int> s_wait_policy(int(WaitPolicy::HYBRID));
+
+std::atomic<int> s_sleepers(0);
+std::atomic<uint64_t> s_wake_ns(0);
+
+std::atomic<uint64_t> s_sleeps(0);
+std::atomic<uint64_t> s_wakeup_ns(0);
+std::atomic<uint64_t> s_spin_ns(0);
+
+uint64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+void set_host_wait_policy(const WaitPolicy policy) {
+  s_wait_policy.store(int(policy), std::memory_order_relaxed);
+}
+
+WaitPolicy host_wait_policy() {
+  return WaitPolicy(s_wait_policy.load(std::memory_order_relaxed));
+}
+
+void host_thread_wait_while_equal(int volatile& flag, const int value) {
+  Kokkos::store_fence();
+  if (value != flag) {
+    Kokkos::load_fence();
+    return;
+  }
+
+  // Timing the spin costs two clock reads and a shared atomic per wait,
+  // only pay for it when a tool will see the result.
+  const WaitPolicy policy = host_wait_policy();
+  const bool timed        = Kokkos::Profiling::profileLibraryLoaded();
+  const uint64_t start    = timed ? now_ns() : 0;
+  uint32_t i              = 0;
+
+  if (policy == WaitPolicy::ACTIVE) {
+    while (value == flag) {
+      host_thread_yield(++i, WaitMode::ACTIVE);
+    }
+  } else if (policy == WaitPolicy::HYBRID) {
+    while (value == flag && i < hybrid_spin_limit) {
+      host_thread_yield(++i, WaitMode::ROOT);
+    }
+  }
+
+  if (value != flag) {
+    if (timed) s_spin_ns.fetch_add(now_ns() - start, std::memory_order_relaxed);
+    Kokkos::load_fence();
+    return;
+  }
+
+  // About to sleep, which dwarfs the cost of the statistics
+  const uint64_t sleep = now_ns();
+  if (timed) s_spin_ns.fetch_add(sleep - start, std::memory_order_relaxed);
+
+#if defined(KOKKOS_IMPL_HOST_FUTEX)
+  // Pairs with the fence in host_thread_wake: either the waker sees this
+  // sleeper or this thread sees the new flag value. The kernel rechecks the
+  // flag before blocking.
+  s_sleepers.fetch_add(1, std::memory_order_seq_cst);
+  while (value == flag) {
+    syscall(SYS_futex, const_cast<int*>(&flag), FUTEX_WAIT_PRIVATE, value,
+            nullptr, nullptr, 0);
+  }
+  s_sleepers.fetch_sub(1, std::memory_order_relaxed);
+
+  const uint64_t resume = now_ns();
+  const uint64_t wake   = s_wake_ns.load(std::memory_order_relaxed);
+  s_sleeps.fetch_add(1, std::memory_order_relaxed);
+  if (sleep <= wake && wake <= resume) {
+    s_wakeup_ns.fetch_add(resume - wake, std::memory_order_relaxed);
+  }
+#else
+  while (value == flag) {
+    host_thread_yield(++i, WaitMode::PASSIVE);
+  }
+#endif
+
+  Kokkos::load_fence();
+}
+
+void host_thread_wake(int volatile& flag) {
+#if defined(KOKKOS_IMPL_HOST_FUTEX)
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (0 < s_sleepers.load(std::memory_order_seq_cst)) {
+    s_wake_ns.store(now_ns(), std::memory_order_relaxed);
+    syscall(SYS_futex, const_cast<int*>(&flag), FUTEX_WAKE_PRIVATE, INT_MAX,
+            nullptr, nullptr, 0);
+  }
+#else
+  (void)flag;
+#endif
+}
+
+HostWaitStatistics host_wait_statistics() {
+  HostWaitStatistics result;
+  result.sleeps    = s_sleeps.load(std::memory_order_relaxed);
+  result.wakeup_ns = s_wakeup_ns.load(std::memory_order_relaxed);
+  result.spin_ns   = s_spin_ns.load(std::memory_order_relaxed);
+  return result;
+}
+
+void report_host_wait_statistics() {
+  if (!Kokkos::Profiling::profileLibraryLoaded()) return;
+
+  const HostWaitStatistics stats = host_wait_statistics();
+  if (stats.sleeps == 0 && stats.spin_ns == 0) return;
+
+  char event[128];
+  snprintf(event, sizeof(event),
+           "Kokkos::HostWait sleeps=%llu mean_wakeup_us=%.3f idle_spin_s=%.6f",
+           static_cast<unsigned long long>(stats.sleeps),
+           stats.sleeps ? 1.0e-3 * stats.wakeup_ns / stats.sleeps : 0.0,
+           1.0e-9 * stats.spin_ns);
+  Kokkos::Profiling::markEvent(std::string(event));
+}
+
 }  // namespace Impl
 }  // namespace Kokkos
 
@@ -65,6 +65,37 @@ enum class WaitMode : int {
 
 void host_thread_yield(const uint32_t i, const WaitMode mode);
 
+// How host threads wait while idle between kernels, selected with
+// --kokkos-wait-policy
+enum class WaitPolicy : int {
+  ACTIVE  // Spin and yield, never sleep in the kernel
+  ,
+  PASSIVE  // Sleep right away
+  ,
+  HYBRID  // Spin for a bounded time, then sleep
+};
+
+void set_host_wait_policy(const WaitPolicy policy);
+WaitPolicy host_wait_policy();
+
+// Idle wait of a host thread while flag == value, following the wait
+// policy. Sleeping threads block on a futex where available, so whoever
+// changes the flag must call host_thread_wake afterwards.
+void host_thread_wait_while_equal(int volatile& flag, const int value);
+void host_thread_wake(int volatile& flag);
+
+struct HostWaitStatistics {
+  uint64_t sleeps;     // waits that went to sleep
+  uint64_t wakeup_ns;  // summed time from wake to resume of those waits
+  uint64_t spin_ns;    // summed time spent spinning in idle waits, only
+                       // accumulated while a profiling tool is loaded
+};
+
+HostWaitStatistics host_wait_statistics();
+
+// Reports the statistics as a profiling event, if a tool is loaded
+void report_host_wait_statistics();
+
 template <typename T>
 typename std::enable_if<std::is_integral<T>::value, void>::type
 root_spinwait_while_equal(T const volatile& flag, const T value) {
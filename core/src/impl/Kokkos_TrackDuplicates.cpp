@@ -1,17 +1,188 @@
 #include <Kokkos_Core.hpp>
 #include <impl/Kokkos_TrackDuplicates.hpp>
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <string>
+
 namespace Kokkos {
 namespace Experimental {
 
-std::map<std::string, void*> DuplicateTracker::kernel_func_list;
+DuplicateRegistry::DuplicateRegistry() {
+  for (int b = 0; b < bucket_count; ++b) m_buckets[b] = nullptr;
+}
+
+DuplicateRegistry::~DuplicateRegistry() { clear(); }
+
+size_t DuplicateRegistry::bucket(const void* record) {
+  // Records are at least 16 byte aligned, mix the remaining bits.
+  const uint64_t k = uint64_t(reinterpret_cast<uintptr_t>(record)) >> 4;
+  return size_t((k * 0x9E3779B97F4A7C15ull) >> 32) % bucket_count;
+}
+
+DuplicateTracker* DuplicateRegistry::find(const void* record) const {
+  for (Node* n = m_buckets[bucket(record)].load(std::memory_order_acquire); n;
+       n = n->next) {
+    if (n->record == record) return n->tracker;
+  }
+  return nullptr;
+}
+
+DuplicateTracker* DuplicateRegistry::find_label(
+    const std::string& label) const {
+  const uint64_t hash = duplicate_label_hash(label);
+  for (int b = 0; b < bucket_count; ++b) {
+    for (Node* n = m_buckets[b].load(std::memory_order_acquire); n;
+         n = n->next) {
+      if (n->label_hash == hash && n->tracker->label == label) {
+        return n->tracker;
+      }
+    }
+  }
+  return nullptr;
+}
+
+DuplicateTracker* DuplicateRegistry::insert(const void* record,
+                                            DuplicateTracker* tracker) {
+  std::atomic<Node*>& head = m_buckets[bucket(record)];
+
+  Node* const node = new Node{record, tracker->label_hash, tracker, nullptr};
+  Node* expected   = head.load(std::memory_order_acquire);
+  Node* scanned    = nullptr;
+
+  while (true) {
+    // Only nodes pushed since the last scan can hold the record.
+    for (Node* n = expected; n != scanned; n = n->next) {
+      if (n->record == record) {
+        delete node;
+        delete tracker;
+        return n->tracker;
+      }
+    }
+    scanned    = expected;
+    node->next = expected;
+    if (head.compare_exchange_weak(expected, node, std::memory_order_release,
+                                   std::memory_order_acquire)) {
+      return tracker;
+    }
+  }
+}
+
+void DuplicateRegistry::combine_all() {
+  for_each([](DuplicateTracker* dt) { dt->combine_dups(); });
+}
+
+int DuplicateRegistry::replication() const {
+  int executions = 1;
+  for_each([&executions](DuplicateTracker* dt) {
+    executions = std::max(executions, dt->dup_target.load());
+  });
+  return executions;
+}
+
+void DuplicateRegistry::clear() {
+  for (int b = 0; b < bucket_count; ++b) {
+    Node* n = m_buckets[b].exchange(nullptr, std::memory_order_acq_rel);
+    while (n) {
+      Node* const next = n->next;
+      delete n->tracker;
+      delete n;
+      n = next;
+    }
+  }
+}
+
+size_t DuplicateRegistry::size() const {
+  size_t count = 0;
+  for_each([&count](DuplicateTracker*) { ++count; });
+  return count;
+}
+
+namespace {
+
+struct DuplicationEntry {
+  int factor;
+  int check_interval;
+};
+
+struct DuplicationPolicyState {
+  std::mutex mutex;
+  DuplicationEntry fallback = {3, 1};
+  std::map<std::string, DuplicationEntry> labels;
+  std::map<std::string, size_t> launches;
+
+  DuplicationEntry lookup(const std::string& label) const {
+    auto loc = labels.find(label);
+    return loc != labels.end() ? loc->second : fallback;
+  }
+};
+
+DuplicationPolicyState& duplication_policy() {
+  static DuplicationPolicyState state;
+  return state;
+}
+
+DuplicationEntry checked_entry(int factor, int check_interval) {
+  if (factor < 1 || factor > 3) {
+    Kokkos::Impl::throw_runtime_exception(
+        "Kokkos::Experimental::DuplicationPolicy: replication factor must be "
+        "1, 2 or 3");
+  }
+  if (check_interval < 1) {
+    Kokkos::Impl::throw_runtime_exception(
+        "Kokkos::Experimental::DuplicationPolicy: check interval must be "
+        "positive");
+  }
+  return DuplicationEntry{factor, check_interval};
+}
+
+}  // namespace
+
+void DuplicationPolicy::set_replication(const std::string& label, int factor,
+                                        int check_interval) {
+  const DuplicationEntry entry = checked_entry(factor, check_interval);
+  DuplicationPolicyState& state = duplication_policy();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.labels[label] = entry;
+  // Sampling restarts with a checked launch.
+  state.launches.erase(label);
+}
+
+void DuplicationPolicy::set_default_replication(int factor,
+                                                int check_interval) {
+  const DuplicationEntry entry = checked_entry(factor, check_interval);
+  DuplicationPolicyState& state = duplication_policy();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.fallback = entry;
+}
+
+void DuplicationPolicy::reset() {
+  DuplicationPolicyState& state = duplication_policy();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.fallback = DuplicationEntry{3, 1};
+  state.labels.clear();
+  state.launches.clear();
+}
+
+int DuplicationPolicy::replication(const std::string& label) {
+  DuplicationPolicyState& state = duplication_policy();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.lookup(label).factor;
+}
 
-void DuplicateTracker::add_kernel_func(std::string name, void* func_ptr) {
-  kernel_func_list[name] = func_ptr;
+int DuplicationPolicy::check_interval(const std::string& label) {
+  DuplicationPolicyState& state = duplication_policy();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.lookup(label).check_interval;
 }
 
-void* DuplicateTracker::get_kernel_func(std::string name) {
-  return kernel_func_list[name];
+int DuplicationPolicy::begin_launch(const std::string& label) {
+  DuplicationPolicyState& state = duplication_policy();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  const DuplicationEntry entry = state.lookup(label);
+  const size_t launch          = state.launches[label]++;
+  return launch % entry.check_interval == 0 ? entry.factor : 1;
 }
 
 }  // namespace Experimental
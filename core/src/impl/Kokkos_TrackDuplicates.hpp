@@ -3,14 +3,41 @@
 #define __DUPLICATE_TRACKER__
 
 #include <Kokkos_Core_fwd.hpp>
+#include <atomic>
 #include <cmath>
-#include <map>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <type_traits>
 #include <typeinfo>
 
 namespace Kokkos {
 
 namespace Experimental {
 
+template <class Type>
+inline Type& duplicate_tolerance_storage() {
+  static Type tolerance = Type(0.00000001);
+  return tolerance;
+}
+
+/// \brief Tolerance used when voting between duplicates of floating point
+///   data.  Values closer than the tolerance are considered equal.
+template <class Type>
+inline Type duplicate_tolerance() {
+  static_assert(std::is_floating_point<Type>::value,
+                "Kokkos: duplicate tolerance requires a floating point type");
+  return duplicate_tolerance_storage<Type>();
+}
+
+template <class Type>
+inline void set_duplicate_tolerance(const Type tolerance) {
+  static_assert(std::is_floating_point<Type>::value,
+                "Kokkos: duplicate tolerance requires a floating point type");
+  duplicate_tolerance_storage<Type>() = tolerance;
+}
+
 template <class Type, class Enabled = void>
 struct MergeFunctor;
 
@@ -19,14 +46,25 @@ struct MergeFunctor<
     Type, typename std::enable_if<std::is_same<Type, float>::value ||
                                       std::is_same<Type, double>::value,
                                   void>::type> {
+  Type tolerance;
+
   KOKKOS_INLINE_FUNCTION
-  MergeFunctor() {}
+  MergeFunctor() : tolerance(Type(0.00000001)) {}
 
   KOKKOS_INLINE_FUNCTION
-  MergeFunctor(const MergeFunctor& mf) {}
+  explicit MergeFunctor(const Type tol) : tolerance(tol) {}
+
+  //! Functor using the tolerance configured for \c Type
+  static MergeFunctor configured() {
+    return MergeFunctor(duplicate_tolerance<Type>());
+  }
 
+  // Branch free |a - b| < tolerance, false for NaN
   KOKKOS_INLINE_FUNCTION
-  bool compare(Type a, Type b) const { return (abs(a - b) < 0.00000001); }
+  bool compare(Type a, Type b) const {
+    const Type d = a - b;
+    return (d < tolerance) & (-d < tolerance);
+  }
 };
 
 template <class Type>
@@ -37,59 +75,247 @@ struct MergeFunctor<
   KOKKOS_INLINE_FUNCTION
   MergeFunctor() {}
 
-  KOKKOS_INLINE_FUNCTION
-  MergeFunctor(const MergeFunctor& mf) {}
+  static MergeFunctor configured() { return MergeFunctor(); }
 
   KOKKOS_INLINE_FUNCTION
   bool compare(Type a, Type b) const { return (a == b); }
 };
 
+/// \brief Outcome of voting between three duplicates.
+struct DuplicateVoteCounts {
+  //! Elements where the duplicates did not all agree
+  size_t mismatches;
+  //! Elements without any two agreeing duplicates
+  size_t unresolved;
+};
+
+/// \brief Selects which resilient views are duplicated, and how often.
+///
+/// The replication factor of a label is the number of copies written by
+/// the replicated executions of a launch that are voted: 3 duplicates are
+/// voted, 2 only detect mismatches and 1 votes nothing.  With a check
+/// interval of N only every Nth launch of a label is duplicated, the
+/// others run with a factor of 1.  Unlisted labels use the default policy,
+/// initially a factor of 3 checked on every launch.
+///
+/// A launch where no view is duplicated executes once, on the original
+/// allocations (see DuplicateRegistry::replication()).  In a replicated
+/// launch, copies of a view beyond its factor get private duplicates that
+/// are not voted, so no two executions write the same allocation.
+class DuplicationPolicy {
+ public:
+  static void set_replication(const std::string& label, int factor,
+                              int check_interval = 1);
+  static void set_default_replication(int factor, int check_interval = 1);
+
+  //! Forget all per label policies and launch counts
+  static void reset();
+
+  static int replication(const std::string& label);
+  static int check_interval(const std::string& label);
+
+  //! Count a launch of \c label and return its replication factor
+  static int begin_launch(const std::string& label);
+};
+
+/// \brief 64 bit FNV-1a hash of a view label.
+inline uint64_t duplicate_label_hash(const std::string& label) {
+  uint64_t h = 14695981039346656037ull;
+  for (const char c : label) {
+    h = (h ^ uint64_t(static_cast<unsigned char>(c))) * 1099511628211ull;
+  }
+  return h;
+}
+
 class DuplicateTracker {
  public:
   void* original_data;
-  int dup_cnt;
+  //! Duplicates registered, may be raised concurrently by nested copies
+  std::atomic<int> dup_cnt;
   int data_len;
+  //! Duplicates voted for the current launch, negative until the first
+  //! copy of the launch has applied the duplication policy
+  std::atomic<int> dup_target;
   void* dup_list[3];
   void* func_ptr;
 
-  static std::map<std::string, void*> kernel_func_list;
-  static void add_kernel_func(std::string name, void* func_ptr);
-  static void* get_kernel_func(std::string name);
+  std::string label;
+  uint64_t label_hash;
+
+  //! Totals over all votes of this tracker, for corruption rates
+  size_t voted_elements;
+  size_t mismatched_elements;
+  size_t unresolved_elements;
+
+  template <class Type>
+  static void add_kernel_func(void* func_ptr) {
+    kernel_func<Type>().store(func_ptr, std::memory_order_release);
+  }
+
+  template <class Type>
+  static void* get_kernel_func() {
+    return kernel_func<Type>().load(std::memory_order_acquire);
+  }
 
   inline virtual ~DuplicateTracker() {}
 
-  inline DuplicateTracker() : original_data(nullptr) {
-    dup_cnt  = 0;
-    data_len = 0;
+  inline DuplicateTracker()
+      : original_data(nullptr),
+        dup_cnt(0),
+        data_len(0),
+        dup_target(3),
+        func_ptr(nullptr),
+        label_hash(0),
+        voted_elements(0),
+        mismatched_elements(0),
+        unresolved_elements(0),
+        m_dup_reserved(0) {
     for (int i = 0; i < 3; i++) {
       dup_list[i] = nullptr;
     }
   }
 
   inline DuplicateTracker(const DuplicateTracker& dt)
-      : original_data(dt.original_data) {
-    dup_cnt  = dt.dup_cnt;
-    data_len = dt.data_len;
-    for (int i = 0; i < dup_cnt; i++) {
+      : original_data(dt.original_data),
+        dup_cnt(dt.dup_cnt.load()),
+        data_len(dt.data_len),
+        dup_target(dt.dup_target.load()),
+        func_ptr(dt.func_ptr),
+        label(dt.label),
+        label_hash(dt.label_hash),
+        voted_elements(dt.voted_elements),
+        mismatched_elements(dt.mismatched_elements),
+        unresolved_elements(dt.unresolved_elements),
+        m_dup_reserved(dt.m_dup_reserved.load()) {
+    for (int i = 0; i < 3; i++) {
       dup_list[i] = dt.dup_list[i];
     }
   }
 
+  /// Claim the duplicate slot of a copy of the view.  The first copy of a
+  /// launch that is not duplicated returns -1 and stays on the original
+  /// allocation; every other copy gets a duplicate of its own.
+  inline int reserve_dup() {
+    const int slot = m_dup_reserved.fetch_add(1, std::memory_order_relaxed);
+    return slot == 0 && dup_target.load(std::memory_order_acquire) == 0
+               ? -1
+               : slot;
+  }
+
+  //! Whether the duplicate in \c slot takes part in the vote
+  inline bool votes(const int slot) const {
+    return slot < dup_target.load(std::memory_order_acquire);
+  }
+
+  inline void set_dup(const int slot,
+                      Kokkos::Impl::SharedAllocationRecord<void, void>* dup) {
+    dup_list[slot] = (void*)dup->data();
+    dup_cnt.fetch_add(1, std::memory_order_release);
+  }
+
   inline void add_dup(Kokkos::Impl::SharedAllocationRecord<void, void>* dup) {
-    if (dup_cnt < 3) {
-      dup_list[dup_cnt] = (void*)dup->data();
-      dup_cnt++;
-      //printf("duplicate added to list: %d\n", dup_cnt);
-    }
+    const int slot = m_dup_reserved.fetch_add(1, std::memory_order_relaxed);
+    if (votes(slot)) set_dup(slot, dup);
   }
 
   inline virtual void combine_dups() {}
+
+ private:
+  std::atomic<int> m_dup_reserved;
+
+  template <class Type>
+  static std::atomic<void*>& kernel_func() {
+    static std::atomic<void*> func_ptr(nullptr);
+    return func_ptr;
+  }
 };
 
+/// \brief Registry of the duplicate trackers of a memory space, keyed by
+///   the allocation record of the original view.
+///
+/// Lookup and insertion are lock free, so views can be copied into
+/// resilient launches from concurrent host threads (for example nested
+/// OpenMP::partition_master partitions).  Trackers are removed by clear(),
+/// which must not run concurrently with other calls.
+class DuplicateRegistry {
+ public:
+  enum { bucket_count = 1024 };
+
+  struct Node {
+    const void* record;
+    uint64_t label_hash;
+    DuplicateTracker* tracker;
+    Node* next;
+  };
+
+  DuplicateRegistry();
+  ~DuplicateRegistry();
+
+  DuplicateTracker* find(const void* record) const;
+
+  //! First tracker registered with \c label, for label based reporting
+  DuplicateTracker* find_label(const std::string& label) const;
+
+  /// Register \c tracker for \c record unless another one is registered
+  /// first, in which case \c tracker is deleted.  Returns the registered
+  /// tracker.
+  DuplicateTracker* insert(const void* record, DuplicateTracker* tracker);
+
+  //! Vote the duplicates of every tracker into their originals
+  void combine_all();
+
+  /// Executions the registered launch needs: the largest replication
+  /// factor of its trackers, or 1 when no view is duplicated.  The backend
+  /// then runs only the first copy of the functor, which holds the original
+  /// allocations.
+  int replication() const;
+
+  //! Delete all trackers, not thread safe
+  void clear();
+
+  size_t size() const;
+
+  template <class F>
+  void for_each(const F& f) const {
+    for (int b = 0; b < bucket_count; ++b) {
+      for (Node* n = m_buckets[b].load(std::memory_order_acquire); n;
+           n = n->next) {
+        f(n->tracker);
+      }
+    }
+  }
+
+ private:
+  DuplicateRegistry(const DuplicateRegistry&) = delete;
+  DuplicateRegistry& operator=(const DuplicateRegistry&) = delete;
+
+  static size_t bucket(const void* record);
+
+  std::atomic<Node*> m_buckets[bucket_count];
+};
+
+/// Registry of the duplicate trackers of \c MemorySpace
+template <class MemorySpace>
+inline DuplicateRegistry& duplicate_registry() {
+  static DuplicateRegistry registry;
+  return registry;
+}
+
+/// \brief Triple modular redundancy vote of three duplicates into the
+///   original allocation.
+///
+/// Each work item votes a block of elements with a branch free loop so the
+/// compiler can vectorize it, and counts the mismatches it saw.  combine()
+/// launches the vote over \c ExecSpace and returns the counts.
 template <class DType, class ExecSpace>
 class CombineFunctor {
  public:
   typedef MergeFunctor<DType> functor_type;
+  typedef DuplicateVoteCounts value_type;
+
+  //! Elements voted by one work item
+  enum { block_size = 256 };
+
   functor_type cf;
 
   DType* orig_view;
@@ -102,6 +328,7 @@ class CombineFunctor {
 
   inline void load_ptrs(DType* orig, DType* d1, DType* d2, DType* d3,
                         size_t len) {
+    cf          = functor_type::configured();
     orig_view   = orig;
     dup_view[0] = d1;
     dup_view[1] = d2;
@@ -114,33 +341,71 @@ class CombineFunctor {
 
   KOKKOS_INLINE_FUNCTION
   CombineFunctor(const CombineFunctor& rhs)
-      : orig_view(rhs.orig_view), dup_view{} {
+      : cf(rhs.cf), orig_view(rhs.orig_view), dup_view{} {
     for (int i = 0; i < 3; i++) dup_view[i] = rhs.dup_view[i];
     m_len = rhs.m_len;
   }
 
+  /// Vote element \c i: the first duplicate agreeing with another one wins,
+  /// the third duplicate is taken if none agree.
   KOKKOS_INLINE_FUNCTION
-  // void operator ()(const int i) const {
   void exec(const int i) const {
-    //printf("combine dups: %d\n", i);
-    for (int j = 0; j < 3; j++) {
-      //printf("iterating outer: %d - %d \n", i, j);
-      orig_view[i] = dup_view[j][i];
-      //printf("first entry: %d, %d\n", j, orig_view[i]);
-      int k = j < 2 ? j + 1 : 0;
-      for (int r = 0; r < 2; r++) {
-        //printf("iterate inner %d, %d, %d \n", i, j, k);
-        if (cf.compare(dup_view[k][i],
-                       orig_view[i]))  // just need 2 that are the same
-        {
-         // printf("match found: %d - %d\n", i, j);
-          return;
-        }
-        k = k < 2 ? k + 1 : 0;
-      }
+    const DType a = dup_view[0][i];
+    const DType b = dup_view[1][i];
+    const DType c = dup_view[2][i];
+
+    orig_view[i] = (cf.compare(a, b) | cf.compare(a, c))
+                       ? a
+                       : (cf.compare(b, c) ? b : c);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t block, value_type& counts) const {
+    const size_t begin = block * block_size;
+    const size_t end =
+        begin + block_size < m_len ? begin + block_size : m_len;
+
+    DType* const orig     = orig_view;
+    const DType* const d0 = dup_view[0];
+    const DType* const d1 = dup_view[1];
+    const DType* const d2 = dup_view[2];
+
+    size_t mismatches = 0;
+    size_t unresolved = 0;
+#ifdef KOKKOS_ENABLE_PRAGMA_IVDEP
+#pragma ivdep
+#endif
+    for (size_t i = begin; i < end; ++i) {
+      const DType a = d0[i];
+      const DType b = d1[i];
+      const DType c = d2[i];
+
+      const bool ab = cf.compare(a, b);
+      const bool ac = cf.compare(a, c);
+      const bool bc = cf.compare(b, c);
+
+      orig[i] = (ab | ac) ? a : (bc ? b : c);
+      mismatches += !(ab & ac & bc);
+      unresolved += !(ab | ac | bc);
     }
-    // printf("no match found: %i\n", i);
+    counts.mismatches += mismatches;
+    counts.unresolved += unresolved;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void init(value_type& counts) const {
+    counts.mismatches = 0;
+    counts.unresolved = 0;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void join(volatile value_type& dst, const volatile value_type& src) const {
+    dst.mismatches += src.mismatches;
+    dst.unresolved += src.unresolved;
   }
+
+  //! Vote all elements in parallel, defined in Kokkos_CombineDuplicates.hpp
+  inline value_type combine() const;
 };
 
 template <class Type, class ExecutionSpace>
@@ -162,38 +427,47 @@ class SpecDuplicateTracker : public DuplicateTracker {
   virtual void combine_dups();
 };
 
+/// Find the tracker of the launch duplicating \c orig, or create it and
+/// apply the duplication policy on the first copy of the launch.
 template <class Type, class MemorySpace>
-static void track_duplicate(
-    Kokkos::Impl::SharedAllocationRecord<void, void>* orig,
-    Kokkos::Impl::SharedAllocationRecord<void, void>* dup) {
-  Kokkos::Impl::SharedAllocationRecord<MemorySpace, void>* SP =
-      static_cast<Kokkos::Impl::SharedAllocationRecord<MemorySpace, void>*>(
-          dup);
+static Kokkos::Experimental::DuplicateTracker* duplicate_tracker(
+    Kokkos::Impl::SharedAllocationRecord<void, void>* orig) {
   typedef Kokkos::Experimental::SpecDuplicateTracker<
       Type, typename MemorySpace::execution_space>
       dt_type;
-  // typedef CombineFunctor<typename dt_type::rd_type, typename
-  // MemorySpace::execution_space> comb_type;
-
-  dt_type* dt = nullptr;
-  auto loc    = MemorySpace::duplicate_map.find(SP->get_label());
-  if (loc != MemorySpace::duplicate_map.end()) {
-    dt = (dt_type*)loc->second;
-   // printf("retrieved existing tracking entry from map: %s\n",
-   //        SP->get_label().c_str());
-  } else {
-    dt = new dt_type();
-    // printf("dup_kernel ptr = %08x \n", comb_type::s_dup_kernel);
-    // dt->func_ptr = (void*)pLaunch; // comb_type::s_dup_kernel;
-    dt->func_ptr      = DuplicateTracker::get_kernel_func(typeid(Type).name());
+
+  DuplicateRegistry& registry = duplicate_registry<MemorySpace>();
+
+  DuplicateTracker* found = registry.find(orig);
+  if (found == nullptr) {
+    dt_type* dt       = new dt_type();
+    dt->label         = orig->get_label();
+    dt->label_hash    = duplicate_label_hash(dt->label);
+    dt->func_ptr      = DuplicateTracker::get_kernel_func<Type>();
     dt->data_len      = orig->size();
     dt->original_data = orig->data();
-    MemorySpace::duplicate_map[SP->get_label()] =
-        static_cast<Kokkos::Experimental::DuplicateTracker*>(dt);
-    //printf("creating new tracking entry in hash map: %s, %08x \n",
-    //       SP->get_label().c_str(), (unsigned long)dt->func_ptr);
+    dt->dup_target    = -1;
+
+    // Only the copy whose tracker is registered counts the launch.
+    found = registry.insert(orig, dt);
+    if (found == dt) {
+      const int factor = DuplicationPolicy::begin_launch(dt->label);
+      dt->dup_target.store(factor > 1 ? factor : 0, std::memory_order_release);
+    }
   }
-  dt->add_dup(dup);
+
+  // Concurrent first copies wait for the policy of the launch.
+  while (found->dup_target.load(std::memory_order_acquire) < 0) {
+    std::this_thread::yield();
+  }
+  return found;
+}
+
+template <class Type, class MemorySpace>
+static void track_duplicate(
+    Kokkos::Impl::SharedAllocationRecord<void, void>* orig,
+    Kokkos::Impl::SharedAllocationRecord<void, void>* dup) {
+  duplicate_tracker<Type, MemorySpace>(orig)->add_dup(dup);
 }
 
 }  // namespace Experimental
@@ -0,0 +1,217 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#ifndef KOKKOS_IMPL_VIEWBLOCKHASH_HPP
+#define KOKKOS_IMPL_VIEWBLOCKHASH_HPP
+
+#include <Kokkos_Macros.hpp>
+#include <Kokkos_View.hpp>
+#include <Kokkos_CopyViews.hpp>
+
+#include <cstdint>
+
+namespace Kokkos {
+namespace Impl {
+
+/* 64-bit FNV-1a over little-endian 8-byte words followed by a final
+ * avalanche.  Aligned and unaligned inputs hash identically.  Used to detect
+ * changed data, not for integrity.
+ */
+KOKKOS_INLINE_FUNCTION
+uint64_t view_block_hash(const unsigned char* data, size_t n) {
+  constexpr uint64_t prime = 0x100000001b3ull;
+  uint64_t h               = 0xcbf29ce484222325ull ^ n;
+
+  size_t i = 0;
+  if (reinterpret_cast<uintptr_t>(data) % sizeof(uint64_t) == 0) {
+    const uint64_t* words = reinterpret_cast<const uint64_t*>(data);
+    for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t)) {
+      h = (h ^ words[i / sizeof(uint64_t)]) * prime;
+    }
+  } else {
+    for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t)) {
+      uint64_t w = 0;
+      for (unsigned k = 0; k < sizeof(uint64_t); ++k) {
+        w |= uint64_t(data[i + k]) << (8 * k);
+      }
+      h = (h ^ w) * prime;
+    }
+  }
+  for (; i < n; ++i) h = (h ^ data[i]) * prime;
+
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+struct ViewBlockHashFunctor {
+  const unsigned char* data;
+  size_t bytes;
+  size_t block_size;
+  uint64_t* hashes;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t b) const {
+    const size_t begin = b * block_size;
+    const size_t end = begin + block_size < bytes ? begin + block_size : bytes;
+    hashes[b]        = view_block_hash(data + begin, end - begin);
+  }
+};
+
+/* One iteration per 8-byte word of each packed block; 'block_size' must be a
+ * multiple of 8.
+ */
+struct ViewBlockPackFunctor {
+  const unsigned char* data;
+  size_t bytes;
+  size_t block_size;
+  const size_t* blocks;
+  unsigned char* buff;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const size_t i) const {
+    const size_t words_per_block = block_size / sizeof(uint64_t);
+    const size_t b               = i / words_per_block;
+    const size_t w               = i % words_per_block;
+
+    const size_t src = blocks[b] * block_size + w * sizeof(uint64_t);
+    const size_t dst = b * block_size + w * sizeof(uint64_t);
+    if (src >= bytes) return;
+
+    if (src + sizeof(uint64_t) <= bytes &&
+        reinterpret_cast<uintptr_t>(data + src) % sizeof(uint64_t) == 0 &&
+        reinterpret_cast<uintptr_t>(buff + dst) % sizeof(uint64_t) == 0) {
+      *reinterpret_cast<uint64_t*>(buff + dst) =
+          *reinterpret_cast<const uint64_t*>(data + src);
+    } else {
+      const size_t n = src + sizeof(uint64_t) <= bytes ? sizeof(uint64_t)
+                                                       : bytes - src;
+      for (size_t k = 0; k < n; ++k) buff[dst + k] = data[src + k];
+    }
+  }
+};
+
+template <class ViewType>
+bool view_hash_blocks(const ViewType& view, size_t block_size,
+                      uint64_t* hashes) {
+  using execution_space = typename ViewType::execution_space;
+  using device_type     = typename ViewType::device_type;
+
+  if (!view.span_is_contiguous()) return false;
+
+  const size_t bytes = view.span() * sizeof(typename ViewType::value_type);
+  const size_t num_blocks = (bytes + block_size - 1) / block_size;
+  if (num_blocks == 0) return true;
+
+  View<uint64_t*, device_type> d_hashes(
+      view_alloc(WithoutInitializing, "Kokkos::ViewHolder::block_hashes"),
+      num_blocks);
+
+  const ViewBlockHashFunctor functor{
+      reinterpret_cast<const unsigned char*>(view.data()), bytes, block_size,
+      d_hashes.data()};
+  parallel_for("Kokkos::ViewHolder::hash_blocks",
+               RangePolicy<execution_space>(0, num_blocks), functor);
+
+  deep_copy(View<uint64_t*, HostSpace, MemoryTraits<Unmanaged> >(hashes,
+                                                                 num_blocks),
+            d_hashes);
+  return true;
+}
+
+template <class ViewType>
+void view_pack_blocks(const ViewType& view, size_t block_size,
+                      const size_t* blocks, size_t num_blocks,
+                      unsigned char* buff) {
+  using execution_space = typename ViewType::execution_space;
+  using device_type     = typename ViewType::device_type;
+  using host_bytes_type =
+      View<unsigned char*, HostSpace, MemoryTraits<Unmanaged> >;
+  using host_blocks_type =
+      View<const size_t*, HostSpace, MemoryTraits<Unmanaged> >;
+
+  if (num_blocks == 0) return;
+
+  const size_t bytes = view.span() * sizeof(typename ViewType::value_type);
+  const size_t last  = blocks[num_blocks - 1] * block_size;
+  const size_t packed =
+      (num_blocks - 1) * block_size +
+      (last + block_size < bytes ? block_size : bytes - last);
+  const size_t iterations = num_blocks * (block_size / sizeof(uint64_t));
+
+  ViewBlockPackFunctor functor{
+      reinterpret_cast<const unsigned char*>(view.data()), bytes, block_size,
+      blocks, buff};
+
+  if (SpaceAccessibility<execution_space, HostSpace>::accessible) {
+    parallel_for("Kokkos::ViewHolder::pack_blocks",
+                 RangePolicy<execution_space>(0, iterations), functor);
+    execution_space().fence();
+    return;
+  }
+
+  View<size_t*, device_type> d_blocks(
+      view_alloc(WithoutInitializing, "Kokkos::ViewHolder::blocks"),
+      num_blocks);
+  View<unsigned char*, device_type> d_buff(
+      view_alloc(WithoutInitializing, "Kokkos::ViewHolder::packed_blocks"),
+      num_blocks * block_size);
+  deep_copy(d_blocks, host_blocks_type(blocks, num_blocks));
+
+  functor.blocks = d_blocks.data();
+  functor.buff   = d_buff.data();
+  parallel_for("Kokkos::ViewHolder::pack_blocks",
+               RangePolicy<execution_space>(0, iterations), functor);
+
+  deep_copy(host_bytes_type(buff, packed),
+            subview(d_buff, std::make_pair(size_t(0), packed)));
+}
+
+}  // namespace Impl
+}  // namespace Kokkos
+
+#endif  // KOKKOS_IMPL_VIEWBLOCKHASH_HPP
@@ -0,0 +1,834 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <Kokkos_ViewCheckpoint.hpp>
+#include <impl/Kokkos_CheckpointCompression.hpp>
+#include <impl/Kokkos_Error.hpp>
+#include <impl/Kokkos_FileSpace.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace Kokkos {
+namespace Impl {
+
+namespace {
+
+#if defined(KOKKOS_ENABLE_CUDA)
+using checkpoint_staging_space = Kokkos::CudaHostPinnedSpace;
+#else
+using checkpoint_staging_space = Kokkos::HostSpace;
+#endif
+
+constexpr size_t checkpoint_alignment = 64;
+
+size_t checkpoint_align(size_t n) {
+  return (n + checkpoint_alignment - 1) & ~(checkpoint_alignment - 1);
+}
+
+}  // namespace
+
+/* Blocks [first_block, first_block + count) are stored contiguously at
+ * 'offset' in the data file of 'source_version'.
+ */
+struct CheckpointRun {
+  size_t first_block;
+  size_t count;
+  int source_version;
+  size_t offset;
+};
+
+/* A View written whole has block_size == 0 and a single run, holding
+ * 'stored' bytes encoded with 'codec'.
+ */
+struct CheckpointManifestEntry {
+  size_t bytes      = 0;
+  size_t block_size = 0;
+  uint64_t hash     = 0;
+  int codec         = checkpoint_codec_none;
+  size_t stored     = 0;
+  std::vector<CheckpointRun> runs;
+
+  size_t num_blocks() const {
+    return block_size == 0 ? 1 : (bytes + block_size - 1) / block_size;
+  }
+};
+
+using checkpoint_manifest = std::map<std::string, CheckpointManifestEntry>;
+
+class CheckpointEngineState {
+ public:
+  using statistics_type = Kokkos::Experimental::CheckpointEngine::Statistics;
+
+  /* A View staged in a slot.  In block mode only the dirty 'blocks' are
+   * staged, packed in ascending order.  A View staged with a 'codec' is
+   * compressed by the writer into a frame in the slot's 'packed' buffer.
+   */
+  struct StagedView {
+    std::string key;
+    size_t bytes;
+    size_t block_size;
+    size_t offset;
+    size_t staged;
+    std::vector<size_t> blocks;
+    int codec;
+    size_t element_size;
+    size_t packed_offset;
+    size_t packed_bytes;
+  };
+
+  struct Slot {
+    unsigned char* buffer = nullptr;
+    size_t capacity       = 0;
+    std::vector<unsigned char> packed;
+    std::string name;
+    int version = 0;
+    /* Version whose block hashes skipped blocks were diffed against */
+    int base_version = -1;
+    double error_bound = 0;
+    std::vector<StagedView> views;
+    bool busy = false;
+  };
+
+  CheckpointEngineState(const std::string& arg_directory,
+                        size_t arg_block_size)
+      : directory(arg_directory.empty() ? std::string(".") : arg_directory),
+        block_size(arg_block_size),
+        codec(checkpoint_codec_none),
+        error_bound(0),
+        next_slot(0),
+        shutdown(false) {
+    writer = std::thread([this]() { run(); });
+  }
+
+  ~CheckpointEngineState() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      shutdown = true;
+    }
+    cv.notify_all();
+    writer.join();
+
+    for (Slot& slot : slots) release(slot);
+
+    if (!error.empty()) {
+      fprintf(stderr,
+              "Kokkos::Experimental::CheckpointEngine: unreported error: %s\n",
+              error.c_str());
+      fflush(stderr);
+    }
+  }
+
+  std::string data_path(const std::string& name, int version) const {
+    return directory + "/" + name + "." + std::to_string(version) +
+           ".kokkos_ckpt";
+  }
+
+  std::string manifest_path(const std::string& name, int version) const {
+    return directory + "/" + name + "." + std::to_string(version) +
+           ".manifest";
+  }
+
+  static void reserve(Slot& slot, size_t bytes) {
+    if (slot.capacity >= bytes) return;
+    release(slot);
+    slot.buffer = static_cast<unsigned char*>(
+        checkpoint_staging_space().allocate(bytes));
+    slot.capacity = bytes;
+  }
+
+  static void release(Slot& slot) {
+    if (slot.buffer != nullptr) {
+      checkpoint_staging_space().deallocate(slot.buffer, slot.capacity);
+    }
+    slot.buffer   = nullptr;
+    slot.capacity = 0;
+  }
+
+  /* Caller must hold 'mutex' */
+  void rethrow_error() {
+    if (!error.empty()) {
+      std::string msg;
+      std::swap(msg, error);
+      Kokkos::Impl::throw_runtime_exception(
+          std::string("Kokkos::Experimental::CheckpointEngine: ") + msg);
+    }
+  }
+
+  Slot& acquire_slot(std::unique_lock<std::mutex>& lock) {
+    Slot& slot = slots[next_slot];
+    cv.wait(lock, [&slot]() { return !slot.busy; });
+    next_slot = 1 - next_slot;
+    return slot;
+  }
+
+  void fence(std::unique_lock<std::mutex>& lock) {
+    cv.wait(lock, [this]() { return !slots[0].busy && !slots[1].busy; });
+  }
+
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      cv.wait(lock, [this]() { return shutdown || !queue.empty(); });
+      if (queue.empty()) return;
+
+      Slot* slot = queue.front();
+      queue.pop_front();
+
+      lock.unlock();
+      std::string msg;
+      try {
+        write(*slot);
+      } catch (std::exception& e) {
+        msg = e.what();
+      }
+      lock.lock();
+
+      // Later checkpoints of this name may have been diffed against blocks
+      // that never reached the file; stage the next one in full.
+      if (!msg.empty()) {
+        error = msg;
+        stale_hashes.insert(slot->name);
+      }
+      slot->busy = false;
+      cv.notify_all();
+    }
+  }
+
+  /* Entry for a View staged whole: reuse the previous one if the hash
+   * matches, otherwise the data go to the file at 'file_offset'.
+   */
+  static bool update_whole(const Slot& slot, const StagedView& view,
+                           const CheckpointManifestEntry* prev,
+                           size_t file_offset, CheckpointManifestEntry& entry) {
+    const uint64_t h = view_block_hash(slot.buffer + view.offset, view.bytes);
+    if (prev != nullptr && prev->block_size == 0 &&
+        prev->bytes == view.bytes && prev->hash == h) {
+      entry = *prev;
+      return false;
+    }
+    entry.bytes      = view.bytes;
+    entry.block_size = 0;
+    entry.hash       = h;
+    entry.codec      = view.codec;
+    entry.stored =
+        view.codec == checkpoint_codec_none ? view.bytes : view.packed_bytes;
+    entry.runs.assign(1, CheckpointRun{0, 1, slot.version, file_offset});
+    return true;
+  }
+
+  /* Entry for a View staged as dirty blocks: the previous block map with the
+   * dirty blocks pointing at the file at 'file_offset', merged into runs.
+   */
+  static bool update_blocks(const Slot& slot, const StagedView& view,
+                            const CheckpointManifestEntry* prev,
+                            size_t file_offset,
+                            CheckpointManifestEntry& entry) {
+    if (view.blocks.empty() && prev != nullptr) {
+      entry = *prev;
+      return false;
+    }
+
+    entry.bytes      = view.bytes;
+    entry.block_size = view.block_size;
+    entry.hash       = 0;
+    entry.codec      = checkpoint_codec_none;
+    entry.stored     = 0;
+
+    const size_t n = entry.num_blocks();
+    std::vector<int> version(n, -1);
+    std::vector<size_t> offset(n, 0);
+
+    if (prev != nullptr && prev->bytes == view.bytes &&
+        prev->block_size == view.block_size) {
+      for (const CheckpointRun& run : prev->runs) {
+        for (size_t i = 0; i < run.count; ++i) {
+          version[run.first_block + i] = run.source_version;
+          offset[run.first_block + i]  = run.offset + i * view.block_size;
+        }
+      }
+    }
+    for (size_t i = 0; i < view.blocks.size(); ++i) {
+      version[view.blocks[i]] = slot.version;
+      offset[view.blocks[i]]  = file_offset + i * view.block_size;
+    }
+
+    entry.runs.clear();
+    for (size_t b = 0; b < n; ++b) {
+      if (version[b] < 0) {
+        throw std::runtime_error("no data for block " + std::to_string(b) +
+                                 " of View '" + view.key + "'");
+      }
+      if (!entry.runs.empty()) {
+        CheckpointRun& run = entry.runs.back();
+        if (run.source_version == version[b] &&
+            run.offset + run.count * view.block_size == offset[b]) {
+          ++run.count;
+          continue;
+        }
+      }
+      entry.runs.push_back(CheckpointRun{b, 1, version[b], offset[b]});
+    }
+    return true;
+  }
+
+  /* Compress the Views staged with a codec into the slot's 'packed' buffer.
+   * Runs on the writer, so the chunks are compressed in order rather than on
+   * the host execution space.
+   */
+  static void compress(Slot& slot) {
+    std::vector<CheckpointCompressionInput> inputs;
+    for (const StagedView& view : slot.views) {
+      if (view.codec == checkpoint_codec_none) continue;
+      inputs.push_back(CheckpointCompressionInput{
+          slot.buffer + view.offset, view.bytes, view.element_size,
+          CheckpointCodec(view.codec), slot.error_bound});
+    }
+
+    std::vector<size_t> offsets, sizes;
+    slot.packed.clear();
+    checkpoint_compress(inputs, slot.packed, offsets, sizes);
+
+    size_t k = 0;
+    for (StagedView& view : slot.views) {
+      if (view.codec == checkpoint_codec_none) continue;
+      view.packed_offset = offsets[k];
+      view.packed_bytes  = sizes[k];
+      ++k;
+    }
+  }
+
+  void write(Slot& slot) {
+    Kokkos::Timer timer;
+
+    checkpoint_manifest previous;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (slot.base_version >= 0) {
+        auto written = written_versions.find(slot.name);
+        if (written == written_versions.end() ||
+            written->second != slot.base_version) {
+          throw std::runtime_error(
+              "checkpoint " + slot.name + "." + std::to_string(slot.version) +
+              " depends on unwritten version " +
+              std::to_string(slot.base_version));
+        }
+      }
+      previous = history[slot.name];
+    }
+
+    Kokkos::Timer compress_timer;
+    compress(slot);
+    const double compress_seconds = compress_timer.seconds();
+
+    checkpoint_manifest current;
+    std::ofstream data;
+    size_t file_offset    = 0;
+    size_t views_written  = 0;
+    size_t blocks_written = 0;
+
+    for (const StagedView& view : slot.views) {
+      auto found = previous.find(view.key);
+      const CheckpointManifestEntry* prev =
+          found == previous.end() ? nullptr : &found->second;
+
+      CheckpointManifestEntry& entry = current[view.key];
+      const bool dirty =
+          view.block_size == 0
+              ? update_whole(slot, view, prev, file_offset, entry)
+              : update_blocks(slot, view, prev, file_offset, entry);
+      if (!dirty) continue;
+
+      if (!data.is_open()) {
+        data.open(data_path(slot.name, slot.version),
+                  std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!data) {
+          throw std::runtime_error("cannot open " +
+                                   data_path(slot.name, slot.version));
+        }
+      }
+      // Staged blocks are packed at 'block_size' stride, so the staged bytes
+      // go out as one piece and the file offsets above stay valid.
+      if (view.codec == checkpoint_codec_none) {
+        data.write(reinterpret_cast<const char*>(slot.buffer + view.offset),
+                   view.staged);
+        file_offset += view.staged;
+      } else {
+        data.write(reinterpret_cast<const char*>(slot.packed.data() +
+                                                 view.packed_offset),
+                   view.packed_bytes);
+        file_offset += view.packed_bytes;
+      }
+      ++views_written;
+      blocks_written += view.block_size == 0 ? 0 : view.blocks.size();
+    }
+
+    if (data.is_open()) {
+      data.close();
+      if (!data) {
+        throw std::runtime_error("failed writing " +
+                                 data_path(slot.name, slot.version));
+      }
+    }
+
+    write_manifest(slot.name, slot.version, current);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    history[slot.name]          = current;
+    written_versions[slot.name] = slot.version;
+    stats.views_written += views_written;
+    stats.views_skipped += slot.views.size() - views_written;
+    stats.blocks_written += blocks_written;
+    stats.bytes_written += file_offset;
+    stats.write_seconds += timer.seconds();
+    stats.compress_seconds += compress_seconds;
+  }
+
+  void write_manifest(const std::string& name, int version,
+                      const checkpoint_manifest& manifest) const {
+    const std::string path = manifest_path(name, version);
+    const std::string tmp  = path + ".tmp";
+    {
+      std::ofstream out(tmp, std::ios::out | std::ios::trunc);
+      out << "kokkos_checkpoint 3\n";
+      for (const auto& entry : manifest) {
+        const CheckpointManifestEntry& e = entry.second;
+        out << e.bytes << ' ' << e.block_size << ' ' << e.hash << ' '
+            << e.codec << ' ' << e.stored << ' ' << e.runs.size() << ' '
+            << entry.first << '\n';
+        for (const CheckpointRun& run : e.runs) {
+          out << run.first_block << ' ' << run.count << ' '
+              << run.source_version << ' ' << run.offset << '\n';
+        }
+      }
+      out.close();
+      if (!out) throw std::runtime_error("failed writing " + tmp);
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+      throw std::runtime_error("cannot rename " + tmp + " to " + path);
+    }
+  }
+
+  checkpoint_manifest read_manifest(const std::string& name,
+                                    int version) const {
+    const std::string path = manifest_path(name, version);
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line)) {
+      Kokkos::Impl::throw_runtime_exception(
+          "Kokkos::Experimental::CheckpointEngine: cannot read manifest " +
+          path);
+    }
+    if (line != "kokkos_checkpoint 3") {
+      Kokkos::Impl::throw_runtime_exception(
+          "Kokkos::Experimental::CheckpointEngine: unsupported manifest " +
+          path + " ('" + line + "', expecting 'kokkos_checkpoint 3')");
+    }
+
+    checkpoint_manifest manifest;
+    while (std::getline(in, line)) {
+      std::istringstream fields(line);
+      CheckpointManifestEntry entry;
+      size_t num_runs = 0;
+      fields >> entry.bytes >> entry.block_size >> entry.hash >> entry.codec >>
+          entry.stored >> num_runs;
+      fields.get();  // separating space; the key is the rest of the line
+      std::string key;
+      bool ok = fields && std::getline(fields, key);
+
+      for (size_t i = 0; ok && i < num_runs; ++i) {
+        CheckpointRun run;
+        ok = std::getline(in, line) &&
+             (std::istringstream(line) >> run.first_block >> run.count >>
+              run.source_version >> run.offset);
+        entry.runs.push_back(run);
+      }
+      if (!ok) {
+        Kokkos::Impl::throw_runtime_exception(
+            "Kokkos::Experimental::CheckpointEngine: malformed manifest " +
+            path);
+      }
+      manifest[key] = entry;
+    }
+    return manifest;
+  }
+
+  std::string directory;
+  size_t block_size;
+
+  /* Codec of Views staged whole, set by the caller */
+  CheckpointCodec codec;
+  double error_bound;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  Slot slots[2];
+  int next_slot;
+  std::deque<Slot*> queue;
+  bool shutdown;
+  std::string error;
+
+  /* Last written manifest and version of each checkpoint name, written by
+   * the writer */
+  std::map<std::string, checkpoint_manifest> history;
+  std::map<std::string, int> written_versions;
+
+  /* Names whose staged block hashes a failed write invalidated */
+  std::set<std::string> stale_hashes;
+
+  /* Block hashes of each View at its last staging and the version staged,
+   * used by the caller.  They run ahead of 'history' while a write is
+   * pending; the writer rejects a slot whose base was never written.
+   */
+  std::map<std::string, std::map<std::string, std::vector<uint64_t> > >
+      block_hashes;
+  std::map<std::string, int> hash_versions;
+
+  statistics_type stats;
+
+  std::thread writer;
+};
+
+namespace {
+
+/* Drop Views sharing an allocation, keeping a non-const View when there is
+ * one so that it can be restored, and assign each remaining View a key.
+ * The key is the label, disambiguated by capture order when repeated.
+ */
+std::vector<std::string> checkpoint_keys(captured_view_list& views) {
+  std::map<const void*, size_t> seen_data;
+  captured_view_list unique;
+  for (auto& view : views) {
+    if (view->data() != nullptr) {
+      auto seen = seen_data.find(view->data());
+      if (seen != seen_data.end()) {
+        if (dynamic_cast<ViewHolderBase*>(unique[seen->second].get()) ==
+            nullptr) {
+          unique[seen->second] = std::move(view);
+        }
+        continue;
+      }
+      seen_data[view->data()] = unique.size();
+    }
+    unique.push_back(std::move(view));
+  }
+  views.swap(unique);
+
+  std::map<std::string, int> seen_labels;
+  std::vector<std::string> keys;
+  for (const auto& view : views) {
+    std::string key = view->label();
+    if (key.empty()) key = "view";
+    const int n = seen_labels[key]++;
+    if (n > 0) key += "#" + std::to_string(n);
+    keys.push_back(key);
+  }
+  return keys;
+}
+
+/* Bytes deep_copy_to_buffer produces: the View packed contiguously */
+size_t checkpoint_bytes(const ConstViewHolderBase& view) {
+  return view.size() * view.data_type_size();
+}
+
+}  // namespace
+
+}  // namespace Impl
+
+namespace Experimental {
+
+namespace {
+using checkpoint_slot   = Kokkos::Impl::CheckpointEngineState::Slot;
+using checkpoint_staged = Kokkos::Impl::CheckpointEngineState::StagedView;
+}  // namespace
+
+CheckpointEngine::CheckpointEngine(const std::string& directory,
+                                   size_t block_size)
+    : m_state(new Kokkos::Impl::CheckpointEngineState(directory, block_size)) {
+  if (block_size % sizeof(uint64_t) != 0) {
+    Kokkos::Impl::throw_runtime_exception(
+        "Kokkos::Experimental::CheckpointEngine: block size must be a "
+        "multiple of 8 bytes");
+  }
+}
+
+CheckpointEngine::~CheckpointEngine() = default;
+
+void CheckpointEngine::set_compression(Compression mode, double error_bound) {
+  if (mode == Compression::Lossy && !(error_bound > 0)) {
+    Kokkos::Impl::throw_runtime_exception(
+        "Kokkos::Experimental::CheckpointEngine: lossy compression requires a "
+        "positive error bound");
+  }
+  m_state->codec =
+      mode == Compression::None
+          ? Kokkos::Impl::checkpoint_codec_none
+          : mode == Compression::Lossless
+                ? Kokkos::Impl::checkpoint_codec_shuffle_lz
+                : Kokkos::Impl::checkpoint_codec_quantize_lz;
+  m_state->error_bound = mode == Compression::Lossy ? error_bound : 0;
+}
+
+bool CheckpointEngine::exists(const std::string& name, int version) const {
+  return file_exists(m_state->manifest_path(name, version));
+}
+
+void CheckpointEngine::fence() {
+  std::unique_lock<std::mutex> lock(m_state->mutex);
+  m_state->fence(lock);
+  m_state->rethrow_error();
+}
+
+CheckpointEngine::Statistics CheckpointEngine::statistics() const {
+  std::lock_guard<std::mutex> lock(m_state->mutex);
+  return m_state->stats;
+}
+
+void CheckpointEngine::checkpoint_views(
+    const std::string& name, int version,
+    Kokkos::Impl::captured_view_list& views) {
+  Kokkos::Timer timer;
+  const std::vector<std::string> keys = Kokkos::Impl::checkpoint_keys(views);
+  const size_t block_size             = m_state->block_size;
+
+  {
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    if (m_state->stale_hashes.erase(name) != 0) {
+      m_state->block_hashes.erase(name);
+      m_state->hash_versions.erase(name);
+    }
+  }
+
+  // Find the dirty blocks before waiting for a slot; hashing runs on each
+  // View's execution space.  Only the caller touches 'block_hashes'.
+  std::vector<checkpoint_staged> staged(views.size());
+  std::map<std::string, std::vector<uint64_t> > hashes;
+  std::map<std::string, std::vector<uint64_t> >& last_hashes =
+      m_state->block_hashes[name];
+  size_t blocks_skipped = 0;
+
+  size_t total = 0;
+  for (size_t i = 0; i < views.size(); ++i) {
+    checkpoint_staged& s = staged[i];
+    s.key                = keys[i];
+    s.bytes              = Kokkos::Impl::checkpoint_bytes(*views[i]);
+    s.block_size         = 0;
+    s.offset             = total;
+    s.staged             = s.bytes;
+    s.codec              = Kokkos::Impl::checkpoint_codec_none;
+    s.element_size       = views[i]->data_type_size();
+    s.packed_offset      = 0;
+    s.packed_bytes       = 0;
+
+    if (block_size > 0) {
+      std::vector<uint64_t>& h = hashes[s.key];
+      h.resize((s.bytes + block_size - 1) / block_size);
+      if (views[i]->hash_blocks(block_size, h.data())) {
+        auto last = last_hashes.find(s.key);
+        const bool compare =
+            last != last_hashes.end() && last->second.size() == h.size();
+        for (size_t b = 0; b < h.size(); ++b) {
+          if (!compare || last->second[b] != h[b]) s.blocks.push_back(b);
+        }
+        s.block_size = block_size;
+        s.staged =
+            s.blocks.empty()
+                ? 0
+                : s.blocks.size() * block_size -
+                      (s.blocks.back() + 1 == h.size()
+                           ? h.size() * block_size - s.bytes
+                           : 0);
+        blocks_skipped += h.size() - s.blocks.size();
+      } else {
+        hashes.erase(s.key);
+      }
+    }
+
+    // Views staged whole are compressed by the writer; quantizing needs
+    // float or double elements.
+    if (m_state->codec != Kokkos::Impl::checkpoint_codec_none &&
+        s.block_size == 0 && s.bytes != 0) {
+      const bool quantize =
+          m_state->codec == Kokkos::Impl::checkpoint_codec_quantize_lz &&
+          views[i]->is_floating_point() &&
+          (s.element_size == sizeof(float) ||
+           s.element_size == sizeof(double));
+      s.codec = quantize ? Kokkos::Impl::checkpoint_codec_quantize_lz
+                         : Kokkos::Impl::checkpoint_codec_shuffle_lz;
+    }
+    total += Kokkos::Impl::checkpoint_align(s.staged);
+  }
+
+  std::unique_lock<std::mutex> lock(m_state->mutex);
+  m_state->rethrow_error();
+  checkpoint_slot& slot = m_state->acquire_slot(lock);
+  lock.unlock();
+
+  Kokkos::Impl::CheckpointEngineState::reserve(slot, total);
+
+  for (size_t i = 0; i < views.size(); ++i) {
+    const checkpoint_staged& s = staged[i];
+    if (s.block_size == 0) {
+      views[i]->deep_copy_to_buffer(slot.buffer + s.offset);
+    } else {
+      views[i]->deep_copy_blocks_to_buffer(s.block_size, s.blocks.data(),
+                                           s.blocks.size(),
+                                           slot.buffer + s.offset);
+    }
+  }
+
+  // Skipped blocks refer to the version last staged, which must be written
+  // before this one can be.
+  slot.name         = name;
+  slot.version      = version;
+  slot.base_version = blocks_skipped > 0 ? m_state->hash_versions[name] : -1;
+  slot.error_bound  = m_state->error_bound;
+  slot.views.swap(staged);
+  last_hashes.swap(hashes);
+  m_state->hash_versions[name] = version;
+
+  lock.lock();
+  slot.busy = true;
+  m_state->queue.push_back(&slot);
+  m_state->stats.checkpoints += 1;
+  m_state->stats.views_captured += views.size();
+  m_state->stats.blocks_skipped += blocks_skipped;
+  m_state->stats.bytes_staged += total;
+  m_state->stats.stage_seconds += timer.seconds();
+  lock.unlock();
+  m_state->cv.notify_all();
+}
+
+void CheckpointEngine::restore_views(const std::string& name, int version,
+                                     Kokkos::Impl::captured_view_list& views) {
+  fence();
+
+  const std::vector<std::string> keys = Kokkos::Impl::checkpoint_keys(views);
+  const Kokkos::Impl::checkpoint_manifest manifest =
+      m_state->read_manifest(name, version);
+  const size_t block_size = m_state->block_size;
+
+  // Both slots are idle after the fence; borrow the first for reading.
+  checkpoint_slot& slot = m_state->slots[0];
+  std::map<std::string, std::vector<uint64_t> > hashes;
+
+  for (size_t i = 0; i < views.size(); ++i) {
+    ViewHolderBase* view = dynamic_cast<ViewHolderBase*>(views[i].get());
+    if (view == nullptr) continue;
+
+    auto found = manifest.find(keys[i]);
+    if (found == manifest.end()) {
+      Kokkos::Impl::throw_runtime_exception(
+          "Kokkos::Experimental::CheckpointEngine: no data for View '" +
+          keys[i] + "' in checkpoint " + name + "." + std::to_string(version));
+    }
+    const Kokkos::Impl::CheckpointManifestEntry& entry = found->second;
+    const size_t n = Kokkos::Impl::checkpoint_bytes(*view);
+    if (entry.bytes != n) {
+      Kokkos::Impl::throw_runtime_exception(
+          "Kokkos::Experimental::CheckpointEngine: size mismatch for View '" +
+          keys[i] + "' in checkpoint " + name + "." + std::to_string(version));
+    }
+
+    Kokkos::Impl::CheckpointEngineState::reserve(slot, n);
+
+    const size_t stride = entry.block_size == 0 ? n : entry.block_size;
+    for (const Kokkos::Impl::CheckpointRun& run : entry.runs) {
+      const size_t begin = run.first_block * stride;
+      const size_t end   = std::min(n, (run.first_block + run.count) * stride);
+      // A compressed View is one frame of 'stored' bytes
+      const bool compressed =
+          entry.codec != Kokkos::Impl::checkpoint_codec_none;
+      unsigned char* dst = slot.buffer + begin;
+      size_t len         = end - begin;
+      if (compressed) {
+        slot.packed.resize(entry.stored);
+        dst = slot.packed.data();
+        len = entry.stored;
+      }
+
+      const std::string path = m_state->data_path(name, run.source_version);
+      std::ifstream in(path, std::ios::in | std::ios::binary);
+      in.seekg(run.offset);
+      in.read(reinterpret_cast<char*>(dst), len);
+      if (!in) {
+        Kokkos::Impl::throw_runtime_exception(
+            "Kokkos::Experimental::CheckpointEngine: cannot read " + path);
+      }
+      if (compressed) {
+        Kokkos::Impl::checkpoint_decompress(dst, len, slot.buffer, n);
+      }
+    }
+
+    view->deep_copy_from_buffer(slot.buffer);
+
+    // Seed the block hashes only where the writer can extend the block map.
+    if (block_size > 0 && entry.block_size == block_size) {
+      std::vector<uint64_t>& h = hashes[keys[i]];
+      h.resize(entry.num_blocks());
+      if (!view->hash_blocks(block_size, h.data())) hashes.erase(keys[i]);
+    }
+  }
+
+  // Later checkpoints only need to write what changes after the restore.
+  m_state->block_hashes[name].swap(hashes);
+  m_state->hash_versions[name] = version;
+  std::lock_guard<std::mutex> lock(m_state->mutex);
+  m_state->stale_hashes.erase(name);
+  m_state->history[name]          = manifest;
+  m_state->written_versions[name] = version;
+}
+
+}  // namespace Experimental
+}  // namespace Kokkos
@@ -64,6 +64,19 @@ struct ViewAllocateWithoutInitializing {
       : label(arg_label) {}
 };
 
+/** \brief  Page placement of a host View allocation across NUMA domains.
+ *
+ *  FirstTouchStatic  pages are first touched by the same static partition
+ *                    of the execution space that a RangePolicy over the
+ *                    allocation uses, even without initialization.
+ *  Interleave        pages are interleaved round robin over the online
+ *                    NUMA domains.
+ *
+ *  The policy is a placement hint: it is ignored for memory spaces other
+ *  than HostSpace and on platforms without NUMA page placement.
+ */
+enum class NumaPolicy { Default, FirstTouchStatic, Interleave };
+
 } /* namespace Kokkos */
 
 //----------------------------------------------------------------------------
@@ -148,6 +161,20 @@ struct ViewCtorProp<typename std::enable_if<
   static constexpr type value = type();
 };
 
+/* NUMA placement is a runtime value */
+template <>
+struct ViewCtorProp<void, Kokkos::NumaPolicy> {
+  ViewCtorProp()                     = default;
+  ViewCtorProp(const ViewCtorProp &) = default;
+  ViewCtorProp &operator=(const ViewCtorProp &) = default;
+
+  typedef Kokkos::NumaPolicy type;
+
+  ViewCtorProp(const type &arg) : value(arg) {}
+
+  type value = Kokkos::NumaPolicy::Default;
+};
+
 /* Map input label type to std::string */
 template <typename Label>
 struct ViewCtorProp<typename std::enable_if<is_view_label<Label>::value>::type,
@@ -216,6 +243,9 @@ struct ViewCtorProp : public ViewCtorProp<void, P>... {
   enum { has_pointer = var_pointer::value };
   enum { has_label = Kokkos::Impl::has_type<std::string, P...>::value };
   enum { allow_padding = Kokkos::Impl::has_type<AllowPadding_t, P...>::value };
+  enum {
+    has_numa_policy = Kokkos::Impl::has_type<Kokkos::NumaPolicy, P...>::value
+  };
   enum {
     initialize = !Kokkos::Impl::has_type<WithoutInitializing_t, P...>::value
   };
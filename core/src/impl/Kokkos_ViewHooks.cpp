@@ -42,10 +42,83 @@
 */
 
 #include <Kokkos_ViewHooks.hpp>
+#include <impl/Kokkos_Error.hpp>
 
 #if defined(KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST)
 namespace Kokkos {
-ViewHooks::callback_type ViewHooks::s_callback;
-ViewHooks::const_callback_type ViewHooks::s_const_callback;
+KOKKOS_THREAD_LOCAL ViewHooks::ThreadState ViewHooks::t_state;
+std::atomic<int> ViewHooks::s_registered(0);
+std::atomic<int> ViewHooks::s_global_count(0);
+std::atomic<ViewHook*> ViewHooks::s_global[ViewHooks::max_hooks];
+
+void ViewHooks::add(ViewHook* hook) {
+  ThreadState& state = t_state;
+  if (state.count == max_hooks) {
+    Kokkos::Impl::throw_runtime_exception(
+        "Kokkos::ViewHooks::add: too many hooks registered on this thread");
+  }
+  state.hooks[state.count++] = hook;
+  s_registered.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ViewHooks::remove(ViewHook* hook) {
+  ThreadState& state = t_state;
+  for (int i = state.count - 1; i >= 0; --i) {
+    if (state.hooks[i] == hook) {
+      for (int j = i + 1; j < state.count; ++j) {
+        state.hooks[j - 1] = state.hooks[j];
+      }
+      --state.count;
+      s_registered.fetch_sub(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+}
+
+void ViewHooks::add_global(ViewHook* hook) {
+  for (int i = 0; i < max_hooks; ++i) {
+    ViewHook* expected = nullptr;
+    if (s_global[i].compare_exchange_strong(expected, hook,
+                                            std::memory_order_acq_rel)) {
+      s_global_count.fetch_add(1, std::memory_order_release);
+      s_registered.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+  Kokkos::Impl::throw_runtime_exception(
+      "Kokkos::ViewHooks::add_global: too many global hooks registered");
+}
+
+void ViewHooks::remove_global(ViewHook* hook) {
+  for (int i = 0; i < max_hooks; ++i) {
+    ViewHook* expected = hook;
+    if (s_global[i].compare_exchange_strong(expected, nullptr,
+                                            std::memory_order_acq_rel)) {
+      s_global_count.fetch_sub(1, std::memory_order_release);
+      s_registered.fetch_sub(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+}
+
+void ViewHooks::set_callbacks(ViewHook* hook) {
+  clear();
+  try {
+    add(hook);
+  } catch (...) {
+    delete hook;
+    throw;
+  }
+  t_state.callbacks = hook;
+}
+
+void ViewHooks::clear() {
+  ThreadState& state = t_state;
+  if (state.callbacks) {
+    remove(state.callbacks);
+    delete state.callbacks;
+    state.callbacks = nullptr;
+  }
+}
 }  // namespace Kokkos
-#endif
\ No newline at end of file
+#endif
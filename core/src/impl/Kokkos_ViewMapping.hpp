@@ -2904,6 +2904,80 @@ struct ViewValueFunctor<
   void destroy_shared_allocation() {}
 };
 
+//----------------------------------------------------------------------------
+/** \brief  Explicit NUMA page placement of a HostSpace allocation.
+ *
+ *  Pages are released before use so that placement does not depend on
+ *  which thread touched recycled memory first. When the values are not
+ *  initialized, FirstTouchStatic touches each page from the thread that
+ *  owns it under the default static RangePolicy partition of the span.
+ */
+template <class... P>
+inline typename std::enable_if<ViewCtorProp<P...>::has_numa_policy,
+                               Kokkos::NumaPolicy>::type
+view_numa_policy(ViewCtorProp<P...> const& arg_prop) {
+  return ((ViewCtorProp<void, Kokkos::NumaPolicy> const&)arg_prop).value;
+}
+
+template <class... P>
+inline typename std::enable_if<!ViewCtorProp<P...>::has_numa_policy,
+                               Kokkos::NumaPolicy>::type
+view_numa_policy(ViewCtorProp<P...> const&) {
+  return Kokkos::NumaPolicy::Default;
+}
+
+template <class ExecSpace, class ValueType, class MemorySpace,
+          bool HostPlacement =
+              std::is_same<MemorySpace, Kokkos::HostSpace>::value &&
+              Kokkos::Impl::SpaceAccessibility<
+                  ExecSpace, Kokkos::HostSpace>::accessible>
+struct ViewNumaPlacement {
+  static void apply(ExecSpace const&, Kokkos::NumaPolicy, ValueType* const,
+                    size_t const, bool const) {}
+};
+
+template <class ExecSpace, class ValueType, class MemorySpace>
+struct ViewNumaPlacement<ExecSpace, ValueType, MemorySpace, true> {
+  typedef Kokkos::RangePolicy<ExecSpace, Kokkos::Schedule<Kokkos::Static>,
+                              Kokkos::IndexType<int64_t>>
+      PolicyType;
+
+  ValueType* ptr;
+  uintptr_t page_mask;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const int64_t i) const {
+    // Touch the page whose first byte lies in value i
+    const uintptr_t head = reinterpret_cast<uintptr_t>(ptr + i);
+    const uintptr_t next = (head + page_mask) & ~page_mask;
+    if (next < head + sizeof(ValueType)) {
+      *reinterpret_cast<volatile char*>(next) = 0;
+    }
+  }
+
+  static void apply(ExecSpace const& space, Kokkos::NumaPolicy policy,
+                    ValueType* const ptr, size_t const n,
+                    bool const initialize) {
+    if (policy == Kokkos::NumaPolicy::Default || n == 0) return;
+
+    const bool interleave = policy == Kokkos::NumaPolicy::Interleave;
+
+    const size_t page_size = Kokkos::Impl::host_space_numa_place(
+        ptr, sizeof(ValueType) * n, interleave);
+
+    if (!page_size || interleave || initialize || space.in_parallel()) return;
+
+    ViewNumaPlacement touch;
+    touch.ptr       = ptr;
+    touch.page_mask = page_size - 1;
+
+    const Kokkos::Impl::ParallelFor<ViewNumaPlacement, PolicyType> closure(
+        touch, PolicyType(space, 0, n));
+    closure.execute();
+    space.fence();
+  }
+};
+
 //----------------------------------------------------------------------------
 /** \brief  View mapping for non-specialized data type and standard layout */
 template <class Traits>
@@ -3224,6 +3298,14 @@ class ViewMapping<
     }
 #endif
 
+    if (alloc_prop::has_numa_policy) {
+      ViewNumaPlacement<execution_space, value_type, memory_space>::apply(
+          ((Kokkos::Impl::ViewCtorProp<void, execution_space> const&)arg_prop)
+              .value,
+          view_numa_policy(arg_prop), (value_type*)m_impl_handle,
+          m_impl_offset.span(), alloc_prop::initialize);
+    }
+
     //  Only initialize if the allocation is non-zero.
     //  May be zero if one of the dimensions is zero.
     if (alloc_size && alloc_prop::initialize) {
@@ -3262,6 +3344,14 @@ class ViewMapping<
       Kokkos::Impl::SharedAllocationRecord<mem_space, void>* orig_rec) {
     typedef Kokkos::Impl::SharedAllocationRecord<mem_space, void> record_type;
 
+    // The first copy of a launch that is not duplicated stays on the
+    // original allocation, and the launch executes only that copy.
+    Kokkos::Experimental::DuplicateTracker* const tracker =
+        Kokkos::Experimental::template duplicate_tracker<
+            typename Traits::value_type, mem_space>(orig_rec);
+    const int slot = tracker->reserve_dup();
+    if (slot < 0) return orig_rec;
+
     std::string label = orig_rec->get_label();
     //printf("allocating duplicate record: %s \n", label.c_str());
 
@@ -3280,8 +3370,7 @@ class ViewMapping<
    // printf("track duplicate record: %s \n", label.c_str());
     // Kokkos::ResCudaSpace::template track_duplicate<typename
     // Traits::value_type>(orig_rec, record);
-    Kokkos::Experimental::template track_duplicate<typename Traits::value_type,
-                                                   mem_space>(orig_rec, record);
+    if (tracker->votes(slot)) tracker->set_dup(slot, record);
 
     return record;
   }
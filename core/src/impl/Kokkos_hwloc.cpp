@@ -706,6 +706,22 @@ std::pair<unsigned, unsigned> get_this_thread_coordinate() {
   return coord;
 }
 
+std::pair<unsigned, unsigned> get_this_thread_numa_location() {
+  std::pair<unsigned, unsigned> location(0u, 0u);
+
+  if (!sentinel()) return location;
+
+  // Fills 's_hwloc_location' with the thread's last location.
+  location.second = get_this_thread_coordinate().first;
+
+  const hwloc_obj_t socket = hwloc_get_next_obj_covering_cpuset_by_type(
+      s_hwloc_topology, s_hwloc_location, HWLOC_OBJ_SOCKET, nullptr);
+
+  if (socket) location.first = socket->logical_index;
+
+  return location;
+}
+
 //----------------------------------------------------------------------------
 
 } /* namespace hwloc */
@@ -716,6 +732,14 @@ std::pair<unsigned, unsigned> get_this_thread_coordinate() {
 
 #else /* ! defined( KOKKOS_ENABLE_HWLOC ) */
 
+#if defined(__linux__)
+#include <dirent.h>
+#include <sched.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#endif
+
 namespace Kokkos {
 namespace hwloc {
 
@@ -738,6 +762,36 @@ std::pair<unsigned, unsigned> get_this_thread_coordinate() {
   return std::pair<unsigned, unsigned>(0, 0);
 }
 
+std::pair<unsigned, unsigned> get_this_thread_numa_location() {
+  std::pair<unsigned, unsigned> location(0u, 0u);
+
+#if defined(__linux__)
+  const int cpu = sched_getcpu();
+  if (cpu < 0) return location;
+
+  const std::string dir =
+      "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+
+  std::ifstream package(dir + "/topology/physical_package_id");
+  int id = 0;
+  if (package >> id && 0 <= id) location.first = id;
+
+  // The cpu directory links to its NUMA node as 'node<id>'
+  if (DIR* const entries = opendir(dir.c_str())) {
+    while (const dirent* const entry = readdir(entries)) {
+      unsigned node = 0;
+      if (std::sscanf(entry->d_name, "node%u", &node) == 1) {
+        location.second = node;
+        break;
+      }
+    }
+    closedir(entries);
+  }
+#endif
+
+  return location;
+}
+
 }  // namespace hwloc
 }  // namespace Kokkos
 
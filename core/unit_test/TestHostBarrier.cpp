@@ -1,7 +1,138 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
 #include <gtest/gtest.h>
 
+#include <Kokkos_Core.hpp>
+#include <impl/Kokkos_HostBarrier.hpp>
+
+#include <thread>
+#include <vector>
+
 namespace Test {
 
-TEST(host_barrier, openmp) {}
+using Kokkos::Impl::HostBarrier;
+
+// Every thread adds to a counter between barriers; after each barrier all
+// threads must see the additions of the whole round.
+void test_host_barrier(const int threads, const int fan_in) {
+  enum : int { rounds = 50 };
+
+  std::vector<HostBarrier::buffer_type> buffer(
+      HostBarrier::required_buffer_length, 0);
+  int counter = 0;
+  int errors  = 0;
+  int masters = 0;
+
+  auto run = [&](const int rank) {
+    int step = 0;
+    for (int round = 0; round < rounds; ++round) {
+      Kokkos::atomic_fetch_add(&counter, 1);
+      HostBarrier::arrive(buffer.data(), threads, rank, fan_in, step);
+      HostBarrier::wait(buffer.data(), threads, step);
+      if (Kokkos::atomic_fetch_add(&counter, 0) < threads * (round + 1)) {
+        Kokkos::atomic_fetch_add(&errors, 1);
+      }
+      HostBarrier::arrive(buffer.data(), threads, rank, fan_in, step);
+      HostBarrier::wait(buffer.data(), threads, step);
+
+      // The last thread to arrive acts before releasing the others
+      if (HostBarrier::split_arrive(buffer.data(), threads, rank, fan_in,
+                                    step, false)) {
+        ++masters;
+        HostBarrier::split_release(buffer.data(), threads, fan_in, step);
+      }
+      HostBarrier::wait(buffer.data(), threads, step);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (int rank = 1; rank < threads; ++rank) workers.emplace_back(run, rank);
+  run(0);
+  for (auto& worker : workers) worker.join();
+
+  ASSERT_EQ(counter, threads * rounds);
+  ASSERT_EQ(errors, 0);
+  ASSERT_EQ(masters, rounds);
+}
+
+TEST(host_barrier, centralized) {
+  for (int threads : {1, 2, 5}) test_host_barrier(threads, 0);
+}
+
+TEST(host_barrier, tree) {
+  for (int fan_in : {2, 3, 4}) {
+    for (int threads : {fan_in + 1, 7, 9}) test_host_barrier(threads, fan_in);
+  }
+}
+
+TEST(host_barrier, fan_in) {
+  const int selected = HostBarrier::fan_in();
+
+  HostBarrier::set_fan_in(0);
+  ASSERT_EQ(HostBarrier::fan_in(64), 0);
+
+  // The topology default keeps the centralized counter without hwloc
+  HostBarrier::set_fan_in(-1);
+  if (!Kokkos::hwloc::available()) {
+    ASSERT_EQ(HostBarrier::fan_in(64), 0);
+  }
+
+  HostBarrier::set_fan_in(4);
+  ASSERT_EQ(HostBarrier::fan_in(4), 0);
+  ASSERT_EQ(HostBarrier::fan_in(5), 4);
+
+  // Large pools raise the fan-in until the tree fits the buffer
+  const int fan_in = HostBarrier::fan_in(1024);
+  int nodes        = 0;
+  for (int count = 1024; count > 1;) {
+    count = (count + fan_in - 1) / fan_in;
+    nodes += count;
+  }
+  ASSERT_LE(nodes, int(HostBarrier::max_tree_nodes));
+
+  HostBarrier::set_fan_in(selected);
+}
 
 }  // namespace Test
@@ -0,0 +1,154 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+
+#include <Kokkos_Core.hpp>
+#include <impl/Kokkos_Spinwait.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+int setenv(const char* name, const char* value, int overwrite) {
+  int errcode = 0;
+  if (!overwrite) {
+    size_t envsize = 0;
+    errcode        = getenv_s(&envsize, NULL, 0, name);
+    if (errcode || envsize) return errcode;
+  }
+  return _putenv_s(name, value);
+}
+
+int unsetenv(const char* name) { return _putenv_s(name, ""); }
+#endif
+
+namespace Test {
+
+using Kokkos::Impl::WaitPolicy;
+
+// Initialization fails before it sets anything up, and Kokkos stays
+// uninitialized
+void expect_initialize_throws(const char* policy) {
+  char program[] = "test";
+  std::string arg(policy);
+  char* argv[] = {program, &arg[0]};
+  int argc     = arg.empty() ? 1 : 2;
+  EXPECT_THROW(Kokkos::initialize(argc, argv), std::runtime_error);
+  EXPECT_FALSE(Kokkos::is_initialized());
+}
+
+TEST(host_wait, initialize) {
+  unsetenv("KOKKOS_WAIT_POLICY");
+  expect_initialize_throws("--kokkos-wait-policy=sleepy");
+  expect_initialize_throws("--kokkos-wait-policy");
+
+  setenv("KOKKOS_WAIT_POLICY", "sleepy", 1);
+  expect_initialize_throws("");
+
+  // The command line and the environment must agree
+  setenv("KOKKOS_WAIT_POLICY", "active", 1);
+  expect_initialize_throws("--kokkos-wait-policy=hybrid");
+
+  char program[] = "test";
+  char policy[]  = "--kokkos-wait-policy=active";
+  char other[]   = "--kokkos-wait-policy-other";
+  char* argv[]   = {program, policy, other};
+  int argc       = 3;
+
+  // The policy is consumed, other arguments are left in place
+  Kokkos::initialize(argc, argv);
+  EXPECT_EQ(argc, 2);
+  EXPECT_EQ(argv[1], other);
+  EXPECT_EQ(Kokkos::Impl::host_wait_policy(), WaitPolicy::ACTIVE);
+  Kokkos::finalize();
+
+  setenv("KOKKOS_WAIT_POLICY", "passive", 1);
+  Kokkos::initialize();
+  EXPECT_EQ(Kokkos::Impl::host_wait_policy(), WaitPolicy::PASSIVE);
+  Kokkos::finalize();
+
+  unsetenv("KOKKOS_WAIT_POLICY");
+}
+
+TEST(host_wait, passive_wake) {
+  const WaitPolicy policy = Kokkos::Impl::host_wait_policy();
+  Kokkos::Impl::set_host_wait_policy(WaitPolicy::PASSIVE);
+  ASSERT_EQ(Kokkos::Impl::host_wait_policy(), WaitPolicy::PASSIVE);
+
+  const Kokkos::Impl::HostWaitStatistics before =
+      Kokkos::Impl::host_wait_statistics();
+
+  int volatile flag = 0;
+  std::atomic<bool> started(false);
+  std::thread waiter([&]() {
+    started = true;
+    Kokkos::Impl::host_thread_wait_while_equal(flag, 0);
+  });
+
+  // Give the waiter time to go to sleep before changing the flag
+  while (!started) std::this_thread::yield();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  Kokkos::atomic_exchange(const_cast<int*>(&flag), 1);
+  Kokkos::Impl::host_thread_wake(flag);
+  waiter.join();
+
+  // A flag that already differs returns at once
+  Kokkos::Impl::host_thread_wait_while_equal(flag, 0);
+
+#if defined(__linux__)
+  const Kokkos::Impl::HostWaitStatistics after =
+      Kokkos::Impl::host_wait_statistics();
+  ASSERT_EQ(after.sleeps, before.sleeps + 1);
+  ASSERT_GE(after.wakeup_ns, before.wakeup_ns);
+#endif
+
+  Kokkos::Impl::set_host_wait_policy(policy);
+}
+
+}  // namespace Test
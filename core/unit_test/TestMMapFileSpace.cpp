@@ -0,0 +1,191 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+
+#include <Kokkos_Core.hpp>
+
+#include <cstdint>
+#include <cstdio>
+
+#include <sys/stat.h>
+
+namespace Test {
+
+namespace {
+
+using mmap_space = Kokkos::Experimental::MMapFileSpace;
+
+size_t file_size(const std::string& path) {
+  struct stat st;
+  return stat(path.c_str(), &st) == 0 ? size_t(st.st_size) : 0;
+}
+
+}  // namespace
+
+TEST(mmap_file_space, persistent_labeled_file) {
+  using file_view = Kokkos::View<double*, mmap_space>;
+
+  const std::string label = "test_mmap_file_space.bin";
+  const int n             = 1000;
+  std::remove(label.c_str());
+
+  {
+    file_view a(Kokkos::view_alloc(mmap_space(), label), n);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(a.data()) % mmap_space::page_size(),
+              0u);
+    Kokkos::parallel_for(
+        "fill", Kokkos::RangePolicy<mmap_space::execution_space>(0, n),
+        KOKKOS_LAMBDA(const int i) { a(i) = 0.5 * i; });
+    Kokkos::fence();
+  }
+
+  ASSERT_EQ(file_size(label), n * sizeof(double));
+
+  {
+    // Mapping the file again yields the previous contents.
+    file_view b(Kokkos::view_alloc(mmap_space(), label), n);
+    for (int i = 0; i < n; ++i) ASSERT_EQ(b(i), 0.5 * i);
+  }
+
+  std::remove(label.c_str());
+}
+
+TEST(mmap_file_space, zero_copy_host_access) {
+  using file_view = Kokkos::View<int**, mmap_space>;
+
+  const std::string label = "test_mmap_file_space_host.bin";
+  std::remove(label.c_str());
+
+  {
+    file_view a(Kokkos::view_alloc(mmap_space(), label), 16, 8);
+
+    // Host views alias the mapping directly.
+    Kokkos::View<int**, Kokkos::HostSpace> h = a;
+    ASSERT_EQ(h.data(), a.data());
+    ASSERT_EQ(h.use_count(), 2);
+
+    auto m = Kokkos::create_mirror_view(a);
+    ASSERT_EQ(m.data(), a.data());
+
+    for (int i = 0; i < 16; ++i)
+      for (int j = 0; j < 8; ++j) h(i, j) = i * 8 + j;
+    mmap_space::sync(a.data(), a.span() * sizeof(int));
+  }
+
+  {
+    file_view a(Kokkos::view_alloc(mmap_space(), label), 16, 8);
+    for (int i = 0; i < 16; ++i)
+      for (int j = 0; j < 8; ++j) ASSERT_EQ(a(i, j), i * 8 + j);
+  }
+
+  std::remove(label.c_str());
+}
+
+TEST(mmap_file_space, deep_copy_host) {
+  using file_view = Kokkos::View<float*, mmap_space>;
+  using host_view = Kokkos::View<float*, Kokkos::HostSpace>;
+
+  const int n = 3 * 4096 + 7;
+
+  // An unlabeled allocation is backed by an unlinked temporary file.
+  file_view f(Kokkos::view_alloc(mmap_space(mmap_space().directory(),
+                                            mmap_space::Sequential),
+                                 std::string()),
+              n);
+  host_view src("src", n);
+  host_view dst("dst", n);
+  for (int i = 0; i < n; ++i) src(i) = float(i);
+
+  Kokkos::deep_copy(f, src);
+  for (int i = 0; i < n; ++i) ASSERT_EQ(f(i), float(i));
+
+  Kokkos::deep_copy(dst, f);
+  for (int i = 0; i < n; ++i) ASSERT_EQ(dst(i), float(i));
+
+  file_view g(Kokkos::view_alloc(mmap_space(), std::string()), n);
+  Kokkos::deep_copy(g, f);
+  for (int i = 0; i < n; ++i) ASSERT_EQ(g(i), float(i));
+}
+
+TEST(mmap_file_space, chunked_deep_copy) {
+  using file_view = Kokkos::View<double*, mmap_space>;
+  using host_view = Kokkos::View<double*, Kokkos::HostSpace>;
+
+  const size_t chunk = mmap_space::copy_chunk_size();
+  const int depth    = mmap_space::copy_prefetch_depth();
+
+  // Chunks are rounded up to whole pages.
+  mmap_space::set_copy_chunk_size(mmap_space::page_size() + 1);
+  ASSERT_EQ(mmap_space::copy_chunk_size(), 2 * mmap_space::page_size());
+  mmap_space::set_copy_chunk_size(mmap_space::page_size());
+  mmap_space::set_copy_prefetch_depth(3);
+
+  // Many chunks with a partial last one.
+  const int n = 10 * int(mmap_space::page_size() / sizeof(double)) + 3;
+
+  file_view f(Kokkos::view_alloc(mmap_space(), std::string()), n);
+  file_view g(Kokkos::view_alloc(mmap_space(), std::string()), n);
+  host_view src("src", n);
+  host_view dst("dst", n);
+  for (int i = 0; i < n; ++i) src(i) = 1.0 + i;
+
+  Kokkos::deep_copy(f, src);
+  Kokkos::deep_copy(g, f);
+  Kokkos::deep_copy(Kokkos::DefaultHostExecutionSpace(), dst, g);
+  Kokkos::fence();
+  for (int i = 0; i < n; ++i) ASSERT_EQ(dst(i), 1.0 + i);
+
+  // Partial copies through subviews start mid-page.
+  auto f_sub = Kokkos::subview(f, std::make_pair(5, n - 5));
+  auto d_sub = Kokkos::subview(dst, std::make_pair(5, n - 5));
+  Kokkos::deep_copy(d_sub, 0.0);
+  Kokkos::deep_copy(d_sub, f_sub);
+  for (int i = 0; i < n; ++i) ASSERT_EQ(dst(i), 1.0 + i);
+
+  mmap_space::set_copy_chunk_size(chunk);
+  mmap_space::set_copy_prefetch_depth(depth);
+}
+
+}  // namespace Test
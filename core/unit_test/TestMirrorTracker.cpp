@@ -0,0 +1,124 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+
+#include <Kokkos_Core.hpp>
+
+#include <set>
+#include <string>
+
+namespace Test {
+
+namespace {
+
+typedef Kokkos::Impl::SharedAllocationRecord<void, void> record_type;
+typedef Kokkos::View<double*, Kokkos::HostSpace> view_type;
+
+std::set<std::string> mirror_labels(const std::string& space) {
+  std::set<std::string> labels;
+  for (const Kokkos::Impl::MirrorTracker* m =
+           record_type::get_mirror_list(space);
+       m != nullptr; m = m->pNext) {
+    labels.insert(m->label);
+  }
+  return labels;
+}
+
+void* record_of(const view_type& v) {
+  return v.impl_track().get_record<Kokkos::HostSpace>();
+}
+
+}  // namespace
+
+TEST(mirror_tracker, index_by_space_and_label) {
+  view_type a("a", 4), a_mirror("a_mirror", 4);
+  view_type b("b", 4), b_mirror("b_mirror", 4);
+  view_type c("c", 4), c_mirror("c_mirror", 4);
+
+  record_type::track_mirror("SpaceA", "a", a_mirror.data(), a.data());
+  record_type::track_mirror("SpaceA", "b", b_mirror.data(), b.data());
+  record_type::track_mirror("SpaceB", "c", c_mirror.data(), c.data());
+
+  EXPECT_EQ(mirror_labels("SpaceA"), (std::set<std::string>{"a", "b"}));
+  EXPECT_EQ(mirror_labels("SpaceB"), (std::set<std::string>{"c"}));
+  EXPECT_TRUE(mirror_labels("SpaceC").empty());
+
+  const Kokkos::Impl::MirrorTracker* entry =
+      record_type::get_mirror_entry("SpaceA", "b");
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(entry->dst, record_of(b_mirror));
+  EXPECT_EQ(entry->src, record_of(b));
+  EXPECT_EQ(record_type::get_mirror_entry("SpaceB", "b"), nullptr);
+
+  // Tracking a label again updates its entry.
+  view_type b_mirror2("b_mirror2", 4);
+  record_type::track_mirror("SpaceA", "b", b_mirror2.data(), b.data());
+  EXPECT_EQ(record_type::get_mirror_entry("SpaceA", "b")->dst,
+            record_of(b_mirror2));
+  EXPECT_EQ(mirror_labels("SpaceA").size(), 2u);
+
+  // Caller owned copies.
+  Kokkos::Impl::MirrorTracker* copies =
+      record_type::get_filtered_mirror_list("SpaceA");
+  int count = 0;
+  while (copies != nullptr) {
+    Kokkos::Impl::MirrorTracker* next = copies->pNext;
+    delete copies;
+    copies = next;
+    ++count;
+  }
+  EXPECT_EQ(count, 2);
+
+  // Release by record, including the most recently tracked entry.
+  record_type::release_mirror(record_of(b_mirror2));
+  EXPECT_EQ(mirror_labels("SpaceA"), (std::set<std::string>{"a"}));
+  record_type::release_mirror(record_of(a));
+  EXPECT_TRUE(mirror_labels("SpaceA").empty());
+
+  record_type::release_mirror(std::string("c"));
+  EXPECT_TRUE(mirror_labels("SpaceB").empty());
+}
+
+}  // namespace Test
@@ -402,6 +402,16 @@ TEST(TEST_CATEGORY, range_for) {
     TestRange<TEST_EXECSPACE, Kokkos::Schedule<Kokkos::Dynamic> > f(1001);
     f.test_for();
   }
+
+  {
+    TestRange<TEST_EXECSPACE, Kokkos::Schedule<Kokkos::Guided> > f(1001);
+    f.test_for();
+  }
+  {
+    TestRange<TEST_EXECSPACE, Kokkos::Schedule<Kokkos::Adaptive> > f(1001);
+    // Later launches run with the chunk tuned by earlier ones
+    for (int i = 0; i < 3; ++i) f.test_for();
+  }
 }
 
 TEST(TEST_CATEGORY, range_reduce) {
@@ -431,6 +441,16 @@ TEST(TEST_CATEGORY, range_reduce) {
     TestRange<TEST_EXECSPACE, Kokkos::Schedule<Kokkos::Dynamic> > f(1001);
     f.test_reduce();
   }
+
+  {
+    TestRange<TEST_EXECSPACE, Kokkos::Schedule<Kokkos::Guided> > f(1001);
+    f.test_reduce();
+  }
+  {
+    TestRange<TEST_EXECSPACE, Kokkos::Schedule<Kokkos::Adaptive> > f(1001);
+    // Later launches run with the chunk tuned by earlier ones
+    for (int i = 0; i < 3; ++i) f.test_reduce();
+  }
 }
 
 #ifndef KOKKOS_ENABLE_OPENMPTARGET
@@ -0,0 +1,338 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+
+#include <Kokkos_Core.hpp>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace Test {
+
+namespace {
+
+using host_exec = Kokkos::DefaultHostExecutionSpace;
+
+// Stands in for a resilient memory space, which owns a tracker registry.
+struct PolicyTestSpace {
+  typedef host_exec execution_space;
+
+  static void end_launch() {
+    Kokkos::Experimental::duplicate_registry<PolicyTestSpace>().clear();
+  }
+};
+
+int launch_dup_target(Kokkos::Impl::SharedAllocationRecord<void, void>* r) {
+  const int target = Kokkos::Experimental::duplicate_tracker<
+                         double*, PolicyTestSpace>(r)
+                         ->dup_target;
+  PolicyTestSpace::end_launch();
+  return target;
+}
+
+template <class T>
+struct DuplicateSet {
+  std::vector<T> orig, d0, d1, d2;
+
+  explicit DuplicateSet(size_t n) : orig(n), d0(n), d1(n), d2(n) {
+    for (size_t i = 0; i < n; ++i) d0[i] = d1[i] = d2[i] = T(i % 97);
+  }
+};
+
+}  // namespace
+
+TEST(track_duplicates, vote_counts_mismatches) {
+  const size_t n = 1000;  // not a multiple of the block size
+  DuplicateSet<int> s(n);
+
+  s.d0[3]   = -1;  // single corrupted copies are outvoted
+  s.d1[400] = -1;
+  s.d2[999] = -1;
+  s.d0[10]  = -1;  // no majority, the third copy wins
+  s.d1[10]  = -2;
+  s.d2[10]  = -3;
+
+  Kokkos::Experimental::CombineFunctor<int, host_exec> cf;
+  cf.load_ptrs(s.orig.data(), s.d0.data(), s.d1.data(), s.d2.data(), n);
+  const Kokkos::Experimental::DuplicateVoteCounts counts = cf.combine();
+
+  EXPECT_EQ(counts.mismatches, 4u);
+  EXPECT_EQ(counts.unresolved, 1u);
+  for (size_t i = 0; i < n; ++i) {
+    if (i != 10) {
+      ASSERT_EQ(s.orig[i], int(i % 97));
+    }
+  }
+  EXPECT_EQ(s.orig[10], -3);
+}
+
+TEST(track_duplicates, floating_point_tolerance) {
+  const size_t n = 300;
+  DuplicateSet<double> s(n);
+  s.d1[7] += 1.0e-4;
+  s.d2[8] += 1.0e-4;
+
+  Kokkos::Experimental::CombineFunctor<double, host_exec> cf;
+  cf.load_ptrs(s.orig.data(), s.d0.data(), s.d1.data(), s.d2.data(), n);
+  EXPECT_EQ(cf.combine().mismatches, 2u);
+
+  const double tolerance = Kokkos::Experimental::duplicate_tolerance<double>();
+  Kokkos::Experimental::set_duplicate_tolerance(1.0e-3);
+  cf.load_ptrs(s.orig.data(), s.d0.data(), s.d1.data(), s.d2.data(), n);
+  EXPECT_EQ(cf.combine().mismatches, 0u);
+  Kokkos::Experimental::set_duplicate_tolerance(tolerance);
+
+  // NaN never agrees, so it is outvoted.
+  s.d0[20] = std::nan("");
+  cf.load_ptrs(s.orig.data(), s.d0.data(), s.d1.data(), s.d2.data(), n);
+  const Kokkos::Experimental::DuplicateVoteCounts counts = cf.combine();
+  EXPECT_EQ(counts.mismatches, 3u);
+  EXPECT_EQ(counts.unresolved, 0u);
+  EXPECT_EQ(s.orig[20], 20.0);
+}
+
+TEST(track_duplicates, tracker_statistics) {
+  const size_t n = 512;
+  DuplicateSet<float> s(n);
+  s.d2[100] = -1.0f;
+
+  Kokkos::Experimental::SpecDuplicateTracker<float*, host_exec> dt;
+  dt.original_data = s.orig.data();
+  dt.data_len      = int(n * sizeof(float));
+  dt.dup_list[0]   = s.d0.data();
+  dt.dup_list[1]   = s.d1.data();
+  dt.dup_list[2]   = s.d2.data();
+  dt.dup_cnt       = 3;
+
+  dt.combine_dups();
+  dt.combine_dups();
+
+  EXPECT_EQ(dt.voted_elements, 2 * n);
+  EXPECT_EQ(dt.mismatched_elements, 2u);
+  EXPECT_EQ(dt.unresolved_elements, 0u);
+  EXPECT_EQ(s.orig[100], float(100 % 97));
+}
+
+TEST(track_duplicates, duplication_policy) {
+  typedef Kokkos::Experimental::DuplicationPolicy policy;
+
+  Kokkos::View<double*, Kokkos::HostSpace> a("policy_a", 10);
+  Kokkos::View<double*, Kokkos::HostSpace> b("policy_b", 10);
+  auto* ra = a.impl_track().get_record<Kokkos::HostSpace>();
+  auto* rb = b.impl_track().get_record<Kokkos::HostSpace>();
+
+  policy::reset();
+  EXPECT_EQ(launch_dup_target(ra), 3);
+
+  policy::set_replication("policy_a", 2);
+  policy::set_default_replication(1);
+  EXPECT_EQ(launch_dup_target(ra), 2);
+  EXPECT_EQ(launch_dup_target(rb), 0);
+
+  // Only every third launch of the label is duplicated.
+  policy::set_replication("policy_b", 3, 3);
+  for (int launch = 0; launch < 7; ++launch) {
+    EXPECT_EQ(launch_dup_target(rb), launch % 3 == 0 ? 3 : 0);
+  }
+
+  // The tracker is shared by the copies of one launch.
+  auto* dt = Kokkos::Experimental::duplicate_tracker<double*, PolicyTestSpace>(
+      ra);
+  EXPECT_EQ(dt, (Kokkos::Experimental::duplicate_tracker<double*,
+                                                         PolicyTestSpace>(ra)));
+  PolicyTestSpace::end_launch();
+
+  EXPECT_THROW(policy::set_replication("policy_a", 4), std::runtime_error);
+  EXPECT_THROW(policy::set_default_replication(3, 0), std::runtime_error);
+
+  policy::reset();
+  EXPECT_EQ(policy::replication("policy_a"), 3);
+  EXPECT_EQ(policy::check_interval("policy_b"), 1);
+}
+
+TEST(track_duplicates, two_copies_detect) {
+  const size_t n = 64;
+  DuplicateSet<int> s(n);
+  s.d1[5] = -1;
+
+  Kokkos::Experimental::SpecDuplicateTracker<int*, host_exec> dt;
+  dt.original_data = s.orig.data();
+  dt.data_len      = int(n * sizeof(int));
+  dt.dup_list[0]   = s.d0.data();
+  dt.dup_list[1]   = s.d1.data();
+  dt.dup_cnt       = 2;
+
+  dt.combine_dups();
+
+  EXPECT_EQ(dt.mismatched_elements, 1u);
+  EXPECT_EQ(dt.unresolved_elements, 1u);
+  EXPECT_EQ(s.orig[4], 4);
+  EXPECT_EQ(s.orig[5], -1);
+}
+
+TEST(track_duplicates, registry_keyed_by_record) {
+  typedef Kokkos::Experimental::DuplicateRegistry registry_type;
+
+  Kokkos::View<int*, Kokkos::HostSpace> a("registry_view", 10);
+  Kokkos::View<int*, Kokkos::HostSpace> b("registry_view", 10);
+  auto* ra = a.impl_track().get_record<Kokkos::HostSpace>();
+  auto* rb = b.impl_track().get_record<Kokkos::HostSpace>();
+
+  Kokkos::Experimental::DuplicationPolicy::reset();
+  registry_type& registry =
+      Kokkos::Experimental::duplicate_registry<PolicyTestSpace>();
+
+  // Allocations sharing a label are tracked separately.
+  auto* ta =
+      Kokkos::Experimental::duplicate_tracker<int*, PolicyTestSpace>(ra);
+  auto* tb =
+      Kokkos::Experimental::duplicate_tracker<int*, PolicyTestSpace>(rb);
+  EXPECT_NE(ta, tb);
+  EXPECT_EQ(registry.size(), 2u);
+  EXPECT_EQ(registry.find(ra), ta);
+  EXPECT_EQ(ta->label, "registry_view");
+  EXPECT_NE(registry.find_label("registry_view"), nullptr);
+  EXPECT_EQ(registry.find_label("missing"), nullptr);
+
+  // Losing an insertion race returns the registered tracker.
+  auto* extra = new Kokkos::Experimental::DuplicateTracker();
+  EXPECT_EQ(registry.insert(ra, extra), ta);
+  EXPECT_EQ(registry.size(), 2u);
+
+  // Copies of a view claim distinct duplicate slots, voted up to the
+  // factor.  Copies beyond it still get a duplicate of their own.
+  EXPECT_EQ(ta->reserve_dup(), 0);
+  EXPECT_EQ(ta->reserve_dup(), 1);
+  EXPECT_EQ(ta->reserve_dup(), 2);
+  EXPECT_EQ(ta->reserve_dup(), 3);
+  EXPECT_TRUE(ta->votes(2));
+  EXPECT_FALSE(ta->votes(3));
+  EXPECT_EQ(registry.replication(), 3);
+
+  registry.clear();
+  EXPECT_EQ(registry.size(), 0u);
+  EXPECT_EQ(registry.find(ra), nullptr);
+}
+
+TEST(track_duplicates, unreplicated_launch) {
+  typedef Kokkos::Experimental::DuplicationPolicy policy;
+  typedef Kokkos::Experimental::DuplicateRegistry registry_type;
+
+  Kokkos::View<int*, Kokkos::HostSpace> a("unreplicated_a", 10);
+  Kokkos::View<int*, Kokkos::HostSpace> b("unreplicated_b", 10);
+  auto* ra = a.impl_track().get_record<Kokkos::HostSpace>();
+  auto* rb = b.impl_track().get_record<Kokkos::HostSpace>();
+
+  policy::reset();
+  policy::set_replication("unreplicated_a", 1);
+  registry_type& registry =
+      Kokkos::Experimental::duplicate_registry<PolicyTestSpace>();
+
+  // Only the first copy runs on the original allocation; the launch
+  // executes once.
+  auto* ta =
+      Kokkos::Experimental::duplicate_tracker<int*, PolicyTestSpace>(ra);
+  EXPECT_EQ(registry.replication(), 1);
+  EXPECT_EQ(ta->reserve_dup(), -1);
+  EXPECT_EQ(ta->reserve_dup(), 1);
+  EXPECT_FALSE(ta->votes(1));
+
+  // Replicating another view of the launch replicates the launch.
+  Kokkos::Experimental::duplicate_tracker<int*, PolicyTestSpace>(rb);
+  EXPECT_EQ(registry.replication(), 3);
+
+  PolicyTestSpace::end_launch();
+  policy::reset();
+}
+
+TEST(track_duplicates, launch_counted_once) {
+  typedef Kokkos::Experimental::DuplicationPolicy policy;
+
+  Kokkos::View<double*, Kokkos::HostSpace> a("counted_a", 10);
+  auto* ra = a.impl_track().get_record<Kokkos::HostSpace>();
+
+  policy::reset();
+  policy::set_replication("counted_a", 3, 2);
+
+  // Concurrent first copies of one launch share its policy and count one
+  // launch, so the next launch is sampled out.
+  int unchecked = 0;
+  Kokkos::parallel_reduce(
+      Kokkos::RangePolicy<host_exec>(0, 64),
+      [ra](int, int& count) {
+        count += Kokkos::Experimental::duplicate_tracker<
+                     double*, PolicyTestSpace>(ra)
+                     ->dup_target != 3;
+      },
+      unchecked);
+  PolicyTestSpace::end_launch();
+
+  EXPECT_EQ(unchecked, 0);
+  EXPECT_EQ(launch_dup_target(ra), 0);
+  EXPECT_EQ(launch_dup_target(ra), 3);
+
+  policy::reset();
+}
+
+TEST(track_duplicates, registry_concurrent_insert) {
+  typedef Kokkos::Experimental::DuplicateRegistry registry_type;
+  registry_type registry;
+
+  // Every record is inserted by several host threads at once.
+  const int n = 4096;
+  std::vector<double> records(n);
+  double* const keys = records.data();
+  Kokkos::parallel_for(
+      Kokkos::RangePolicy<host_exec>(0, 4 * n), [&registry, keys](int i) {
+        registry.insert(keys + i / 4,
+                        new Kokkos::Experimental::DuplicateTracker());
+      });
+
+  EXPECT_EQ(registry.size(), size_t(n));
+  for (int i = 0; i < n; ++i) ASSERT_NE(registry.find(&records[i]), nullptr);
+}
+
+}  // namespace Test
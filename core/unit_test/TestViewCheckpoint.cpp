@@ -0,0 +1,389 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ViewCheckpoint.hpp>
+#include <impl/Kokkos_CheckpointCompression.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+#include <sys/stat.h>
+
+namespace Test {
+
+namespace {
+
+void remove_checkpoint(const std::string& name, int version) {
+  const std::string base = "./" + name + "." + std::to_string(version);
+  std::remove((base + ".kokkos_ckpt").c_str());
+  std::remove((base + ".manifest").c_str());
+}
+
+}  // namespace
+
+TEST(view_checkpoint, skip_unchanged_and_restore) {
+  using host_view_1d = Kokkos::View<double*, Kokkos::HostSpace>;
+  using host_view_2d = Kokkos::View<int**, Kokkos::HostSpace>;
+
+  const std::string name = "test_view_checkpoint";
+
+  Kokkos::View<double*> a("a", 1000);
+  Kokkos::View<int**> b("b", 10, 20);
+  Kokkos::View<const int**> b_const = b;
+
+  Kokkos::parallel_for(
+      "fill_a", a.extent(0), KOKKOS_LAMBDA(const int i) { a(i) = 0.5 * i; });
+  Kokkos::parallel_for(
+      "fill_b", b.extent(0), KOKKOS_LAMBDA(const int i) {
+        for (int j = 0; j < 20; ++j) b(i, j) = i * 20 + j;
+      });
+  Kokkos::fence();
+
+  // Captures 'b' twice; the engine must store it once.
+  auto step = [=]() {
+    (void)a;
+    (void)b;
+    (void)b_const;
+  };
+
+  {
+    Kokkos::Experimental::CheckpointEngine engine(".");
+
+    engine.checkpoint(name, 0, step);
+    Kokkos::deep_copy(a, 3.0);
+    engine.checkpoint(name, 1, step);
+    engine.fence();
+
+    ASSERT_TRUE(engine.exists(name, 0));
+    ASSERT_TRUE(engine.exists(name, 1));
+    ASSERT_FALSE(engine.exists(name, 2));
+
+    const auto stats = engine.statistics();
+    ASSERT_EQ(stats.checkpoints, 2u);
+    ASSERT_EQ(stats.views_captured, 4u);
+    ASSERT_EQ(stats.views_written, 3u);
+    ASSERT_EQ(stats.views_skipped, 1u);
+
+    Kokkos::deep_copy(a, 0.0);
+    Kokkos::deep_copy(b, 0);
+
+    engine.restore(name, 1, step);
+
+    host_view_1d h_a("h_a", a.extent(0));
+    host_view_2d h_b("h_b", b.extent(0), b.extent(1));
+    Kokkos::deep_copy(h_a, a);
+    Kokkos::deep_copy(h_b, b);
+    for (int i = 0; i < 1000; ++i) ASSERT_EQ(h_a(i), 3.0);
+    for (int i = 0; i < 10; ++i) {
+      for (int j = 0; j < 20; ++j) ASSERT_EQ(h_b(i, j), i * 20 + j);
+    }
+
+    engine.restore(name, 0, step);
+    Kokkos::deep_copy(h_a, a);
+    for (int i = 0; i < 1000; ++i) ASSERT_EQ(h_a(i), 0.5 * i);
+
+    // After a restore only Views changed since are written again.
+    engine.checkpoint(name, 2, step);
+    engine.fence();
+    ASSERT_EQ(engine.statistics().views_skipped, 3u);
+  }
+
+  for (int version = 0; version < 3; ++version) {
+    remove_checkpoint(name, version);
+  }
+}
+
+TEST(view_checkpoint, block_delta) {
+  using host_view_1d = Kokkos::View<double*, Kokkos::HostSpace>;
+
+  const std::string name = "test_view_checkpoint_blocks";
+  const size_t block_size = 4096;
+
+  // 80000 bytes: 19 full blocks and a partial one.
+  Kokkos::View<double*> a("a", 10000);
+  Kokkos::View<double**, Kokkos::LayoutRight> b("b", 8, 8);
+  auto b_col = Kokkos::subview(b, Kokkos::ALL(), 1);
+
+  Kokkos::parallel_for(
+      "fill_a", a.extent(0), KOKKOS_LAMBDA(const int i) { a(i) = i; });
+  Kokkos::parallel_for(
+      "fill_b", b_col.extent(0), KOKKOS_LAMBDA(const int i) { b_col(i) = i; });
+  Kokkos::fence();
+
+  auto step = [=]() {
+    (void)a;
+    (void)b_col;
+  };
+
+  {
+    Kokkos::Experimental::CheckpointEngine engine(".", block_size);
+
+    engine.checkpoint(name, 0, step);
+    Kokkos::parallel_for(
+        "touch_a", 1, KOKKOS_LAMBDA(const int) {
+          a(0)    = -1;
+          a(9999) = -2;
+        });
+    Kokkos::fence();
+    engine.checkpoint(name, 1, step);
+    engine.fence();
+
+    // The strided subview is not contiguous and is checkpointed whole.
+    const auto stats = engine.statistics();
+    ASSERT_EQ(stats.blocks_written, 22u);
+    ASSERT_EQ(stats.blocks_skipped, 18u);
+    ASSERT_EQ(stats.views_skipped, 1u);
+
+    Kokkos::deep_copy(a, 0.0);
+    engine.restore(name, 1, step);
+
+    host_view_1d h_a("h_a", a.extent(0));
+    Kokkos::deep_copy(h_a, a);
+    ASSERT_EQ(h_a(0), -1.0);
+    ASSERT_EQ(h_a(9999), -2.0);
+    for (int i = 1; i < 9999; ++i) ASSERT_EQ(h_a(i), double(i));
+
+    engine.restore(name, 0, step);
+    Kokkos::deep_copy(h_a, a);
+    for (int i = 0; i < 10000; ++i) ASSERT_EQ(h_a(i), double(i));
+
+    // Restoring seeds the block hashes, so an unchanged View writes nothing.
+    engine.checkpoint(name, 2, step);
+    engine.fence();
+    ASSERT_EQ(engine.statistics().blocks_written, 22u);
+  }
+
+  for (int version = 0; version < 3; ++version) {
+    remove_checkpoint(name, version);
+  }
+}
+
+TEST(view_checkpoint, lz_round_trip) {
+  std::vector<std::vector<unsigned char> > inputs;
+  for (size_t n : {0, 1, 9, 10, 17, 100}) {
+    inputs.push_back(std::vector<unsigned char>(n, 7));
+  }
+  std::vector<unsigned char> random(1 << 20), runs(1 << 20), text(70000);
+  unsigned state = 12345;
+  for (size_t i = 0; i < random.size(); ++i) {
+    state     = state * 1103515245u + 12345u;
+    random[i] = static_cast<unsigned char>(state >> 24);
+    runs[i]   = static_cast<unsigned char>((i / 300) % 3);
+  }
+  for (size_t i = 0; i < text.size(); ++i) text[i] = "abcabd"[i % 6];
+  inputs.push_back(random);
+  inputs.push_back(runs);
+  inputs.push_back(text);
+
+  for (const std::vector<unsigned char>& in : inputs) {
+    std::vector<unsigned char> packed(
+        Kokkos::Impl::checkpoint_lz_bound(in.size()));
+    const size_t m = Kokkos::Impl::checkpoint_lz_compress(
+        in.data(), in.size(), packed.data());
+    ASSERT_LE(m, packed.size());
+
+    std::vector<unsigned char> out(in.size());
+    ASSERT_TRUE(Kokkos::Impl::checkpoint_lz_decompress(packed.data(), m,
+                                                       out.data(), out.size()));
+    ASSERT_EQ(out, in);
+    if (!in.empty()) {
+      ASSERT_FALSE(Kokkos::Impl::checkpoint_lz_decompress(
+          packed.data(), m, out.data(), out.size() - 1));
+    }
+  }
+}
+
+TEST(view_checkpoint, compressed) {
+  using host_view_d = Kokkos::View<double*, Kokkos::HostSpace>;
+  using host_view_i = Kokkos::View<int*, Kokkos::HostSpace>;
+
+  const std::string name = "test_view_checkpoint_compressed";
+  const int n            = 300000;
+  const double bound     = 1.0e-6;
+
+  host_view_d a("a", n);
+  host_view_i b("b", n);
+  for (int i = 0; i < n; ++i) {
+    a(i) = std::sin(1.0e-4 * i);
+    b(i) = i / 16;
+  }
+  a(n / 2) = std::numeric_limits<double>::quiet_NaN();
+
+  const host_view_d a_ref("a_ref", n);
+  Kokkos::deep_copy(a_ref, a);
+
+  auto step = [=]() {
+    (void)a;
+    (void)b;
+  };
+
+  {
+    Kokkos::Experimental::CheckpointEngine engine(".");
+    typedef Kokkos::Experimental::CheckpointEngine::Compression compression;
+    ASSERT_THROW(engine.set_compression(compression::Lossy),
+                 std::runtime_error);
+
+    engine.set_compression(compression::Lossless);
+    engine.checkpoint(name, 0, step);
+    engine.fence();
+    const auto lossless = engine.statistics();
+    ASSERT_LT(lossless.bytes_written, lossless.bytes_staged);
+
+    engine.set_compression(compression::Lossy, bound);
+    Kokkos::deep_copy(b, 1);
+    engine.checkpoint(name, 1, step);
+    engine.fence();
+    const auto lossy = engine.statistics();
+    ASSERT_LT(lossy.bytes_written - lossless.bytes_written,
+              lossless.bytes_written / 2);
+
+    Kokkos::deep_copy(a, 0.0);
+    Kokkos::deep_copy(b, 0);
+    engine.restore(name, 0, step);
+    for (int i = 0; i < n; ++i) {
+      if (i == n / 2) {
+        ASSERT_TRUE(std::isnan(a(i)));
+      } else {
+        ASSERT_EQ(a(i), a_ref(i));
+      }
+      ASSERT_EQ(b(i), i / 16);
+    }
+
+    // Version 1 only wrote 'b'; 'a' is unchanged and comes from version 0.
+    engine.restore(name, 1, step);
+    for (int i = 0; i < n; ++i) ASSERT_EQ(b(i), 1);
+
+    Kokkos::parallel_for(
+        "scale_a", Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, n),
+        [=](const int i) { a(i) = 2 * a_ref(i); });
+    engine.checkpoint(name, 2, step);
+    engine.fence();
+    Kokkos::deep_copy(a, 0.0);
+    engine.restore(name, 2, step);
+    for (int i = 0; i < n; ++i) {
+      if (i == n / 2) {
+        ASSERT_TRUE(std::isnan(a(i)));
+      } else {
+        ASSERT_LE(std::fabs(a(i) - 2 * a_ref(i)), bound);
+      }
+    }
+  }
+
+  for (int version = 0; version < 3; ++version) {
+    remove_checkpoint(name, version);
+  }
+}
+
+TEST(view_checkpoint, failed_write) {
+  using host_view_1d = Kokkos::View<double*, Kokkos::HostSpace>;
+
+  const std::string name  = "test_view_checkpoint_failed";
+  const std::string data1 = "./" + name + ".1.kokkos_ckpt";
+
+  Kokkos::View<double*> a("a", 10000);
+  Kokkos::parallel_for(
+      "fill_a", a.extent(0), KOKKOS_LAMBDA(const int i) { a(i) = i; });
+  Kokkos::fence();
+  auto step = [=]() { (void)a; };
+
+  {
+    Kokkos::Experimental::CheckpointEngine engine(".", 4096);
+    engine.checkpoint(name, 0, step);
+    engine.fence();
+
+    // A directory in the way of the data file fails the delta write
+    ASSERT_EQ(mkdir(data1.c_str(), 0700), 0);
+    Kokkos::parallel_for(
+        "touch_a", 1, KOKKOS_LAMBDA(const int) { a(0) = -1; });
+    Kokkos::fence();
+    engine.checkpoint(name, 1, step);
+    ASSERT_THROW(engine.fence(), std::runtime_error);
+    rmdir(data1.c_str());
+
+    // The blocks of the failed version were never written, so the next
+    // checkpoint writes every block rather than skipping them.
+    const size_t written = engine.statistics().blocks_written;
+    engine.checkpoint(name, 2, step);
+    engine.fence();
+    ASSERT_EQ(engine.statistics().blocks_written, written + 20);
+
+    Kokkos::deep_copy(a, 0.0);
+    engine.restore(name, 2, step);
+    host_view_1d h_a("h_a", a.extent(0));
+    Kokkos::deep_copy(h_a, a);
+    ASSERT_EQ(h_a(0), -1.0);
+    for (int i = 1; i < 10000; ++i) ASSERT_EQ(h_a(i), double(i));
+  }
+
+  for (int version = 0; version < 3; ++version) {
+    remove_checkpoint(name, version);
+  }
+}
+
+TEST(view_checkpoint, missing_version) {
+  Kokkos::View<double*> a("a", 10);
+  auto step = [=]() { (void)a; };
+
+  Kokkos::Experimental::CheckpointEngine engine(".");
+  ASSERT_THROW(engine.restore("test_view_checkpoint_missing", 0, step),
+               std::runtime_error);
+
+  // Manifests of earlier formats are rejected rather than misread
+  const std::string name = "test_view_checkpoint_old_version";
+  const std::string path = "./" + name + ".0.manifest";
+  std::FILE* manifest    = std::fopen(path.c_str(), "w");
+  ASSERT_NE(manifest, nullptr);
+  std::fputs("kokkos_checkpoint 2\n", manifest);
+  std::fclose(manifest);
+  ASSERT_TRUE(engine.exists(name, 0));
+  ASSERT_THROW(engine.restore(name, 0, step), std::runtime_error);
+  remove_checkpoint(name, 0);
+}
+
+}  // namespace Test
@@ -0,0 +1,151 @@
+/*
+//@HEADER
+// ************************************************************************
+//
+//                        Kokkos v. 3.0
+//       Copyright (2020) National Technology & Engineering
+//               Solutions of Sandia, LLC (NTESS).
+//
+// Under the terms of Contract DE-NA0003525 with NTESS,
+// the U.S. Government retains certain rights in this software.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the Corporation nor the names of the
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY NTESS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL NTESS OR THE
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Questions? Contact Christian R. Trott (crtrott@sandia.gov)
+//
+// ************************************************************************
+//@HEADER
+*/
+
+#include <gtest/gtest.h>
+
+#include <Kokkos_Core.hpp>
+
+#include <string>
+#include <vector>
+
+namespace Test {
+
+namespace {
+
+typedef Kokkos::View<double*, Kokkos::HostSpace> view_type;
+typedef Kokkos::View<const double*, Kokkos::HostSpace> const_view_type;
+
+struct recording_hook : Kokkos::ViewHook {
+  std::vector<std::string> labels;
+  std::vector<std::string> const_labels;
+
+  void on_copy(Kokkos::ViewHolderBase& view) override {
+    labels.push_back(view.label());
+    // Copies made while a hook runs are not reported again
+    std::unique_ptr<Kokkos::ViewHolderBase> keep(view.clone());
+  }
+  void on_copy(Kokkos::ConstViewHolderBase& view) override {
+    const_labels.push_back(view.label());
+  }
+};
+
+}  // namespace
+
+TEST(view_hooks, unset_by_default) {
+  ASSERT_FALSE(Kokkos::ViewHooks::is_set());
+  view_type a("a", 4);
+  view_type b(a);
+  ASSERT_EQ(a.data(), b.data());
+}
+
+TEST(view_hooks, multiple_hooks) {
+  recording_hook first, second;
+  view_type a("a", 4);
+  const_view_type c = a;
+  {
+    Kokkos::ScopedViewHook scope_first(first);
+    Kokkos::ScopedViewHook scope_second(second);
+    ASSERT_TRUE(Kokkos::ViewHooks::is_set());
+
+    view_type a_copy(a);
+    const_view_type c_copy(c);
+  }
+  ASSERT_FALSE(Kokkos::ViewHooks::is_set());
+
+  view_type after(a);
+
+  for (recording_hook* h : {&first, &second}) {
+    ASSERT_EQ(h->labels, std::vector<std::string>{"a"});
+    ASSERT_EQ(h->const_labels, std::vector<std::string>{"a"});
+  }
+}
+
+TEST(view_hooks, global_hook) {
+  recording_hook hook;
+  view_type a("a", 4);
+  {
+    Kokkos::ScopedViewHook scope(hook, true);
+    view_type a_copy(a);
+  }
+  view_type after(a);
+  ASSERT_EQ(hook.labels, std::vector<std::string>{"a"});
+}
+
+TEST(view_hooks, capacity) {
+  recording_hook hooks[Kokkos::ViewHooks::max_hooks + 1];
+  for (int i = 0; i < Kokkos::ViewHooks::max_hooks; ++i) {
+    Kokkos::ViewHooks::add(&hooks[i]);
+  }
+  ASSERT_THROW(Kokkos::ViewHooks::add(&hooks[Kokkos::ViewHooks::max_hooks]),
+               std::runtime_error);
+  for (int i = 0; i < Kokkos::ViewHooks::max_hooks; ++i) {
+    Kokkos::ViewHooks::remove(&hooks[i]);
+  }
+  ASSERT_FALSE(Kokkos::ViewHooks::is_set());
+}
+
+TEST(view_hooks, legacy_callbacks) {
+  int mutable_copies = 0, const_copies = 0;
+  view_type a("a", 4);
+  const_view_type c = a;
+
+  Kokkos::ViewHooks::set(
+      [&](Kokkos::ViewHolderBase&) { ++mutable_copies; },
+      [&](Kokkos::ConstViewHolderBase&) { ++const_copies; });
+  {
+    view_type a_copy(a);
+    const_view_type c_copy(c);
+  }
+  // A second set replaces the first pair
+  Kokkos::ViewHooks::set([&](Kokkos::ViewHolderBase&) {},
+                         [&](Kokkos::ConstViewHolderBase&) {});
+  view_type ignored(a);
+  Kokkos::ViewHooks::clear();
+  ASSERT_FALSE(Kokkos::ViewHooks::is_set());
+
+  ASSERT_EQ(mutable_copies, 1);
+  ASSERT_EQ(const_copies, 1);
+}
+
+}  // namespace Test
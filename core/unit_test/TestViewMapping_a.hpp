@@ -871,6 +871,8 @@ void test_view_mapping() {
     V vi(view_alloc(WithoutInitializing), N);
     V vj(view_alloc(std::string("vj"), AllowPadding), N);
     V vk(view_alloc(mem_space, std::string("vk"), AllowPadding), N);
+    V vl(view_alloc("vl", NumaPolicy::FirstTouchStatic), N);
+    V vm(view_alloc(WithoutInitializing, NumaPolicy::Interleave, "vm"), N);
   }
 
   {
@@ -1097,6 +1099,42 @@ void test_view_mapping() {
 }
 
 TEST(TEST_CATEGORY, view_mapping) { test_view_mapping<TEST_EXECSPACE>(); }
+
+template <class ViewType>
+struct TestViewNumaPolicySum {
+  ViewType a, b;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const int i, double& update) const { update += a(i) + b(i); }
+};
+
+template <class ExecSpace>
+void test_view_alloc_numa_policy() {
+  typedef Kokkos::View<double*, ExecSpace> V;
+
+  // Large enough to span many pages
+  const int N = 1 << 20;
+
+  const Kokkos::NumaPolicy policies[] = {Kokkos::NumaPolicy::Default,
+                                         Kokkos::NumaPolicy::FirstTouchStatic,
+                                         Kokkos::NumaPolicy::Interleave};
+
+  for (const Kokkos::NumaPolicy policy : policies) {
+    V a(Kokkos::view_alloc("a", policy), N);
+    V b(Kokkos::view_alloc("b", Kokkos::WithoutInitializing, policy), N);
+
+    Kokkos::deep_copy(b, 1.0);
+
+    double sum = 0;
+    Kokkos::parallel_reduce(Kokkos::RangePolicy<ExecSpace>(0, N),
+                            TestViewNumaPolicySum<V>{a, b}, sum);
+    ASSERT_EQ(sum, double(N));
+  }
+}
+
+TEST(TEST_CATEGORY, view_alloc_numa_policy) {
+  test_view_alloc_numa_policy<TEST_EXECSPACE>();
+}
 /*--------------------------------------------------------------------------*/
 
 template <class ViewType>
@@ -45,8 +45,17 @@
 #include <gtest/gtest.h>
 
 #include <Kokkos_Core.hpp>
+#include <impl/Kokkos_HostSpaceCache.hpp>
+#include <impl/Kokkos_HostSpace_deepcopy.hpp>
 #include <default/TestDefaultDeviceType_Category.hpp>
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #if !defined(KOKKOS_ENABLE_CUDA) || defined(__CUDACC__)
 
 namespace Test {
@@ -70,6 +79,170 @@ TEST(TEST_CATEGORY, host_space_access) {
                 "");
 }
 
+#if defined(__linux__)
+TEST(TEST_CATEGORY, host_space_huge_pages) {
+  Kokkos::HostSpace space(Kokkos::HostSpace::HUGE_PAGES);
+
+  // Below, at and above one huge page
+  const size_t sizes[] = {64, size_t(1) << 21, (size_t(1) << 22) + 123};
+
+  for (const size_t size : sizes) {
+    char* const ptr = static_cast<char*>(space.allocate(size));
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(ptr) %
+                  Kokkos::Impl::MEMORY_ALIGNMENT,
+              0u);
+    ptr[0]        = 1;
+    ptr[size - 1] = 2;
+    ASSERT_EQ(ptr[0] + ptr[size - 1], 3);
+    space.deallocate(ptr, size);
+  }
+
+  Kokkos::View<int*, Kokkos::HostSpace> v(Kokkos::view_alloc("v", space),
+                                          1 << 20);
+  Kokkos::deep_copy(v, 7);
+  ASSERT_EQ(v(0) + v((1 << 20) - 1), 14);
+}
+#endif
+
+TEST(TEST_CATEGORY, host_space_deep_copy_alignment) {
+  const size_t stream_limit = Kokkos::Impl::hostspace_deepcopy_stream_limit();
+
+  const ptrdiff_t n = 3 * 100000 + 7;
+  std::vector<char> src(n + 64), dst(n + 64);
+  for (size_t i = 0; i < src.size(); ++i) src[i] = char(i * 7 + i / 251);
+
+  // Serial and parallel sizes, both store kinds, every relative offset
+  for (const size_t limit : {stream_limit, size_t(0)}) {
+    Kokkos::Impl::set_hostspace_deepcopy_stream_limit(limit);
+    for (const ptrdiff_t size : {ptrdiff_t(100), n}) {
+      for (int src_offset = 0; src_offset < 8; ++src_offset) {
+        for (int dst_offset = 0; dst_offset < 40; dst_offset += 13) {
+          std::fill(dst.begin(), dst.end(), char(0));
+          Kokkos::Impl::hostspace_parallel_deepcopy(
+              dst.data() + dst_offset, src.data() + src_offset, size);
+          if (dst_offset) {
+            ASSERT_EQ(dst[dst_offset - 1], char(0));
+          }
+          ASSERT_EQ(dst[dst_offset + size], char(0));
+          ASSERT_EQ(0, std::memcmp(dst.data() + dst_offset,
+                                   src.data() + src_offset, size));
+        }
+      }
+    }
+  }
+
+  Kokkos::Impl::set_hostspace_deepcopy_stream_limit(stream_limit);
+}
+
+TEST(TEST_CATEGORY, host_space_deep_fill) {
+  const size_t stream_limit = Kokkos::Impl::hostspace_deepcopy_stream_limit();
+
+  struct triple {
+    char c[3];
+  };
+  const size_t n = 3 * 100000 + 7;
+  std::vector<char> buffer(8 * n + 64);
+
+  // Element sizes that do and do not tile a vector, at every offset
+  for (const size_t limit : {stream_limit, size_t(0)}) {
+    Kokkos::Impl::set_hostspace_deepcopy_stream_limit(limit);
+    for (const size_t count : {size_t(100), n}) {
+      for (int offset = 0; offset < 8; ++offset) {
+        char* const dst = buffer.data() + offset;
+
+        auto check = [&](const void* value, const size_t size) {
+          std::fill(buffer.begin(), buffer.end(), char(-1));
+          Kokkos::Impl::hostspace_parallel_fill(dst, value, size, count);
+          if (offset) {
+            ASSERT_EQ(dst[-1], char(-1));
+          }
+          ASSERT_EQ(dst[count * size], char(-1));
+          for (size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(0, std::memcmp(dst + i * size, value, size));
+          }
+        };
+
+        const double d = 1.1;
+        const triple t = {{1, 2, 3}};
+        const int zero = 0;
+        check(&d, sizeof(d));
+        check(&t, sizeof(t));
+        check(&zero, sizeof(zero));
+      }
+    }
+  }
+
+  Kokkos::Impl::set_hostspace_deepcopy_stream_limit(stream_limit);
+
+  Kokkos::View<double***, Kokkos::HostSpace> v("v", 7, 11, 13);
+  Kokkos::deep_copy(v, 2.5);
+  ASSERT_EQ(v(0, 0, 0), 2.5);
+  ASSERT_EQ(v(6, 10, 12), 2.5);
+}
+
+TEST(TEST_CATEGORY, host_space_cache) {
+  typedef Kokkos::Impl::HostSpaceCache cache;
+  typedef Kokkos::View<double*, Kokkos::HostSpace> view_type;
+
+  const size_t high_water = cache::high_water();
+  cache::set_high_water(size_t(1) << 20);
+
+  const cache::Statistics before = cache::statistics();
+
+  double* first = nullptr;
+  { first = view_type("a", 1000).data(); }
+  {
+    // Same size class, served from the calling thread's magazine
+    view_type b("b", 990);
+    ASSERT_EQ(b.data(), first);
+  }
+
+  cache::Statistics after = cache::statistics();
+  ASSERT_EQ(after.misses, before.misses + 1);
+  ASSERT_EQ(after.hits, before.hits + 1);
+  ASSERT_GT(after.cached_bytes, 0u);
+
+  // Freed blocks beyond the high-water mark are released
+  { view_type c("c", 1 << 17); }
+  after = cache::statistics();
+  ASSERT_EQ(after.releases, before.releases + 1);
+  ASSERT_LE(after.cached_bytes, after.high_water);
+
+  cache::set_high_water(0);
+  ASSERT_EQ(cache::statistics().cached_bytes, 0u);
+
+  // Disabling the cache also drains the magazines of other live threads
+  cache::set_high_water(size_t(1) << 20);
+  std::mutex lock;
+  std::condition_variable cv;
+  bool cached  = false;
+  bool drained = false;
+  std::thread worker([&] {
+    // No kernel launches from a thread outside the execution space
+    { view_type d(Kokkos::ViewAllocateWithoutInitializing("d"), 1000); }
+    std::unique_lock<std::mutex> guard(lock);
+    cached = true;
+    cv.notify_all();
+    cv.wait(guard, [&] { return drained; });
+  });
+  {
+    std::unique_lock<std::mutex> guard(lock);
+    cv.wait(guard, [&] { return cached; });
+  }
+  ASSERT_GT(cache::statistics().cached_bytes, 0u);
+  cache::set_high_water(0);
+  const size_t cached_bytes = cache::statistics().cached_bytes;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    drained = true;
+    cv.notify_all();
+  }
+  worker.join();
+  ASSERT_EQ(cached_bytes, 0u);
+
+  cache::set_high_water(high_water);
+}
+
 }  // namespace Test
 
 #endif